@@ -25,6 +25,7 @@
 #include <librepcb/common/application.h>
 #include <librepcb/common/attributes/attributesubstitutor.h>
 #include <librepcb/common/debug.h>
+#include <librepcb/common/fileio/fileutils.h>
 #include <librepcb/project/boards/board.h>
 #include <librepcb/project/boards/boardgerberexport.h>
 #include <librepcb/project/erc/ercmsg.h>
@@ -58,6 +59,9 @@ int CommandLineInterface::execute() noexcept {
       {"open-project",
        {tr("Open a project to execute project-related tasks."),
         tr("open-project [command_options]")}},
+      {"batch",
+       {tr("Execute project-related tasks on many projects."),
+        tr("batch [command_options]")}},
   };
 
   // Add global options
@@ -95,6 +99,24 @@ int CommandLineInterface::execute() noexcept {
       "save",
       tr("Save project before closing it (useful to upgrade file format)."));
 
+  // Define options for "batch"
+  QCommandLineOption manifestOption(
+      "manifest",
+      tr("Text file containing one project file path per line, relative to "
+         "the manifest file. Empty lines and lines starting with '#' are "
+         "ignored."),
+      tr("file"));
+  QCommandLineOption jobsOption(
+      "jobs",
+      tr("Number of threads used to export fabrication data. Defaults to the "
+         "number of CPU cores."),
+      tr("count"));
+  QCommandLineOption summaryOption(
+      "summary",
+      tr("Write a JSON summary with the result and timing of each project to "
+         "the given file."),
+      tr("file"));
+
   // First parse to get the supplied command (ignoring errors because the parser
   // does not yet know the command-dependent options).
   parser.parse(mApp.arguments());
@@ -117,6 +139,21 @@ int CommandLineInterface::execute() noexcept {
     parser.addOption(exportPcbFabricationDataOption);
     parser.addOption(boardOption);
     parser.addOption(saveOption);
+  } else if (command == "batch") {
+    parser.clearPositionalArguments();
+    parser.addPositionalArgument(command, commands[command].first,
+                                 commands[command].second);
+    parser.addPositionalArgument(
+        "projects",
+        tr("Paths to project files (*.lpp). Wildcards in the file name (e.g. "
+           "'projects/*.lpp') are supported."),
+        "[projects...]");
+    parser.addOption(manifestOption);
+    parser.addOption(jobsOption);
+    parser.addOption(summaryOption);
+    parser.addOption(ercOption);
+    parser.addOption(exportPcbFabricationDataOption);
+    parser.addOption(boardOption);
   } else if (!command.isEmpty()) {
     printErr(QString(tr("Unknown command '%1'.")).arg(command), 2);
     print(parser.helpText(), 0);
@@ -176,6 +213,27 @@ int CommandLineInterface::execute() noexcept {
         parser.values(boardOption),           // boards
         parser.isSet(saveOption)              // save project
     );
+  } else if (command == "batch") {
+    int jobs = QThread::idealThreadCount();
+    if (parser.isSet(jobsOption)) {
+      bool ok = false;
+      jobs    = parser.value(jobsOption).toInt(&ok);
+      if ((!ok) || (jobs < 1)) {
+        printErr(QString(tr("Invalid job count '%1'."))
+                     .arg(parser.value(jobsOption)));
+        return 1;
+      }
+    }
+    cmdSuccess = runBatch(
+        positionalArgs,                // project file patterns
+        parser.value(manifestOption),  // manifest file
+        jobs,                          // job count
+        parser.isSet(ercOption),       // run ERC
+        parser.isSet(
+            exportPcbFabricationDataOption),  // export PCB fabrication data
+        parser.values(boardOption),           // boards
+        parser.value(summaryOption)           // summary file
+    );
   } else {
     printErr(tr("Internal failure."));
   }
@@ -209,33 +267,13 @@ bool CommandLineInterface::openProject(const QString& projectFile, bool runErc,
     // ERC
     if (runErc) {
       print(tr("Run ERC..."));
-      QStringList messages;
       int         approvedMsgCount = 0;
-      foreach (const ErcMsg* msg, project.getErcMsgList().getItems()) {
-        if (!msg->isVisible()) continue;
-        if (msg->isIgnored()) {
-          ++approvedMsgCount;
-        } else {
-          QString severity;
-          switch (msg->getMsgType()) {
-            case ErcMsg::ErcMsgType_t::CircuitWarning:
-            case ErcMsg::ErcMsgType_t::SchematicWarning:
-            case ErcMsg::ErcMsgType_t::BoardWarning:
-              severity = tr("WARNING");
-              break;
-            default:
-              severity = tr("ERROR");
-              break;
-          }
-          messages.append(
-              QString("    - [%1] %2").arg(severity, msg->getMsg()));
-        }
-      }
+      QStringList messages =
+          getNonApprovedErcMessages(project, approvedMsgCount);
       print("  " % QString(tr("Approved messages: %1")).arg(approvedMsgCount));
       print("  " %
             QString(tr("Non-approved messages: %1")).arg(messages.count()));
-      qSort(messages);  // increases readability of console output
-      foreach (const QString& msg, messages) { printErr(msg); }
+      foreach (const QString& msg, messages) { printErr("    - " % msg); }
       if (messages.count() > 0) {
         success = false;
       }
@@ -286,7 +324,7 @@ bool CommandLineInterface::openProject(const QString& projectFile, bool runErc,
       foreach (const Board* board, boardList) {
         print("  " % QString(tr("Board '%1':")).arg(*board->getName()));
         BoardGerberExport grbExport(*board);
-        grbExport.exportAllLayers();  // can throw
+        grbExport.exportAllLayersConcurrently();  // can throw
         foreach (const FilePath& fp, grbExport.getWrittenFiles()) {
           filesCounter[fp]++;
           if (filesCounter[fp] > 1) filesOverwritten = true;
@@ -317,6 +355,240 @@ bool CommandLineInterface::openProject(const QString& projectFile, bool runErc,
   }
 }
 
+bool CommandLineInterface::runBatch(const QStringList& projectPatterns,
+                                    const QString& manifestFile, int jobs,
+                                    bool runErc, bool exportPcbFabricationData,
+                                    const QStringList& boards,
+                                    const QString&     summaryFile) const
+    noexcept {
+  QElapsedTimer timer;
+  timer.start();
+
+  // Collect projects
+  QStringList errors;
+  QStringList projectFiles =
+      findBatchProjects(projectPatterns, manifestFile, errors);
+  foreach (const QString& error, errors) {
+    printErr(QString(tr("ERROR: %1")).arg(error));
+  }
+  if (projectFiles.isEmpty()) {
+    printErr(tr("ERROR: No projects specified."));
+    return false;
+  }
+  print(QString(tr("Process %1 project(s) with %2 job(s)..."))
+            .arg(projectFiles.count())
+            .arg(jobs));
+
+  // Process all projects one after the other in the main thread because
+  // opening a project creates graphics scenes and items, which is not
+  // supported in other threads. Only the fabrication data export of each
+  // board runs concurrently on the global thread pool, limited by the job
+  // count. Application-wide resources (e.g. stroke fonts) are shared between
+  // all projects.
+  QThreadPool::globalInstance()->setMaxThreadCount(jobs);
+  QVector<BatchResult> results;
+  bool                 success = errors.isEmpty();
+  foreach (const QString& projectFile, projectFiles) {
+    BatchResult result = processBatchProject(projectFile, runErc,
+                                             exportPcbFabricationData, boards);
+    print(QString(tr("Project '%1' (%2 ms):"))
+              .arg(result.projectFile)
+              .arg(result.totalTimeMs));
+    foreach (const QString& line, result.output) { print("  " % line); }
+    foreach (const QString& error, result.errors) {
+      printErr("  " % QString(tr("ERROR: %1")).arg(error));
+    }
+    if (!result.success) success = false;
+    results.append(result);
+  }
+
+  // Write summary
+  if (!summaryFile.isEmpty()) {
+    QJsonArray projectsJson;
+    int        failedCount = 0;
+    foreach (const BatchResult& result, results) {
+      QJsonObject timeJson;
+      timeJson["open"]   = result.openTimeMs;
+      timeJson["erc"]    = result.ercTimeMs;
+      timeJson["export"] = result.exportTimeMs;
+      timeJson["total"]  = result.totalTimeMs;
+      QJsonObject projectJson;
+      projectJson["project"] = result.projectFile;
+      projectJson["success"] = result.success;
+      projectJson["errors"]  = QJsonArray::fromStringList(result.errors);
+      projectJson["files"]   = QJsonArray::fromStringList(result.writtenFiles);
+      projectJson["time_ms"] = timeJson;
+      projectsJson.append(projectJson);
+      if (!result.success) ++failedCount;
+    }
+    QJsonObject root;
+    root["jobs"]          = jobs;
+    root["succeeded"]     = results.count() - failedCount;
+    root["failed"]        = failedCount;
+    root["errors"]        = QJsonArray::fromStringList(errors);
+    root["total_time_ms"] = timer.elapsed();
+    root["projects"]      = projectsJson;
+    try {
+      FilePath fp(QFileInfo(summaryFile).absoluteFilePath());
+      FileUtils::writeFile(fp, QJsonDocument(root).toJson());  // can throw
+      print(QString(tr("Summary written to '%1'."))
+                .arg(prettyPath(fp, summaryFile)));
+    } catch (const Exception& e) {
+      printErr(QString(tr("ERROR: %1")).arg(e.getMsg()));
+      success = false;
+    }
+  }
+  return success;
+}
+
+CommandLineInterface::BatchResult CommandLineInterface::processBatchProject(
+    const QString& projectFile, bool runErc, bool exportPcbFabricationData,
+    const QStringList& boards) const noexcept {
+  BatchResult result{projectFile, true, {}, {}, {}, 0, 0, 0, 0};
+  QElapsedTimer totalTimer;
+  totalTimer.start();
+  try {
+    // Open project
+    QElapsedTimer timer;
+    timer.start();
+    FilePath projectFp(QFileInfo(projectFile).absoluteFilePath());
+    Project  project(projectFp, true, false);  // can throw
+    result.openTimeMs = timer.elapsed();
+
+    // ERC
+    if (runErc) {
+      timer.restart();
+      int         approvedMsgCount = 0;
+      QStringList messages =
+          getNonApprovedErcMessages(project, approvedMsgCount);
+      result.output.append(
+          QString(tr("ERC: %1 approved, %2 non-approved message(s)"))
+              .arg(approvedMsgCount)
+              .arg(messages.count()));
+      foreach (const QString& msg, messages) {
+        result.errors.append(QString("ERC: %1").arg(msg));
+      }
+      if (!messages.isEmpty()) result.success = false;
+      result.ercTimeMs = timer.elapsed();
+    }
+
+    // Export PCB fabrication data
+    if (exportPcbFabricationData) {
+      timer.restart();
+      QList<Board*> boardList = project.getBoards();
+      if (!boards.isEmpty()) {
+        boardList.clear();
+        foreach (const QString& boardName, boards) {
+          Board* board = project.getBoardByName(boardName);
+          if (board) {
+            boardList.append(board);
+          } else {
+            result.errors.append(
+                QString(tr("No board with the name '%1' found."))
+                    .arg(boardName));
+            result.success = false;
+          }
+        }
+      }
+      QSet<FilePath> writtenFiles;
+      foreach (const Board* board, boardList) {
+        BoardGerberExport grbExport(*board);
+        grbExport.exportAllLayersConcurrently();  // can throw
+        foreach (const FilePath& fp, grbExport.getWrittenFiles()) {
+          if (writtenFiles.contains(fp)) {
+            result.errors.append(
+                QString(tr("File '%1' was written multiple times."))
+                    .arg(prettyPath(fp, projectFile)));
+            result.success = false;
+          }
+          writtenFiles.insert(fp);
+          result.writtenFiles.append(prettyPath(fp, projectFile));
+        }
+      }
+      result.output.append(QString(tr("Exported %1 file(s) of %2 board(s)"))
+                               .arg(result.writtenFiles.count())
+                               .arg(boardList.count()));
+      result.exportTimeMs = timer.elapsed();
+    }
+  } catch (const Exception& e) {
+    result.errors.append(e.getMsg());
+    result.success = false;
+  }
+  result.totalTimeMs = totalTimer.elapsed();
+  return result;
+}
+
+QStringList CommandLineInterface::findBatchProjects(
+    const QStringList& patterns, const QString& manifestFile,
+    QStringList& errors) noexcept {
+  QStringList allPatterns;
+  if (!manifestFile.isEmpty()) {
+    try {
+      FilePath   fp(QFileInfo(manifestFile).absoluteFilePath());
+      QByteArray content = FileUtils::readFile(fp);  // can throw
+      foreach (QString line, QString::fromUtf8(content).split('\n')) {
+        line = line.trimmed();
+        if (line.isEmpty() || line.startsWith('#')) continue;
+        allPatterns.append(QFileInfo(line).isRelative()
+                               ? fp.getParentDir().getPathTo(line).toStr()
+                               : line);
+      }
+    } catch (const Exception& e) {
+      errors.append(e.getMsg());
+    }
+  }
+  allPatterns += patterns;
+
+  QStringList projectFiles;
+  foreach (const QString& pattern, allPatterns) {
+    QFileInfo fileInfo(pattern);
+    if (fileInfo.fileName().contains(QRegularExpression("[*?\\[]"))) {
+      QDir        dir = fileInfo.dir();
+      QStringList matches =
+          dir.entryList({fileInfo.fileName()}, QDir::Files, QDir::Name);
+      if (matches.isEmpty()) {
+        errors.append(
+            QString(tr("No project files matching '%1' found.")).arg(pattern));
+      }
+      foreach (const QString& match, matches) {
+        projectFiles.append(
+            QDir::cleanPath(fileInfo.path() % QLatin1Char('/') % match));
+      }
+    } else {
+      projectFiles.append(pattern);
+    }
+  }
+  projectFiles.removeDuplicates();
+  return projectFiles;
+}
+
+QStringList CommandLineInterface::getNonApprovedErcMessages(
+    const Project& project, int& approvedMsgCount) noexcept {
+  QStringList messages;
+  approvedMsgCount = 0;
+  foreach (const ErcMsg* msg, project.getErcMsgList().getItems()) {
+    if (!msg->isVisible()) continue;
+    if (msg->isIgnored()) {
+      ++approvedMsgCount;
+    } else {
+      QString severity;
+      switch (msg->getMsgType()) {
+        case ErcMsg::ErcMsgType_t::CircuitWarning:
+        case ErcMsg::ErcMsgType_t::SchematicWarning:
+        case ErcMsg::ErcMsgType_t::BoardWarning:
+          severity = tr("WARNING");
+          break;
+        default:
+          severity = tr("ERROR");
+          break;
+      }
+      messages.append(QString("[%1] %2").arg(severity, msg->getMsg()));
+    }
+  }
+  qSort(messages);  // increases readability of console output
+  return messages;
+}
+
 QString CommandLineInterface::prettyPath(const FilePath& path,
                                          const QString&  style) noexcept {
   return QFileInfo(style).isRelative()
@@ -33,6 +33,10 @@ namespace librepcb {
 class Application;
 class FilePath;
 
+namespace project {
+class Project;
+}
+
 namespace cli {
 
 /*******************************************************************************
@@ -54,15 +58,47 @@ public:
   // General Methods
   int execute() noexcept;
 
+private:  // Types
+  /**
+   * @brief Result of processing a single project in batch mode
+   */
+  struct BatchResult {
+    QString     projectFile;
+    bool        success;
+    QStringList output;        ///< Console output lines
+    QStringList errors;        ///< Error messages
+    QStringList writtenFiles;  ///< Exported files
+    qint64      openTimeMs;
+    qint64      ercTimeMs;
+    qint64      exportTimeMs;
+    qint64      totalTimeMs;
+  };
+
 private:  // Methods
-  bool           openProject(const QString& projectFile, bool runErc,
-                             const QStringList& exportSchematicsFiles,
-                             bool exportPcbFabricationData, const QStringList& boards,
-                             bool save) const noexcept;
-  static QString prettyPath(const FilePath& path,
-                            const QString&  style) noexcept;
-  static void    print(const QString& str, int newlines = 1) noexcept;
-  static void    printErr(const QString& str, int newlines = 1) noexcept;
+  bool               openProject(const QString& projectFile, bool runErc,
+                                 const QStringList& exportSchematicsFiles,
+                                 bool               exportPcbFabricationData,
+                                 const QStringList& boards,
+                                 bool               save) const noexcept;
+  bool               runBatch(const QStringList& projectPatterns,
+                              const QString& manifestFile, int jobs,
+                              bool runErc, bool exportPcbFabricationData,
+                              const QStringList& boards,
+                              const QString&     summaryFile) const noexcept;
+  BatchResult        processBatchProject(const QString& projectFile,
+                                         bool           runErc,
+                                         bool exportPcbFabricationData,
+                                         const QStringList& boards) const
+      noexcept;
+  static QStringList findBatchProjects(const QStringList& patterns,
+                                       const QString&     manifestFile,
+                                       QStringList&       errors) noexcept;
+  static QStringList getNonApprovedErcMessages(
+      const project::Project& project, int& approvedMsgCount) noexcept;
+  static QString     prettyPath(const FilePath& path,
+                                const QString&  style) noexcept;
+  static void        print(const QString& str, int newlines = 1) noexcept;
+  static void        printErr(const QString& str, int newlines = 1) noexcept;
 
 private:  // Data
   const Application& mApp;
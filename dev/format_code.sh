@@ -11,7 +11,7 @@ echo "Formatting modified files with clang-format..."
 
 COUNTER=0
 
-for dir in apps/ libs/librepcb/ tests/unittests/
+for dir in apps/ libs/librepcb/ tests/benchmarks/ tests/unittests/
 do
   MODIFIED=`git diff --name-only master -- "${dir}**.cpp" "${dir}**.hpp" "${dir}**.h"`
   UNTRACKED=`git ls-files --others --exclude-standard -- "${dir}**.cpp" "${dir}**.hpp" "${dir}**.h"`
@@ -49,9 +49,10 @@ QString GerberApertureList::generateString() const noexcept {
   foreach (const QString& macro, mApertureMacros) {
     str.append(QString("%AM%1*%\n").arg(macro));
   }
-  foreach (int number, mApertures.keys()) {
-    str.append(
-        QString("%ADD%1%2*%\n").arg(number).arg(mApertures.value(number)));
+  for (int i = 0; i < mApertures.count(); ++i) {
+    str.append(QString("%ADD%1%2*%\n")
+                   .arg(i + 10)
+                   .arg(generateAperture(mApertures.at(i))));
   }
   str.append("G04 --- APERTURE LIST END --- *\n");
   return str;
@@ -63,25 +64,22 @@ QString GerberApertureList::generateString() const noexcept {
 
 int GerberApertureList::setCircle(const UnsignedLength& dia,
                                   const UnsignedLength& hole) {
-  return setCurrentAperture(generateCircle(dia, hole));
+  return setCurrentAperture(
+      Aperture(Shape::Circle, *dia, Length(0), *hole));
 }
 
 int GerberApertureList::setRect(const UnsignedLength& w,
                                 const UnsignedLength& h, const Angle& rot,
                                 const UnsignedLength& hole) noexcept {
   if (rot % Angle::deg180() == 0) {
-    return setCurrentAperture(generateRect(w, h, hole));
+    return setCurrentAperture(Aperture(Shape::Rect, *w, *h, *hole));
   } else if (rot % Angle::deg90() == 0) {
-    return setCurrentAperture(generateRect(h, w, hole));
+    return setCurrentAperture(Aperture(Shape::Rect, *h, *w, *hole));
   } else {
     // Rotation is not a multiple of 90 degrees --> we need to use an aperture
     // macro
-    if (hole > 0) {
-      addMacro(generateRotatedRectMacroWithHole());
-    } else {
-      addMacro(generateRotatedRectMacro());
-    }
-    return setCurrentAperture(generateRotatedRect(w, h, rot, hole));
+    return setCurrentAperture(
+        Aperture(Shape::RotatedRect, *w, *h, *hole, rot));
   }
 }
 
@@ -89,18 +87,17 @@ int GerberApertureList::setObround(const UnsignedLength& w,
                                    const UnsignedLength& h, const Angle& rot,
                                    const UnsignedLength& hole) noexcept {
   if (rot % Angle::deg180() == 0) {
-    return setCurrentAperture(generateObround(w, h, hole));
+    return setCurrentAperture(Aperture(Shape::Obround, *w, *h, *hole));
   } else if (rot % Angle::deg90() == 0) {
-    return setCurrentAperture(generateObround(h, w, hole));
+    return setCurrentAperture(Aperture(Shape::Obround, *h, *w, *hole));
   } else {
     // Rotation is not a multiple of 90 degrees --> we need to use an aperture
     // macro
-    if (hole > 0) {
-      addMacro(generateRotatedObroundMacroWithHole());
-    } else {
-      addMacro(generateRotatedObroundMacro());
-    }
-    return setCurrentAperture(generateRotatedObround(w, h, rot, hole));
+    UnsignedLength width = (w < h ? w : h);
+    Aperture aperture(Shape::RotatedObround, *width, Length(0), *hole);
+    aperture.start = Point(-w / 2 + width / 2, 0).rotated(rot);
+    aperture.end   = Point(w / 2 - width / 2, 0).rotated(rot);
+    return setCurrentAperture(aperture);
   }
 }
 
@@ -115,24 +112,34 @@ int GerberApertureList::setRegularPolygon(const UnsignedLength& dia, int n,
   // Adjust rotation as its interpretation differs between LibrePCB and Gerber
   // specs
   Angle grbRot = rot + (Angle::deg180() / (n > 0 ? n : 1));
-  return setCurrentAperture(generateRegularPolygon(dia, n, grbRot, hole));
+  return setCurrentAperture(
+      Aperture(Shape::RegularPolygon, *dia, Length(0), *hole, grbRot, n));
 }
 
 void GerberApertureList::reset() noexcept {
   // mApertureMacros.clear();
   mApertures.clear();
+  mApertureNumbers.clear();
 }
 
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
-int GerberApertureList::setCurrentAperture(const QString& aperture) noexcept {
-  int number = mApertures.key(aperture, -1);
+int GerberApertureList::setCurrentAperture(const Aperture& aperture) noexcept {
+  int number = mApertureNumbers.value(aperture, -1);
   if (number < 0) {
+    // macros are added in the order of their first usage
+    if (aperture.shape == Shape::RotatedRect) {
+      addMacro((aperture.hole > 0) ? generateRotatedRectMacroWithHole()
+                                   : generateRotatedRectMacro());
+    } else if (aperture.shape == Shape::RotatedObround) {
+      addMacro((aperture.hole > 0) ? generateRotatedObroundMacroWithHole()
+                                   : generateRotatedObroundMacro());
+    }
     number = mApertures.count() + 10;  // 10 is the number of the first aperture
-    Q_ASSERT(!mApertures.contains(number));
-    mApertures.insert(number, aperture);
+    mApertures.append(aperture);
+    mApertureNumbers.insert(aperture, number);
   }
   return number;
 }
@@ -147,43 +154,65 @@ void GerberApertureList::addMacro(const QString& macro) noexcept {
  *  Aperture Generator Methods
  ******************************************************************************/
 
-QString GerberApertureList::generateCircle(
-    const UnsignedLength& dia, const UnsignedLength& hole) noexcept {
+QString GerberApertureList::generateAperture(
+    const Aperture& aperture) noexcept {
+  switch (aperture.shape) {
+    case Shape::Circle:
+      return generateCircle(aperture.width, aperture.hole);
+    case Shape::Rect:
+      return generateRect(aperture.width, aperture.height, aperture.hole);
+    case Shape::Obround:
+      return generateObround(aperture.width, aperture.height, aperture.hole);
+    case Shape::RegularPolygon:
+      return generateRegularPolygon(aperture.width, aperture.vertices,
+                                    aperture.rotation, aperture.hole);
+    case Shape::RotatedRect:
+      return generateRotatedRect(aperture.width, aperture.height,
+                                 aperture.rotation, aperture.hole);
+    case Shape::RotatedObround:
+      return generateRotatedObround(aperture.start, aperture.end,
+                                    aperture.width, aperture.hole);
+    default:
+      qCritical() << "Invalid aperture shape:"
+                  << static_cast<int>(aperture.shape);
+      return QString();
+  }
+}
+
+QString GerberApertureList::generateCircle(const Length& dia,
+                                           const Length& hole) noexcept {
   if (hole > 0) {
-    return QString("C,%1X%2").arg(dia->toMmString(), hole->toMmString());
+    return QString("C,%1X%2").arg(dia.toMmString(), hole.toMmString());
   } else {
-    return QString("C,%1").arg(dia->toMmString());
+    return QString("C,%1").arg(dia.toMmString());
   }
 }
 
-QString GerberApertureList::generateRect(const UnsignedLength& w,
-                                         const UnsignedLength& h,
-                                         const UnsignedLength& hole) noexcept {
+QString GerberApertureList::generateRect(const Length& w, const Length& h,
+                                         const Length& hole) noexcept {
   if (hole > 0) {
     return QString("R,%1X%2X%3")
-        .arg(w->toMmString(), h->toMmString(), hole->toMmString());
+        .arg(w.toMmString(), h.toMmString(), hole.toMmString());
   } else {
-    return QString("R,%1X%2").arg(w->toMmString(), h->toMmString());
+    return QString("R,%1X%2").arg(w.toMmString(), h.toMmString());
   }
 }
 
-QString GerberApertureList::generateObround(
-    const UnsignedLength& w, const UnsignedLength& h,
-    const UnsignedLength& hole) noexcept {
+QString GerberApertureList::generateObround(const Length& w, const Length& h,
+                                            const Length& hole) noexcept {
   if (hole > 0) {
     return QString("O,%1X%2X%3")
-        .arg(w->toMmString(), h->toMmString(), hole->toMmString());
+        .arg(w.toMmString(), h.toMmString(), hole.toMmString());
   } else {
-    return QString("O,%1X%2").arg(w->toMmString(), h->toMmString());
+    return QString("O,%1X%2").arg(w.toMmString(), h.toMmString());
   }
 }
 
 QString GerberApertureList::generateRegularPolygon(
-    const UnsignedLength& dia, int n, const Angle& rot,
-    const UnsignedLength& hole) noexcept {
-  QString str = QString("P,%1X%2").arg(dia->toMmString()).arg(n);
+    const Length& dia, int n, const Angle& rot, const Length& hole) noexcept {
+  QString str = QString("P,%1X%2").arg(dia.toMmString()).arg(n);
   if (rot != 0 || hole > 0) str += QString("X%1").arg(rot.toDegString());
-  if (hole > 0) str += QString("X%1").arg(hole->toMmString());
+  if (hole > 0) str += QString("X%1").arg(hole.toMmString());
   return str;
 }
 
@@ -210,35 +239,33 @@ QString GerberApertureList::generateRotatedObroundMacroWithHole() {
       "4,0*1,0,$6,0,0,0");
 }
 
-QString GerberApertureList::generateRotatedRect(
-    const UnsignedLength& w, const UnsignedLength& h, const Angle& rot,
-    const UnsignedLength& hole) noexcept {
+QString GerberApertureList::generateRotatedRect(const Length& w,
+                                                const Length& h,
+                                                const Angle&  rot,
+                                                const Length& hole) noexcept {
   if (hole > 0) {
     return QString("ROTATEDRECTWITHHOLE,%1X%2X%3X%4")
-        .arg(w->toMmString(), h->toMmString(), rot.toDegString(),
-             hole->toMmString());
+        .arg(w.toMmString(), h.toMmString(), rot.toDegString(),
+             hole.toMmString());
   } else {
     return QString("ROTATEDRECT,%1X%2X%3")
-        .arg(w->toMmString(), h->toMmString(), rot.toDegString());
+        .arg(w.toMmString(), h.toMmString(), rot.toDegString());
   }
 }
 
 QString GerberApertureList::generateRotatedObround(
-    const UnsignedLength& w, const UnsignedLength& h, const Angle& rot,
-    const UnsignedLength& hole) noexcept {
-  UnsignedLength width = (w < h ? w : h);
-  Point          start = Point(-w / 2 + width / 2, 0).rotated(rot);
-  Point          end   = Point(w / 2 - width / 2, 0).rotated(rot);
+    const Point& start, const Point& end, const Length& width,
+    const Length& hole) noexcept {
   if (hole > 0) {
     return QString("ROTATEDOBROUNDWITHHOLE,%1X%2X%3X%4X%5X%6")
         .arg(start.getX().toMmString(), start.getY().toMmString(),
              end.getX().toMmString(), end.getY().toMmString(),
-             width->toMmString(), hole->toMmString());
+             width.toMmString(), hole.toMmString());
   } else {
     return QString("ROTATEDOBROUND,%1X%2X%3X%4X%5")
         .arg(start.getX().toMmString(), start.getY().toMmString(),
              end.getX().toMmString(), end.getY().toMmString(),
-             width->toMmString());
+             width.toMmString());
   }
 }
 
@@ -71,37 +71,92 @@ public:
   // Operator Overloadings
   GerberApertureList& operator=(const GerberApertureList& rhs) = delete;
 
-private:
-  // Private Methods
-  int  setCurrentAperture(const QString& aperture) noexcept;
+private:  // Types
+  enum class Shape : quint8 {
+    Circle,
+    Rect,
+    Obround,
+    RegularPolygon,
+    RotatedRect,
+    RotatedObround,
+  };
+
+  /**
+   * @brief Structured key of an aperture
+   *
+   * Contains exactly the values which are written to the aperture definition,
+   * so two keys are equal if and only if their definitions are equal. The
+   * definition itself is only formatted in #generateString().
+   */
+  struct Aperture {
+    Shape  shape;
+    Length width;     ///< Diameter of circles and regular polygons
+    Length height;    ///< Only for (rotated) rects and obrounds
+    Length hole;      ///< Zero if there is no hole
+    Angle  rotation;  ///< Only for regular polygons and rotated rects
+    int    vertices;  ///< Only for regular polygons
+    Point  start;     ///< Only for rotated obrounds
+    Point  end;       ///< Only for rotated obrounds
+
+    Aperture(Shape shape, const Length& width, const Length& height,
+             const Length& hole, const Angle& rotation = Angle::deg0(),
+             int vertices = 0) noexcept
+      : shape(shape),
+        width(width),
+        height(height),
+        hole(hole),
+        rotation(rotation),
+        vertices(vertices),
+        start(),
+        end() {}
+    bool operator==(const Aperture& rhs) const noexcept {
+      return (shape == rhs.shape) && (width == rhs.width) &&
+             (height == rhs.height) && (hole == rhs.hole) &&
+             (rotation == rhs.rotation) && (vertices == rhs.vertices) &&
+             (start == rhs.start) && (end == rhs.end);
+    }
+    friend uint qHash(const Aperture& key, uint seed = 0) noexcept {
+      seed ^= ::qHash(static_cast<int>(key.shape)) + (seed << 6);
+      seed ^= qHash(key.width) + (seed << 6);
+      seed ^= qHash(key.height) + (seed << 6);
+      seed ^= qHash(key.hole) + (seed << 6);
+      seed ^= qHash(key.rotation) + (seed << 6);
+      seed ^= ::qHash(key.vertices) + (seed << 6);
+      seed ^= qHash(key.start) + (seed << 6);
+      seed ^= qHash(key.end) + (seed << 6);
+      return seed;
+    }
+  };
+
+private:  // Methods
+  int  setCurrentAperture(const Aperture& aperture) noexcept;
   void addMacro(const QString& macro) noexcept;
 
   // Aperture Generator Methods
-  static QString generateCircle(const UnsignedLength& dia,
-                                const UnsignedLength& hole) noexcept;
-  static QString generateRect(const UnsignedLength& w, const UnsignedLength& h,
-                              const UnsignedLength& hole) noexcept;
-  static QString generateObround(const UnsignedLength& w,
-                                 const UnsignedLength& h,
-                                 const UnsignedLength& hole) noexcept;
-  static QString generateRegularPolygon(const UnsignedLength& dia, int n,
-                                        const Angle&          rot,
-                                        const UnsignedLength& hole) noexcept;
+  static QString generateAperture(const Aperture& aperture) noexcept;
+  static QString generateCircle(const Length& dia, const Length& hole) noexcept;
+  static QString generateRect(const Length& w, const Length& h,
+                              const Length& hole) noexcept;
+  static QString generateObround(const Length& w, const Length& h,
+                                 const Length& hole) noexcept;
+  static QString generateRegularPolygon(const Length& dia, int n,
+                                        const Angle&  rot,
+                                        const Length& hole) noexcept;
   static QString generateRotatedRectMacro();
   static QString generateRotatedRectMacroWithHole();
   static QString generateRotatedObroundMacro();
   static QString generateRotatedObroundMacroWithHole();
-  static QString generateRotatedRect(const UnsignedLength& w,
-                                     const UnsignedLength& h, const Angle& rot,
-                                     const UnsignedLength& hole) noexcept;
-  static QString generateRotatedObround(const UnsignedLength& w,
-                                        const UnsignedLength& h,
-                                        const Angle&          rot,
-                                        const UnsignedLength& hole) noexcept;
-
-  QList<QString> mApertureMacros;
-  QMap<int, QString>
-      mApertures;  ///< key: aperture number (>= 10); value: aperture definition
+  static QString generateRotatedRect(const Length& w, const Length& h,
+                                     const Angle&  rot,
+                                     const Length& hole) noexcept;
+  static QString generateRotatedObround(const Point& start, const Point& end,
+                                        const Length& width,
+                                        const Length& hole) noexcept;
+
+private:  // Data
+  QList<QString>       mApertureMacros;
+  QList<Aperture>      mApertures;  ///< Index + 10 is the aperture number
+  QHash<Aperture, int> mApertureNumbers;  ///< value: aperture number (>= 10)
 };
 
 /*******************************************************************************
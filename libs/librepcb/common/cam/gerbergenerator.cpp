@@ -22,7 +22,7 @@
  ******************************************************************************/
 #include "gerbergenerator.h"
 
-#include "../fileio/smarttextfile.h"
+#include "../fileio/fileutils.h"
 #include "../geometry/circle.h"
 #include "../geometry/path.h"
 #include "../toolbox.h"
@@ -44,8 +44,9 @@ GerberGenerator::GerberGenerator(const QString& projName, const Uuid& projUuid,
   : mProjectId(escapeString(projName)),
     mProjectUuid(projUuid),
     mProjectRevision(escapeString(projRevision)),
-    mOutput(),
     mContent(),
+    mContentFile(),
+    mContentFileError(),
     mApertureList(new GerberApertureList()),
     mCurrentApertureNumber(-1),
     mMultiQuadrantArcModeOn(false) {
@@ -61,10 +62,10 @@ GerberGenerator::~GerberGenerator() noexcept {
 void GerberGenerator::setLayerPolarity(LayerPolarity p) noexcept {
   switch (p) {
     case LayerPolarity::Positive:
-      mContent.append("%LPD*%\n");
+      writeContent("%LPD*%\n");
       break;
     case LayerPolarity::Negative:
-      mContent.append("%LPC*%\n");
+      writeContent("%LPC*%\n");
       break;
     default:
       qCritical() << "Invalid Layer Polarity:" << static_cast<int>(p);
@@ -193,24 +194,65 @@ void GerberGenerator::flashRegularPolygon(const Point&          pos,
  ******************************************************************************/
 
 void GerberGenerator::reset() noexcept {
-  mOutput.clear();
   mContent.clear();
+  mContentFile.reset();
+  mContentFileError.clear();
   mApertureList->reset();
   mCurrentApertureNumber = -1;
 }
 
-void GerberGenerator::generate() {
-  mOutput.clear();
-  printHeader();
-  printApertureList();
-  printContent();
-  printFooter();
-}
-
 void GerberGenerator::saveToFile(const FilePath& filepath) const {
-  QScopedPointer<SmartTextFile> file(SmartTextFile::create(filepath));
-  file->setContent(mOutput.toLatin1());
-  file->save(true);
+  if (!mContentFileError.isEmpty()) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       QString(tr("Could not write temporary file: %1"))
+                           .arg(mContentFileError));
+  }
+
+  FileUtils::makePath(filepath.getParentDir());  // can throw
+  QSaveFile file(filepath.toStr());
+  if (!file.open(QIODevice::WriteOnly)) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       QString(tr("Could not open or create file \"%1\": %2"))
+                           .arg(filepath.toNative(), file.errorString()));
+  }
+
+  // The aperture list is only known after drawing all the content, so the
+  // header section is written first and the content section (which may have
+  // been spilled to a temporary file) is appended afterwards.
+  QCryptographicHash md5(QCryptographicHash::Md5);
+  writeToFile(file, md5, generateHeader());
+  writeToFile(file, md5, mApertureList->generateString().toLatin1());
+  writeToFile(file, md5, "G04 --- BOARD BEGIN --- *\n");
+  if (mContentFile) {
+    if (!mContentFile->seek(0)) {
+      throw RuntimeError(__FILE__, __LINE__,
+                         QString(tr("Could not read temporary file: %1"))
+                             .arg(mContentFile->errorString()));
+    }
+    while (!mContentFile->atEnd()) {
+      QByteArray chunk = mContentFile->read(sMaxContentBufferSize);
+      if (chunk.isEmpty()) {
+        throw RuntimeError(__FILE__, __LINE__,
+                           QString(tr("Could not read temporary file: %1"))
+                               .arg(mContentFile->errorString()));
+      }
+      writeToFile(file, md5, chunk);
+    }
+  }
+  writeToFile(file, md5, mContent);
+  writeToFile(file, md5, "G04 --- BOARD END --- *\n");
+
+  // MD5 checksum over all previous content
+  file.write(QByteArray("%TF.MD5,") + md5.result().toHex() + "*%\n");
+
+  // end of file
+  file.write("M02*\n");
+
+  if (!file.commit()) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       QString(tr("Could not write to file \"%1\": %2"))
+                           .arg(filepath.toNative(), file.errorString()));
+  }
 }
 
 /*******************************************************************************
@@ -219,53 +261,51 @@ void GerberGenerator::saveToFile(const FilePath& filepath) const {
 
 void GerberGenerator::setCurrentAperture(int number) noexcept {
   if (number != mCurrentApertureNumber) {
-    mContent.append(QString("D%1*\n").arg(number));
+    writeContent("D" % QByteArray::number(number) % "*\n");
     mCurrentApertureNumber = number;
   }
 }
 
 void GerberGenerator::setRegionModeOn() noexcept {
-  mContent.append("G36*\n");
+  writeContent("G36*\n");
 }
 
 void GerberGenerator::setRegionModeOff() noexcept {
-  mContent.append("G37*\n");
+  writeContent("G37*\n");
 }
 
 void GerberGenerator::setMultiQuadrantArcModeOn() noexcept {
   if (!mMultiQuadrantArcModeOn) {
-    mContent.append("G75*\n");
+    writeContent("G75*\n");
     mMultiQuadrantArcModeOn = true;
   }
 }
 
 void GerberGenerator::setMultiQuadrantArcModeOff() noexcept {
   if (mMultiQuadrantArcModeOn) {
-    mContent.append("G74*\n");
+    writeContent("G74*\n");
     mMultiQuadrantArcModeOn = false;
   }
 }
 
 void GerberGenerator::switchToLinearInterpolationModeG01() noexcept {
-  mContent.append("G01*\n");
+  writeContent("G01*\n");
 }
 
 void GerberGenerator::switchToCircularCwInterpolationModeG02() noexcept {
-  mContent.append("G02*\n");
+  writeContent("G02*\n");
 }
 
 void GerberGenerator::switchToCircularCcwInterpolationModeG03() noexcept {
-  mContent.append("G03*\n");
+  writeContent("G03*\n");
 }
 
 void GerberGenerator::moveToPosition(const Point& pos) noexcept {
-  mContent.append(QString("X%1Y%2D02*\n")
-                      .arg(pos.getX().toNmString(), pos.getY().toNmString()));
+  writeContent(formatPosition(pos) % "D02*\n");
 }
 
 void GerberGenerator::linearInterpolateToPosition(const Point& pos) noexcept {
-  mContent.append(QString("X%1Y%2D01*\n")
-                      .arg(pos.getX().toNmString(), pos.getY().toNmString()));
+  writeContent(formatPosition(pos) % "D01*\n");
 }
 
 void GerberGenerator::circularInterpolateToPosition(const Point& start,
@@ -275,82 +315,97 @@ void GerberGenerator::circularInterpolateToPosition(const Point& start,
   if (!mMultiQuadrantArcModeOn) {
     diff.makeAbs();  // no sign allowed in single quadrant mode!
   }
-  mContent.append(QString("X%1Y%2I%3J%4D01*\n")
-                      .arg(end.getX().toNmString(), end.getY().toNmString(),
-                           diff.getX().toNmString(), diff.getY().toNmString()));
+  writeContent(formatPosition(end) % "I" %
+               QByteArray::number(diff.getX().toNm()) % "J" %
+               QByteArray::number(diff.getY().toNm()) % "D01*\n");
 }
 
 void GerberGenerator::flashAtPosition(const Point& pos) noexcept {
-  mContent.append(QString("X%1Y%2D03*\n")
-                      .arg(pos.getX().toNmString(), pos.getY().toNmString()));
+  writeContent(formatPosition(pos) % "D03*\n");
+}
+
+void GerberGenerator::writeContent(const QByteArray& data) noexcept {
+  mContent.append(data);
+  if ((mContent.size() >= sMaxContentBufferSize) &&
+      mContentFileError.isEmpty()) {
+    // spill the content to a temporary file to limit memory consumption
+    if (!mContentFile) {
+      mContentFile.reset(new QTemporaryFile());
+      if (!mContentFile->open()) {
+        mContentFileError = mContentFile->errorString();
+        return;
+      }
+    }
+    if (mContentFile->write(mContent) == mContent.size()) {
+      mContent.clear();
+    } else {
+      mContentFileError = mContentFile->errorString();
+    }
+  }
 }
 
-void GerberGenerator::printHeader() noexcept {
-  mOutput.append("G04 --- HEADER BEGIN --- *\n");
+QByteArray GerberGenerator::generateHeader() const noexcept {
+  QString header = "G04 --- HEADER BEGIN --- *\n";
 
   // add some X2 attributes
   QString appVersion   = qApp->applicationVersion();
   QString creationDate = QDateTime::currentDateTime().toString(Qt::ISODate);
-  QString projId       = mProjectId.remove(',');
+  QString projId       = QString(mProjectId).remove(',');
   QString projUuid     = mProjectUuid.toStr();
-  QString projRevision = mProjectRevision.remove(',');
-  mOutput.append(QString("%TF.GenerationSoftware,LibrePCB,LibrePCB,%1*%\n")
-                     .arg(appVersion));
-  mOutput.append(QString("%TF.CreationDate,%1*%\n").arg(creationDate));
-  mOutput.append(QString("%TF.ProjectId,%1,%2,%3*%\n")
-                     .arg(projId, projUuid, projRevision));
-  mOutput.append("%TF.Part,Single*%\n");  // "Single" means "this is a PCB"
-  // mOutput.append("%TF.FilePolarity,Positive*%\n");
+  QString projRevision = QString(mProjectRevision).remove(',');
+  header.append(QString("%TF.GenerationSoftware,LibrePCB,LibrePCB,%1*%\n")
+                    .arg(appVersion));
+  header.append(QString("%TF.CreationDate,%1*%\n").arg(creationDate));
+  header.append(QString("%TF.ProjectId,%1,%2,%3*%\n")
+                    .arg(projId, projUuid, projRevision));
+  header.append("%TF.Part,Single*%\n");  // "Single" means "this is a PCB"
+  // header.append("%TF.FilePolarity,Positive*%\n");
 
   // coordinate format specification:
   //  - leading zeros omitted
   //  - absolute coordinates
   //  - coordiante format "6.6" --> allows us to directly use LengthBase_t
   //  (nanometers)!
-  mOutput.append("%FSLAX66Y66*%\n");
+  header.append("%FSLAX66Y66*%\n");
 
   // set unit to millimeters
-  mOutput.append("%MOMM*%\n");
+  header.append("%MOMM*%\n");
 
   // start linear interpolation mode
-  mOutput.append("G01*\n");
+  header.append("G01*\n");
 
   // use single quadrant arc mode
-  mOutput.append("G74*\n");
+  header.append("G74*\n");
 
-  mOutput.append("G04 --- HEADER END --- *\n");
+  header.append("G04 --- HEADER END --- *\n");
+  return header.toLatin1();
 }
 
-void GerberGenerator::printApertureList() noexcept {
-  mOutput.append(mApertureList->generateString());
-}
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
 
-void GerberGenerator::printContent() noexcept {
-  mOutput.append("G04 --- BOARD BEGIN --- *\n");
-  mOutput.append(mContent);
-  mOutput.append("G04 --- BOARD END --- *\n");
+QByteArray GerberGenerator::formatPosition(const Point& pos) noexcept {
+  return "X" % QByteArray::number(pos.getX().toNm()) % "Y" %
+         QByteArray::number(pos.getY().toNm());
 }
 
-void GerberGenerator::printFooter() noexcept {
-  // MD5 checksum over content
-  mOutput.append(QString("%TF.MD5,%1*%\n").arg(calcOutputMd5Checksum()));
+void GerberGenerator::writeToFile(QIODevice& device, QCryptographicHash& md5,
+                                  const QByteArray& data) noexcept {
+  device.write(data);  // errors are reported by QSaveFile::commit()
 
-  // end of file
-  mOutput.append("M02*\n");
-}
-
-QString GerberGenerator::calcOutputMd5Checksum() const noexcept {
   // according to the RS-274C standard, linebreaks are not included in the
   // checksum
-  QString data = QString(mOutput).remove(QChar('\n'));
-  return QString(
-      QCryptographicHash::hash(data.toUtf8(), QCryptographicHash::Md5).toHex());
+  int start = 0;
+  int end   = data.indexOf('\n');
+  while (end >= 0) {
+    md5.addData(data.constData() + start, end - start);
+    start = end + 1;
+    end   = data.indexOf('\n', start);
+  }
+  md5.addData(data.constData() + start, data.size() - start);
 }
 
-/*******************************************************************************
- *  Static Methods
- ******************************************************************************/
-
 QString GerberGenerator::escapeString(const QString& str) noexcept {
   // perform compatibility decomposition (NFKD)
   QString ret = str.normalized(QString::NormalizationForm_KD);
@@ -68,9 +68,6 @@ public:
                   const QString& projRevision) noexcept;
   ~GerberGenerator() noexcept;
 
-  // Getters
-  const QString& toStr() const noexcept { return mOutput; }
-
   // Plot Methods
   void setLayerPolarity(LayerPolarity p) noexcept;
   void drawLine(const Point& start, const Point& end,
@@ -94,7 +91,18 @@ public:
 
   // General Methods
   void reset() noexcept;
-  void generate();
+
+  /**
+   * @brief Write the Gerber file
+   *
+   * The content is streamed to the file (together with the header and the
+   * aperture list) without building the whole file in memory. The MD5
+   * checksum is calculated while writing.
+   *
+   * @param filepath    The file to write (will be overwritten if it exists).
+   *
+   * @throw Exception   If the file could not be written.
+   */
   void saveToFile(const FilePath& filepath) const;
 
   // Operator Overloadings
@@ -102,27 +110,27 @@ public:
 
 private:
   // Private Methods
-  void    setCurrentAperture(int number) noexcept;
-  void    setRegionModeOn() noexcept;
-  void    setRegionModeOff() noexcept;
-  void    setMultiQuadrantArcModeOn() noexcept;
-  void    setMultiQuadrantArcModeOff() noexcept;
-  void    switchToLinearInterpolationModeG01() noexcept;
-  void    switchToCircularCwInterpolationModeG02() noexcept;
-  void    switchToCircularCcwInterpolationModeG03() noexcept;
-  void    moveToPosition(const Point& pos) noexcept;
-  void    linearInterpolateToPosition(const Point& pos) noexcept;
-  void    circularInterpolateToPosition(const Point& start, const Point& center,
-                                        const Point& end) noexcept;
-  void    flashAtPosition(const Point& pos) noexcept;
-  void    printHeader() noexcept;
-  void    printApertureList() noexcept;
-  void    printContent() noexcept;
-  void    printFooter() noexcept;
-  QString calcOutputMd5Checksum() const noexcept;
+  void setCurrentAperture(int number) noexcept;
+  void setRegionModeOn() noexcept;
+  void setRegionModeOff() noexcept;
+  void setMultiQuadrantArcModeOn() noexcept;
+  void setMultiQuadrantArcModeOff() noexcept;
+  void switchToLinearInterpolationModeG01() noexcept;
+  void switchToCircularCwInterpolationModeG02() noexcept;
+  void switchToCircularCcwInterpolationModeG03() noexcept;
+  void moveToPosition(const Point& pos) noexcept;
+  void linearInterpolateToPosition(const Point& pos) noexcept;
+  void circularInterpolateToPosition(const Point& start, const Point& center,
+                                     const Point& end) noexcept;
+  void flashAtPosition(const Point& pos) noexcept;
+  void writeContent(const QByteArray& data) noexcept;
+  QByteArray generateHeader() const noexcept;
 
   // Static Methods
-  static QString escapeString(const QString& str) noexcept;
+  static QByteArray formatPosition(const Point& pos) noexcept;
+  static void       writeToFile(QIODevice& device, QCryptographicHash& md5,
+                                const QByteArray& data) noexcept;
+  static QString    escapeString(const QString& str) noexcept;
 
   // Metadata
   QString mProjectId;
@@ -130,11 +138,15 @@ private:
   QString mProjectRevision;
 
   // Gerber Data
-  QString                            mOutput;
-  QString                            mContent;
+  QByteArray                         mContent;  ///< Not yet spilled content
+  QScopedPointer<QTemporaryFile>     mContentFile;  ///< Spilled content
+  QString                            mContentFileError;
   QScopedPointer<GerberApertureList> mApertureList;
   int                                mCurrentApertureNumber;
   bool                               mMultiQuadrantArcModeOn;
+
+  /// Above this size, the content is spilled to #mContentFile
+  static constexpr int sMaxContentBufferSize = 1024 * 1024;
 };
 
 /*******************************************************************************
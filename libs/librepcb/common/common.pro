@@ -23,7 +23,6 @@ INCLUDEPATH += \
     ../../ \
     ../../fontobene \
     ../../quazip \
-    ../../sexpresso \
     ../../type_safe/include \
     ../../type_safe/external/debug_assert \
 
@@ -64,6 +63,7 @@ SOURCES += \
     fileio/sexpression.cpp \
     fileio/smartfile.cpp \
     fileio/smartsexprfile.cpp \
+    fileio/smartsexprfilebatch.cpp \
     fileio/smarttextfile.cpp \
     fileio/smartversionfile.cpp \
     font/strokefont.cpp \
@@ -176,6 +176,7 @@ HEADERS += \
     fileio/sexpression.h \
     fileio/smartfile.h \
     fileio/smartsexprfile.h \
+    fileio/smartsexprfilebatch.h \
     fileio/smarttextfile.h \
     fileio/smartversionfile.h \
     font/strokefont.h \
@@ -232,6 +233,7 @@ HEADERS += \
     utils/clipperhelpers.h \
     utils/exclusiveactiongroup.h \
     utils/graphicslayerstackappearancesettings.h \
+    utils/spatialindex.h \
     utils/toolbarproxy.h \
     utils/undostackactiongroup.h \
     uuid.h \
@@ -213,8 +213,11 @@ FilePath FilePath::getApplicationTempPath() noexcept {
 }
 
 FilePath FilePath::getRandomTempPath() noexcept {
+  // Note: Don't use qrand() since it is seeded per thread, so it returns the
+  // same numbers in every thread and could lead to identical paths.
+  QString uuid   = QUuid::createUuid().toString().remove("{").remove("}");
   QString random =
-      QString("%1_%2").arg(QDateTime::currentMSecsSinceEpoch()).arg(qrand());
+      QString("%1_%2").arg(QDateTime::currentMSecsSinceEpoch()).arg(uuid);
   return getApplicationTempPath().getPathTo(random);
 }
 
@@ -26,6 +26,20 @@
 
 #include <QtCore>
 
+#if defined(Q_OS_OSX)  // Mac OS X
+#include <sys/clonefile.h>
+#include <unistd.h>
+#elif defined(Q_OS_LINUX)  // Linux
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#elif defined(Q_OS_UNIX)  // UNIX
+#include <unistd.h>
+#elif defined(Q_OS_WIN32) || defined(Q_OS_WIN64)  // Windows
+#include <windows.h>
+#endif
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -74,7 +88,8 @@ void FileUtils::writeFile(const FilePath& filepath, const QByteArray& content) {
   }
 }
 
-void FileUtils::copyFile(const FilePath& source, const FilePath& dest) {
+void FileUtils::copyFile(const FilePath& source, const FilePath& dest,
+                         CopyStrategy strategy) {
   if (!source.isExistingFile()) {
     throw LogicError(
         __FILE__, __LINE__,
@@ -85,6 +100,12 @@ void FileUtils::copyFile(const FilePath& source, const FilePath& dest) {
                      QString(tr("The file or directory \"%1\" exists already."))
                          .arg(dest.toNative()));
   }
+  if ((strategy == CopyStrategy::Link) && linkFile(source, dest)) {
+    return;
+  }
+  if ((strategy != CopyStrategy::Copy) && cloneFile(source, dest)) {
+    return;
+  }
   if (!QFile::copy(source.toStr(), dest.toStr())) {
     throw RuntimeError(__FILE__, __LINE__,
                        QString(tr("Could not copy file \"%1\" to \"%2\"."))
@@ -93,7 +114,8 @@ void FileUtils::copyFile(const FilePath& source, const FilePath& dest) {
 }
 
 void FileUtils::copyDirRecursively(const FilePath& source,
-                                   const FilePath& dest) {
+                                   const FilePath& dest,
+                                   CopyStrategy    strategy) {
   if (!source.isExistingDir()) {
     throw LogicError(__FILE__, __LINE__,
                      QString(tr("The directory \"%1\" does not exist."))
@@ -108,11 +130,11 @@ void FileUtils::copyDirRecursively(const FilePath& source,
   QDir sourceDir(source.toStr());
   foreach (const QString& file,
            sourceDir.entryList(QDir::Files | QDir::Hidden)) {
-    copyFile(source.getPathTo(file), dest.getPathTo(file));
+    copyFile(source.getPathTo(file), dest.getPathTo(file), strategy);
   }
   foreach (const QString& dir,
            sourceDir.entryList(QDir::AllDirs | QDir::NoDotAndDotDot)) {
-    copyDirRecursively(source.getPathTo(dir), dest.getPathTo(dir));
+    copyDirRecursively(source.getPathTo(dir), dest.getPathTo(dir), strategy);
   }
 }
 
@@ -176,6 +198,61 @@ QList<FilePath> FileUtils::getFilesInDirectory(const FilePath&    dir,
   return files;
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+bool FileUtils::linkFile(const FilePath& source,
+                         const FilePath& dest) noexcept {
+  // fails e.g. if source and destination are on different file systems
+#if defined(Q_OS_UNIX)
+  return ::link(QFile::encodeName(source.toStr()).constData(),
+                QFile::encodeName(dest.toStr()).constData()) == 0;
+#elif defined(Q_OS_WIN32) || defined(Q_OS_WIN64)
+  return CreateHardLinkW(
+             reinterpret_cast<LPCWSTR>(dest.toNative().utf16()),
+             reinterpret_cast<LPCWSTR>(source.toNative().utf16()),
+             nullptr) != 0;
+#else
+  Q_UNUSED(source);
+  Q_UNUSED(dest);
+  return false;
+#endif
+}
+
+bool FileUtils::cloneFile(const FilePath& source,
+                          const FilePath& dest) noexcept {
+  // fails e.g. if the file system does not support copy-on-write
+#if defined(Q_OS_OSX)
+  return ::clonefile(QFile::encodeName(source.toStr()).constData(),
+                     QFile::encodeName(dest.toStr()).constData(), 0) == 0;
+#elif defined(Q_OS_LINUX) && defined(FICLONE)
+  int src = ::open(QFile::encodeName(source.toStr()).constData(),
+                   O_RDONLY | O_CLOEXEC);
+  if (src < 0) return false;
+  int dst = ::open(QFile::encodeName(dest.toStr()).constData(),
+                   O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+  if (dst < 0) {
+    ::close(src);
+    return false;
+  }
+  bool success = (::ioctl(dst, FICLONE, src) == 0);
+  ::close(dst);
+  ::close(src);
+  if (success) {
+    // same as QFile::copy()
+    QFile::setPermissions(dest.toStr(), QFile::permissions(source.toStr()));
+  } else {
+    QFile::remove(dest.toStr());
+  }
+  return success;
+#else
+  Q_UNUSED(source);
+  Q_UNUSED(dest);
+  return false;
+#endif
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -49,6 +49,23 @@ class FileUtils final {
   Q_DECLARE_TR_FUNCTIONS(FileUtils)
 
 public:
+  // Types
+
+  /**
+   * @brief Strategies for #copyFile() and #copyDirRecursively()
+   */
+  enum class CopyStrategy {
+    /// Always create real copies of the files
+    Copy,
+    /// Clone files with copy-on-write (e.g. reflinks on Btrfs, XFS or APFS)
+    /// if supported by the file system, otherwise create real copies
+    Clone,
+    /// Create hardlinks if possible, otherwise clone or copy the files. Use
+    /// this only if the files are never modified in place, i.e. only replaced
+    /// atomically (e.g. by #writeFile()), since all links share the content!
+    Link,
+  };
+
   // Constructors / Destructor
   FileUtils()                       = delete;
   FileUtils(const FileUtils& other) = delete;
@@ -85,10 +102,13 @@ public:
    * @param source        Filepath to an existing file.
    * @param dest          Filepath to a non-existing file (if it exists already,
    *                      an exception will be thrown).
+   * @param strategy      How to copy the file. If links or clones are not
+   *                      supported, the file is copied.
    *
    * @throws Exception    If an error occurs.
    */
-  static void copyFile(const FilePath& source, const FilePath& dest);
+  static void copyFile(const FilePath& source, const FilePath& dest,
+                       CopyStrategy strategy = CopyStrategy::Copy);
 
   /**
    * @brief Copy a directory recursively
@@ -96,10 +116,12 @@ public:
    * @param source        Filepath to an existing directory.
    * @param dest          Filepath to a non-existing directory (if it exists
    *                      already, an exception will be thrown).
+   * @param strategy      How to copy the files, see #copyFile().
    *
    * @throws Exception    If an error occurs.
    */
-  static void copyDirRecursively(const FilePath& source, const FilePath& dest);
+  static void copyDirRecursively(const FilePath& source, const FilePath& dest,
+                                 CopyStrategy strategy = CopyStrategy::Copy);
 
   /**
    * @brief Move/rename a file or directory
@@ -151,6 +173,10 @@ public:
 
   // Operator Overloadings
   FileUtils& operator=(const FileUtils& rhs) = delete;
+
+private:  // Methods
+  static bool linkFile(const FilePath& source, const FilePath& dest) noexcept;
+  static bool cloneFile(const FilePath& source, const FilePath& dest) noexcept;
 };
 
 }  // namespace librepcb
@@ -22,15 +22,255 @@
  ******************************************************************************/
 #include "sexpression.h"
 
-#include <sexpresso/sexpresso.hpp>
-
 #include <QtCore>
 
+#include <algorithm>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
 namespace librepcb {
 
+/*******************************************************************************
+ *  Class SExpression::Parser
+ ******************************************************************************/
+
+/**
+ * @brief Single pass parser for UTF-8 encoded S-Expression documents
+ *
+ * Atoms are either quoted strings (with C-like escape sequences) or unquoted
+ * runs of characters up to the next whitespace or parenthesis, and ';' starts
+ * a line comment. All atoms are returned as strings.
+ *
+ * To keep the DOM tree compact, short unquoted tokens (list names, layer
+ * names, numbers, ...) are interned, i.e. identical tokens share the same
+ * implicitly shared string.
+ */
+class SExpression::Parser final {
+public:
+  Parser(const QByteArray& content, const FilePath& filePath,
+         const QSet<QString>& skippedLists) noexcept
+    : mBegin(content.constData()),
+      mPos(content.constData()),
+      mEnd(content.constData() + content.size()),
+      mFilePath(filePath),
+      mSkippedLists(skippedLists) {}
+
+  SExpression parseDocument() {
+    SExpression document(Type::List, QString());
+    parseChildren(document, true);
+    if (document.mChildren.count() != 1) {
+      throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, QString(),
+                           tr("File does not have exactly one root node."));
+    } else if (!document.mChildren.first().isList()) {
+      throwError(tr("Root node is not a list."));
+    }
+    return document.mChildren.first();
+  }
+
+private:
+  void parseChildren(SExpression& parent, bool topLevel) {
+    while (true) {
+      skipWhitespaceAndComments();
+      if (mPos == mEnd) {
+        if (!topLevel) throwError(tr("Unterminated list."));
+        return;
+      }
+      char c = *mPos;
+      if (c == ')') {
+        if (topLevel) throwError(tr("Too many closing parentheses."));
+        ++mPos;
+        return;
+      } else if (c == '(') {
+        ++mPos;
+        parseList(parent);
+      } else {
+        parent.mChildren.append(createAtom((c == '"') ? parseString()
+                                                      : parseToken()));
+      }
+    }
+  }
+
+  void parseList(SExpression& parent) {
+    skipWhitespaceAndComments();
+    QString name;
+    if ((mPos == mEnd) || (*mPos == ')')) {
+      throwError(tr("List without name."));
+    } else if (*mPos == '(') {
+      throwError(tr("List name is not a string."));
+    } else if (*mPos == '"') {
+      name = parseString();
+    } else {
+      name = parseToken();
+    }
+    if ((!mSkippedLists.isEmpty()) && mSkippedLists.contains(name)) {
+      skipRemainingList();
+      return;
+    }
+    // Append first and fill afterwards to avoid copying the whole subtree.
+    parent.mChildren.append(SExpression(Type::List, name));
+    SExpression& list = parent.mChildren.last();
+    list.mFilePath    = mFilePath;
+    parseChildren(list, false);
+  }
+
+  QString parseString() {
+    const char* begin     = ++mPos;  // skip opening quote
+    bool        hasEscape = false;
+    for (; mPos < mEnd; ++mPos) {
+      if (*mPos == '"') {
+        break;
+      } else if (*mPos == '\\') {
+        hasEscape = true;
+        ++mPos;  // skip escaped character
+      } else if (*mPos == '\n') {
+        throwError(tr("Unexpected newline in string literal."));
+      }
+    }
+    if (mPos >= mEnd) {
+      throwError(tr("Unterminated string literal."));
+    }
+    const char* end = mPos++;  // skip closing quote
+    if (!hasEscape) {
+      return QString::fromUtf8(begin, static_cast<int>(end - begin));
+    }
+    QByteArray unescaped;
+    unescaped.reserve(static_cast<int>(end - begin));
+    for (const char* p = begin; p < end; ++p) {
+      if (*p == '\\') {
+        ++p;
+        char c = unescapeChar(*p);
+        if (c == '\0') {
+          mPos = p;
+          throwError(QString(tr("Invalid escape sequence: \\%1"))
+                         .arg(QString::fromUtf8(p, 1)));
+        }
+        unescaped.append(c);
+      } else {
+        unescaped.append(*p);
+      }
+    }
+    return QString::fromUtf8(unescaped);
+  }
+
+  QString parseToken() {
+    const char* begin = mPos;
+    while ((mPos < mEnd) && (!isSpace(*mPos)) && (*mPos != '(') &&
+           (*mPos != ')')) {
+      ++mPos;
+    }
+    int length = static_cast<int>(mPos - begin);
+    if (length > sMaxInternedTokenLength) {
+      return QString::fromUtf8(begin, length);  // e.g. UUIDs, rarely repeated
+    }
+    // List names, layer names, numbers etc. are repeated a lot, so share
+    // their strings. The keys refer to the parsed content, which outlives
+    // the parser.
+    QString& token = mTokens[QByteArray::fromRawData(begin, length)];
+    if (token.isNull()) {
+      token = QString::fromUtf8(begin, length);
+    }
+    return token;
+  }
+
+  void skipRemainingList() {
+    int depth = 1;
+    while (true) {
+      skipWhitespaceAndComments();
+      if (mPos == mEnd) {
+        throwError(tr("Unterminated list."));
+      } else if (*mPos == '(') {
+        ++depth;
+        ++mPos;
+      } else if (*mPos == ')') {
+        ++mPos;
+        if (--depth == 0) return;
+      } else if (*mPos == '"') {
+        parseString();
+      } else {
+        while ((mPos < mEnd) && (!isSpace(*mPos)) && (*mPos != '(') &&
+               (*mPos != ')')) {
+          ++mPos;
+        }
+      }
+    }
+  }
+
+  void skipWhitespaceAndComments() noexcept {
+    while (mPos < mEnd) {
+      if (isSpace(*mPos)) {
+        ++mPos;
+      } else if (*mPos == ';') {
+        while ((mPos < mEnd) && (*mPos != '\n')) ++mPos;
+      } else {
+        return;
+      }
+    }
+  }
+
+  SExpression createAtom(const QString& value) const noexcept {
+    SExpression atom(Type::String, value);
+    atom.mFilePath = mFilePath;
+    return atom;
+  }
+
+  [[noreturn]] void throwError(const QString& msg) const {
+    int         line       = 1;
+    const char* lineBegin  = mBegin;
+    const char* errorBegin = std::min(mPos, mEnd);
+    for (const char* p = mBegin; p < errorBegin; ++p) {
+      if (*p == '\n') {
+        ++line;
+        lineBegin = p + 1;
+      }
+    }
+    int column = static_cast<int>(errorBegin - lineBegin) + 1;
+    throw FileParseError(__FILE__, __LINE__, mFilePath, line, column,
+                         QString(), msg);
+  }
+
+  static bool isSpace(char c) noexcept {
+    return (c == ' ') || (c == '\n') || (c == '\r') || (c == '\t') ||
+           (c == '\v') || (c == '\f');
+  }
+
+  static char unescapeChar(char c) noexcept {
+    switch (c) {
+      case '\'':
+      case '"':
+      case '?':
+      case '\\':
+        return c;
+      case 'a':
+        return '\a';
+      case 'b':
+        return '\b';
+      case 'f':
+        return '\f';
+      case 'n':
+        return '\n';
+      case 'r':
+        return '\r';
+      case 't':
+        return '\t';
+      case 'v':
+        return '\v';
+      default:
+        return '\0';
+    }
+  }
+
+  const char*                mBegin;
+  const char*                mPos;
+  const char*                mEnd;
+  const FilePath&            mFilePath;
+  const QSet<QString>&       mSkippedLists;
+  QHash<QByteArray, QString> mTokens;  ///< Interned unquoted tokens
+
+  /// Longer tokens are not interned since they are rarely repeated
+  static constexpr int sMaxInternedTokenLength = 24;
+};
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -49,30 +289,6 @@ SExpression::SExpression(const SExpression& other) noexcept
     mFilePath(other.mFilePath) {
 }
 
-SExpression::SExpression(sexpresso::Sexp& sexp, const FilePath& filePath)
-  : mType(Type::List), mValue(), mFilePath(filePath) {
-  if (sexp.childCount() < 1) {
-    throw RuntimeError(__FILE__, __LINE__);
-  }
-
-  if (sexp.isSexp()) {
-    sexpresso::Sexp& first = sexp.getChild(0);
-    if (!first.isString()) {
-      throw RuntimeError(__FILE__, __LINE__);
-    }
-    mValue = QString::fromStdString(first.getString());
-    for (auto&& arg : sexp.arguments()) {
-      mChildren.append(SExpression(arg, filePath));
-    }
-  } else if (sexp.isString()) {
-    mValue = QString::fromStdString(sexp.getString());
-    mType  = Type::String;
-  } else {
-    throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, QString(),
-                         tr("Unknown node type."));
-  }
-}
-
 SExpression::~SExpression() noexcept {
 }
 
@@ -110,10 +326,10 @@ const QString& SExpression::getStringOrToken(bool throwIfEmpty) const {
   return mValue;
 }
 
-QList<SExpression> SExpression::getChildren(const QString& name) const
+QVector<SExpression::Ref> SExpression::getChildren(const QString& name) const
     noexcept {
-  QList<SExpression> children;
-  foreach (const SExpression& child, mChildren) {
+  QVector<Ref> children;
+  for (const SExpression& child : mChildren) {
     if (child.isList() && (child.mValue == name)) {
       children.append(child);
     }
@@ -190,78 +406,195 @@ void SExpression::removeLineBreaks() noexcept {
 }
 
 QString SExpression::toString(int indent) const {
+  QByteArray output;
+  serialize(output, indent);  // can throw
+  return QString::fromUtf8(output);
+}
+
+void SExpression::serialize(QByteArray& output, int indent) const {
+  write(output, indent);  // can throw
+}
+
+quint64 SExpression::calculateHash() const noexcept {
+  quint64 hash = Q_UINT64_C(14695981039346656037);  // FNV-1a offset basis
+  addToHash(hash);
+  return hash;
+}
+
+/*******************************************************************************
+ *  Operator Overloadings
+ ******************************************************************************/
+
+SExpression& SExpression::operator=(const SExpression& rhs) noexcept {
+  mType     = rhs.mType;
+  mValue    = rhs.mValue;
+  mChildren = rhs.mChildren;
+  mFilePath = rhs.mFilePath;
+  return *this;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+bool SExpression::write(QByteArray& output, int indent) const {
+  // Returns whether the written node spans multiple lines, which is needed
+  // for the closing parenthesis of the parent list.
   if (mType == Type::List) {
     if (!isValidListName(mValue)) {
       throw LogicError(
           __FILE__, __LINE__,
           QString(tr("Invalid S-Expression list name: %1")).arg(mValue));
     }
-    QString str = '(' + mValue;
+    output.append('(');
+    writeAscii(output, mValue);
+    bool multiLine = false;
     for (int i = 0; i < mChildren.count(); ++i) {
       const SExpression& child = mChildren.at(i);
-      if ((!str.at(str.length() - 1).isSpace()) && (!child.isLineBreak())) {
-        str += ' ';
+      char               last  = output.at(output.length() - 1);
+      if ((last != ' ') && (last != '\n') && (!child.isLineBreak())) {
+        output.append(' ');
       }
       bool nextChildIsLineBreak = (i < mChildren.count() - 1)
                                       ? mChildren.at(i + 1).isLineBreak()
                                       : true;
       if (child.isLineBreak() && nextChildIsLineBreak) {
-        if (child.isLineBreak() && (i > 0) &&
-            mChildren.at(i - 1).isLineBreak()) {
+        if ((i > 0) && mChildren.at(i - 1).isLineBreak()) {
           // too many line breaks ;)
         } else {
-          str += '\n';
+          output.append('\n');
         }
-      } else {
-        str += child.toString(indent + 1);
+        multiLine = true;
+      } else if (child.write(output, indent + 1)) {
+        multiLine = true;
       }
     }
-    if (isMultiLineList()) {
-      str += '\n' + QString(' ').repeated(indent);
+    if (multiLine) {
+      output.append('\n');
+      output.append(QByteArray(indent, ' '));
     }
-    return str + ')';
+    output.append(')');
+    return multiLine;
   } else if (mType == Type::Token) {
     if (!isValidToken(mValue)) {
       throw LogicError(
           __FILE__, __LINE__,
           QString(tr("Invalid S-Expression token: %1")).arg(mValue));
     }
-    return mValue;
+    writeAscii(output, mValue);
+    return false;
   } else if (mType == Type::String) {
-    return '"' + escapeString(mValue) + '"';
+    writeString(output, mValue);
+    return false;
   } else if (mType == Type::LineBreak) {
-    return '\n' + QString(' ').repeated(indent);
+    output.append('\n');
+    output.append(QByteArray(indent, ' '));
+    return true;
   } else {
     throw LogicError(__FILE__, __LINE__);
   }
 }
 
-/*******************************************************************************
- *  Operator Overloadings
- ******************************************************************************/
+void SExpression::addToHash(quint64& hash) const noexcept {
+  auto add = [&hash](const void* data, int size) {
+    const uchar* bytes = static_cast<const uchar*>(data);
+    for (int i = 0; i < size; ++i) {
+      hash ^= bytes[i];
+      hash *= Q_UINT64_C(1099511628211);  // FNV-1a prime
+    }
+  };
+  // Note: The sizes are included to separate adjacent values unambiguously.
+  const qint32 header[3] = {static_cast<qint32>(mType), mValue.length(),
+                            mChildren.count()};
+  add(header, sizeof(header));
+  add(mValue.constData(), mValue.length() * static_cast<int>(sizeof(QChar)));
+  for (const SExpression& child : mChildren) {
+    child.addToHash(hash);
+  }
+}
 
-SExpression& SExpression::operator=(const SExpression& rhs) noexcept {
-  mType     = rhs.mType;
-  mValue    = rhs.mValue;
-  mChildren = rhs.mChildren;
-  mFilePath = rhs.mFilePath;
-  return *this;
+void SExpression::writeString(QByteArray&    output,
+                              const QString& string) noexcept {
+  output.append('"');
+  for (int i = 0; i < string.length(); ++i) {
+    ushort c = string.at(i).unicode();
+    if (c >= 0x80) {
+      // non-ASCII characters never need to be escaped, so just encode the
+      // rest of the string and escape it bytewise
+      QByteArray utf8 = string.midRef(i).toUtf8();
+      for (char b : utf8) {
+        char escaped = escapeChar(b);
+        if (escaped) output.append('\\');
+        output.append(escaped ? escaped : b);
+      }
+      break;
+    }
+    char escaped = escapeChar(static_cast<char>(c));
+    if (escaped) output.append('\\');
+    output.append(escaped ? escaped : static_cast<char>(c));
+  }
+  output.append('"');
 }
 
-/*******************************************************************************
- *  Private Methods
- ******************************************************************************/
+void SExpression::writeAscii(QByteArray&    output,
+                             const QString& ascii) noexcept {
+  // only used for validated list names and tokens
+  for (const QChar& c : ascii) {
+    output.append(static_cast<char>(c.unicode()));
+  }
+}
 
-QString SExpression::escapeString(const QString& string) const noexcept {
-  return QString::fromStdString(sexpresso::escape(string.toStdString()));
+char SExpression::escapeChar(char c) noexcept {
+  switch (c) {
+    case '\'':
+    case '"':
+    case '?':
+    case '\\':
+      return c;
+    case '\a':
+      return 'a';
+    case '\b':
+      return 'b';
+    case '\f':
+      return 'f';
+    case '\n':
+      return 'n';
+    case '\r':
+      return 'r';
+    case '\t':
+      return 't';
+    case '\v':
+      return 'v';
+    default:
+      return '\0';
+  }
 }
 
-bool SExpression::isValidListName(const QString& name) const noexcept {
-  return QRegExp("[a-z][a-z0-9_]*").exactMatch(name);
+bool SExpression::isValidListName(const QString& name) noexcept {
+  // [a-z][a-z0-9_]*
+  if (name.isEmpty()) return false;
+  for (int i = 0; i < name.length(); ++i) {
+    ushort c = name.at(i).unicode();
+    if (!(((c >= 'a') && (c <= 'z')) ||
+          ((i > 0) && (((c >= '0') && (c <= '9')) || (c == '_'))))) {
+      return false;
+    }
+  }
+  return true;
 }
 
-bool SExpression::isValidToken(const QString& token) const noexcept {
-  return QRegExp("[a-zA-Z0-9\\.:_-]+").exactMatch(token);
+bool SExpression::isValidToken(const QString& token) noexcept {
+  // [a-zA-Z0-9\.:_-]+
+  if (token.isEmpty()) return false;
+  foreach (const QChar& qc, token) {
+    ushort c = qc.unicode();
+    if (!(((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) ||
+          ((c >= '0') && (c <= '9')) || (c == '.') || (c == ':') ||
+          (c == '_') || (c == '-'))) {
+      return false;
+    }
+  }
+  return true;
 }
 
 /*******************************************************************************
@@ -284,20 +617,11 @@ SExpression SExpression::createLineBreak() {
   return SExpression(Type::LineBreak, QString());
 }
 
-SExpression SExpression::parse(const QString& str, const FilePath& filePath) {
-  std::string     error;
-  sexpresso::Sexp tree = sexpresso::parse(str.toStdString(), error);
-  if (error.empty()) {
-    if (tree.childCount() == 1) {
-      return SExpression(tree.getChild(0), filePath);
-    } else {
-      throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
-                           tr("File does not have exactly one root node."));
-    }
-  } else {
-    throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
-                         QString::fromStdString(error));
-  }
+SExpression SExpression::parse(const QByteArray&    content,
+                               const FilePath&      filePath,
+                               const QSet<QString>& skippedLists) {
+  Parser parser(content, filePath, skippedLists);
+  return parser.parseDocument();  // can throw
 }
 
 /*******************************************************************************
@@ -32,10 +32,6 @@
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
-namespace sexpresso {
-struct Sexp;
-}
-
 namespace librepcb {
 
 class SExpression;
@@ -69,6 +65,23 @@ public:
     LineBreak,  ///< manual line break inside a List
   };
 
+  /**
+   * @brief Non-owning reference to a node
+   *
+   * Implicitly converts to `const SExpression&`, so lists of references can
+   * be iterated like lists of nodes, but without copying any node.
+   */
+  class Ref final {
+  public:
+    Ref() noexcept : mNode(nullptr) {}
+    Ref(const SExpression& node) noexcept : mNode(&node) {}
+    operator const SExpression&() const noexcept { return *mNode; }
+    const SExpression* operator->() const noexcept { return mNode; }
+
+  private:
+    const SExpression* mNode;
+  };
+
   // Constructors / Destructor
   SExpression() noexcept;
   SExpression(const SExpression& other) noexcept;
@@ -85,7 +98,7 @@ public:
   const QString&            getName() const;
   const QString&            getStringOrToken(bool throwIfEmpty = false) const;
   const QList<SExpression>& getChildren() const { return mChildren; }
-  QList<SExpression>        getChildren(const QString& name) const noexcept;
+  QVector<Ref>              getChildren(const QString& name) const noexcept;
   const SExpression&        getChildByIndex(int index) const;
   const SExpression* tryGetChildByPath(const QString& path) const noexcept;
   const SExpression& getChildByPath(const QString& path) const;
@@ -131,6 +144,30 @@ public:
   void    removeLineBreaks() noexcept;
   QString toString(int indent) const;
 
+  /**
+   * @brief Serialize the node (including all children) as UTF-8
+   *
+   * The output is appended to the passed buffer in a single pass, so the
+   * caller can reserve the expected size in advance to avoid reallocations.
+   *
+   * @param output  The buffer to append the serialized node to.
+   * @param indent  The indentation level of the node.
+   *
+   * @throw LogicError If a list name or token contains invalid characters.
+   */
+  void serialize(QByteArray& output, int indent) const;
+
+  /**
+   * @brief Calculate a hash of the node (including all children)
+   *
+   * The hash covers everything which affects the output of #serialize(), so
+   * it can be used to cheaply detect whether a document has changed since it
+   * was last serialized, without serializing it again.
+   *
+   * @return 64-bit FNV-1a hash
+   */
+  quint64 calculateHash() const noexcept;
+
   // Operator Overloadings
   SExpression& operator=(const SExpression& rhs) noexcept;
 
@@ -139,21 +176,56 @@ public:
   static SExpression createToken(const QString& token);
   static SExpression createString(const QString& string);
   static SExpression createLineBreak();
-  static SExpression parse(const QString& str, const FilePath& filePath);
+
+  /**
+   * @brief Parse an S-Expression document
+   *
+   * The UTF-8 encoded content is tokenized directly into the DOM tree in a
+   * single pass, without any intermediate representation. Identical list
+   * names and short tokens share the same (implicitly shared) string.
+   *
+   * @param content       The UTF-8 encoded document to parse.
+   * @param filePath      The file path of the document (for error messages).
+   * @param skippedLists  Lists with one of these names are skipped (including
+   *                      all their children) while parsing, so no DOM nodes
+   *                      are built for them at all. This allows to cheaply
+   *                      read only some nodes of large documents.
+   *
+   * @return The root node of the document
+   *
+   * @throw FileParseError If the document is not valid.
+   */
+  static SExpression parse(
+      const QByteArray& content, const FilePath& filePath,
+      const QSet<QString>& skippedLists = QSet<QString>());
+
+private:  // Types
+  class Parser;
 
 private:  // Methods
   SExpression(Type type, const QString& value);
-  SExpression(sexpresso::Sexp& sexp, const FilePath& filePath);
 
-  QString escapeString(const QString& string) const noexcept;
-  bool    isValidListName(const QString& name) const noexcept;
-  bool    isValidToken(const QString& token) const noexcept;
+  bool        write(QByteArray& output, int indent) const;
+  void        addToHash(quint64& hash) const noexcept;
+  static void writeString(QByteArray& output, const QString& string) noexcept;
+  static void writeAscii(QByteArray& output, const QString& ascii) noexcept;
+  static char escapeChar(char c) noexcept;
+  static bool isValidListName(const QString& name) noexcept;
+  static bool isValidToken(const QString& token) noexcept;
 
 private:  // Data
-  Type               mType;
-  QString            mValue;  ///< either a list name, a token or a string
+  Type    mType;
+  QString mValue;  ///< either a list name, a token or a string
+
+  /**
+   * @brief The child nodes
+   *
+   * Each node is allocated separately, so references to nodes (e.g. returned
+   * by #appendList()) stay valid when more children are appended.
+   */
   QList<SExpression> mChildren;
-  FilePath           mFilePath;
+
+  FilePath mFilePath;  ///< shared by all nodes of a document
 };
 
 /*******************************************************************************
@@ -288,4 +360,6 @@ inline QUrl deserializeFromSExpression(const SExpression& sexpr,
 
 }  // namespace librepcb
 
+Q_DECLARE_TYPEINFO(librepcb::SExpression::Ref, Q_PRIMITIVE_TYPE);
+
 #endif  // LIBREPCB_SEXPRESSION_H
@@ -42,7 +42,9 @@ SmartFile::SmartFile(const FilePath& filepath, bool restore, bool readOnly,
     mOpenedFilePath(filepath),
     mIsRestored(restore),
     mIsReadOnly(readOnly),
-    mIsCreated(create) {
+    mIsCreated(create),
+    mOriginalFileState{QByteArray(), -1, QDateTime()},
+    mTmpFileState{QByteArray(), -1, QDateTime()} {
   if (create) {
     Q_ASSERT(mIsRestored == false);
     Q_ASSERT(mIsReadOnly == false);
@@ -113,6 +115,60 @@ void SmartFile::updateMembersAfterSaving(bool toOriginal) noexcept {
   if (toOriginal && mIsCreated) mIsCreated = false;
 }
 
+void SmartFile::setOpenedFileContent(const QByteArray& content) const
+    noexcept {
+  if (mIsReadOnly) return;  // will never be written anyway
+  FileState state = getFileState(
+      mOpenedFilePath,
+      QCryptographicHash::hash(content, QCryptographicHash::Md5));
+  if (mOpenedFilePath == mTmpFilePath) {
+    mTmpFileState = state;
+  } else {
+    mOriginalFileState = state;
+  }
+}
+
+bool SmartFile::writeContent(bool toOriginal, const QByteArray& content) {
+  QByteArray hash = QCryptographicHash::hash(content, QCryptographicHash::Md5);
+  bool       upToDate;
+  if (toOriginal) {
+    upToDate =
+        (hash == mOriginalFileState.contentHash) && isFileUnchanged(true);
+  } else if (mTmpFilePath.isExistingFile()) {
+    upToDate = (hash == mTmpFileState.contentHash) && isFileUnchanged(false);
+  } else {
+    // a backup with the same content as the original file is not needed
+    upToDate =
+        (hash == mOriginalFileState.contentHash) && isFileUnchanged(true);
+  }
+  if (upToDate) {
+    return false;
+  }
+
+  const FilePath& filepath = toOriginal ? mFilePath : mTmpFilePath;
+  FileUtils::writeFile(filepath, content);  // can throw
+  if (toOriginal) {
+    mOriginalFileState = getFileState(mFilePath, hash);
+  } else {
+    mTmpFileState = getFileState(mTmpFilePath, hash);
+  }
+  return true;
+}
+
+bool SmartFile::isFileUnchanged(bool original) const noexcept {
+  const FileState& state = original ? mOriginalFileState : mTmpFileState;
+  QFileInfo        info((original ? mFilePath : mTmpFilePath).toStr());
+  return (!state.contentHash.isEmpty()) && info.isFile() &&
+         (info.size() == state.size) &&
+         (info.lastModified() == state.lastModified);
+}
+
+SmartFile::FileState SmartFile::getFileState(
+    const FilePath& filepath, const QByteArray& contentHash) noexcept {
+  QFileInfo info(filepath.toStr());
+  return FileState{contentHash, info.size(), info.lastModified()};
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -47,6 +47,8 @@ namespace librepcb {
  *  - Creation of backup files ('~' at the end of the filename)
  *  - Restoring backup files
  *  - Helper methods for subclasses to load/save files
+ *  - Skip writing files whose content did not change since they were last
+ * read or written
  *
  * @note See @ref doc_project_save for more details about the backup/restore
  * feature.
@@ -176,6 +178,64 @@ protected:
    */
   void updateMembersAfterSaving(bool toOriginal) noexcept;
 
+  /**
+   * @brief Remember the content which was read from #mOpenedFilePath
+   *
+   * This allows #writeContent() to skip writing the same content again.
+   *
+   * @param content   The content of the opened file.
+   */
+  void setOpenedFileContent(const QByteArray& content) const noexcept;
+
+  /**
+   * @brief Write the content to the original or backup file, if needed
+   *
+   * Writing is skipped if the file already exists with the same content as
+   * last read or written by this object. A backup file is not written at all
+   * if there is none yet and the content equals the original file. Files
+   * which were modified by someone else in the meantime (see
+   * #isFileUnchanged()) are always written.
+   *
+   * @note This method must be called between #prepareSaveAndReturnFilePath()
+   * and #updateMembersAfterSaving().
+   *
+   * @param toOriginal    Specifies whether the original or the backup file
+   * should be overwritten/created.
+   * @param content       The new content of the file.
+   *
+   * @return True if the file was written, false if it was skipped.
+   *
+   * @throw Exception If an error occurs
+   */
+  bool writeContent(bool toOriginal, const QByteArray& content);
+
+  /**
+   * @brief Check if a file was not modified since it was last read or written
+   *        by this object
+   *
+   * Only the size and modification time of the file are compared, so this
+   * check is cheap.
+   *
+   * @param original  Specifies whether the original or the backup file should
+   *                  be checked.
+   *
+   * @return False if the file does not exist, was never read or written by
+   *         this object or was modified in the meantime, true otherwise.
+   */
+  bool isFileUnchanged(bool original) const noexcept;
+
+  // Types
+
+  /// The state of a file as last read or written by this object
+  struct FileState {
+    QByteArray contentHash;   ///< MD5 hash of the content (empty if unknown)
+    qint64     size;          ///< Size of the file [bytes]
+    QDateTime  lastModified;  ///< Modification time of the file
+  };
+
+  static FileState getFileState(const FilePath&   filepath,
+                                const QByteArray& contentHash) noexcept;
+
   // General Attributes
 
   /**
@@ -220,6 +280,16 @@ protected:
    * (so the file #mFilePath does not yet exist!)
    */
   bool mIsCreated;
+
+  /**
+   * @brief State of #mFilePath as last read or written by this object
+   */
+  mutable FileState mOriginalFileState;
+
+  /**
+   * @brief State of #mTmpFilePath as last read or written by this object
+   */
+  mutable FileState mTmpFileState;
 };
 
 /*******************************************************************************
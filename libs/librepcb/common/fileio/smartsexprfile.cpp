@@ -38,7 +38,9 @@ namespace librepcb {
 
 SmartSExprFile::SmartSExprFile(const FilePath& filepath, bool restore,
                                bool readOnly, bool create)
-  : SmartFile(filepath, restore, readOnly, create) {
+  : SmartFile(filepath, restore, readOnly, create),
+    mOriginalDomHash(0),
+    mTmpDomHash(0) {
 }
 
 SmartSExprFile::~SmartSExprFile() noexcept {
@@ -48,19 +50,69 @@ SmartSExprFile::~SmartSExprFile() noexcept {
  *  General Methods
  ******************************************************************************/
 
-SExpression SmartSExprFile::parseFileAndBuildDomTree() const {
-  return SExpression::parse(FileUtils::readFile(mOpenedFilePath),
-                            mOpenedFilePath);
+SExpression SmartSExprFile::parseFileAndBuildDomTree(
+    const QSet<QString>& skippedLists) const {
+  QByteArray content = FileUtils::readFile(mOpenedFilePath);  // can throw
+  setOpenedFileContent(content);
+  return SExpression::parse(content, mOpenedFilePath, skippedLists);
 }
 
-void SmartSExprFile::save(const SExpression& domDocument, bool toOriginal) {
-  FilePath filepath = prepareSaveAndReturnFilePath(toOriginal);  // can throw
-  QString  content  = domDocument.toString(0);                   // can throw
+bool SmartSExprFile::save(const SExpression& domDocument, bool toOriginal) {
+  prepareSaveAndReturnFilePath(toOriginal);  // can throw
+  quint64    domHash = domDocument.calculateHash();
+  QByteArray content;
+  if (!isUpToDate(domHash, toOriginal)) {
+    content = serialize(domDocument);  // can throw
+  }
+  return saveSerialized(content, domHash, toOriginal);  // can throw
+}
+
+QByteArray SmartSExprFile::serialize(const SExpression& domDocument) const {
+  QByteArray content;
+  // the size of the previously opened file is a good estimation
+  content.reserve(static_cast<int>(QFileInfo(mOpenedFilePath.toStr()).size()) +
+                  4096);
+  domDocument.serialize(content, 0);  // can throw
   if (!content.endsWith('\n')) {
     content.append('\n');
   }
-  FileUtils::writeFile(filepath, content.toUtf8());  // can throw
+  return content;
+}
+
+bool SmartSExprFile::isUpToDate(quint64 domHash, bool toOriginal) const
+    noexcept {
+  if (toOriginal) {
+    return (domHash == mOriginalDomHash) && isFileUnchanged(true);
+  } else if (mTmpFilePath.isExistingFile()) {
+    return (domHash == mTmpDomHash) && isFileUnchanged(false);
+  } else {
+    // a backup with the same content as the original file is not needed
+    return (domHash == mOriginalDomHash) && isFileUnchanged(true);
+  }
+}
+
+bool SmartSExprFile::saveSerialized(const QByteArray& content, quint64 domHash,
+                                    bool toOriginal) {
+  const FilePath& filepath = prepareSaveAndReturnFilePath(toOriginal);
+  bool            written  = false;
+  if (content.isNull()) {
+    // the file must not have been modified since the DOM tree was checked
+    if (!isUpToDate(domHash, toOriginal)) {
+      throw RuntimeError(
+          __FILE__, __LINE__,
+          QString(tr("The file \"%1\" was modified while saving it."))
+              .arg(filepath.toNative()));
+    }
+  } else {
+    written = writeContent(toOriginal, content);  // can throw
+    if (toOriginal) {
+      mOriginalDomHash = domHash;
+    } else {
+      mTmpDomHash = domHash;
+    }
+  }
   updateMembersAfterSaving(toOriginal);
+  return written;
 }
 
 /*******************************************************************************
@@ -87,21 +87,79 @@ public:
   /**
    * @brief Open and parse the S-Expressions file and build the whole DOM tree
    *
+   * @param skippedLists  Names of lists which are skipped (including all their
+   *                      children) without building them, see
+   *                      SExpression#parse(). Useful to read only the header
+   *                      of large files.
+   *
    * @return  A pointer to the created DOM tree. The caller takes the ownership
    * of the DOM document.
    */
-  SExpression parseFileAndBuildDomTree() const;
+  SExpression parseFileAndBuildDomTree(
+      const QSet<QString>& skippedLists = QSet<QString>()) const;
 
   /**
    * @brief Write the S-Expressions DOM tree to the file system
    *
+   * The DOM tree is not serialized at all if it has not changed since it was
+   * last saved by this object (see #isUpToDate()).
+   *
    * @param domDocument   The DOM document to save
    * @param toOriginal    Specifies whether the original or the backup file
    * should be overwritten/created.
    *
+   * @return  See SmartFile#writeContent()
+   *
    * @throw Exception If an error occurs
    */
-  void save(const SExpression& domDocument, bool toOriginal);
+  bool save(const SExpression& domDocument, bool toOriginal);
+
+  /**
+   * @brief Serialize a DOM tree into the file content, without saving it
+   *
+   * This method is thread-safe, i.e. several DOM trees can be serialized
+   * concurrently (see #SmartSExprFileBatch).
+   *
+   * @param domDocument   The DOM document to serialize
+   *
+   * @return The UTF-8 encoded file content
+   *
+   * @throw Exception If an error occurs
+   */
+  QByteArray serialize(const SExpression& domDocument) const;
+
+  /**
+   * @brief Check if a DOM tree does not need to be saved
+   *
+   * This method is thread-safe as long as the file is not saved at the same
+   * time, i.e. it can be called together with #serialize().
+   *
+   * @param domHash       Hash of the DOM tree (SExpression#calculateHash())
+   * @param toOriginal    Specifies whether the original or the backup file
+   *                      would be overwritten/created.
+   *
+   * @return True if the same DOM tree was already saved by this object and
+   *         the file was not modified since then, false otherwise.
+   */
+  bool isUpToDate(quint64 domHash, bool toOriginal) const noexcept;
+
+  /**
+   * @brief Write content created by #serialize() to the file system
+   *
+   * @param content       The file content, or a null QByteArray if
+   *                      #isUpToDate() returned true for this DOM tree (then
+   *                      nothing is written)
+   * @param domHash       Hash of the serialized DOM tree
+   *                      (SExpression#calculateHash())
+   * @param toOriginal    Specifies whether the original or the backup file
+   * should be overwritten/created.
+   *
+   * @return  See SmartFile#writeContent()
+   *
+   * @throw Exception If an error occurs
+   */
+  bool saveSerialized(const QByteArray& content, quint64 domHash,
+                      bool toOriginal);
 
   // Operator Overloadings
   SmartSExprFile& operator=(const SmartSExprFile& rhs) = delete;
@@ -136,6 +194,17 @@ private:  // Methods
    */
   SmartSExprFile(const FilePath& filepath, bool restore, bool readOnly,
                  bool create);
+
+private:  // Data
+  /**
+   * @brief Hash of the DOM tree last saved to #mFilePath (0 if unknown)
+   */
+  quint64 mOriginalDomHash;
+
+  /**
+   * @brief Hash of the DOM tree last saved to #mTmpFilePath (0 if unknown)
+   */
+  quint64 mTmpDomHash;
 };
 
 /*******************************************************************************
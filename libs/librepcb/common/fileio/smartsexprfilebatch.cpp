@@ -0,0 +1,92 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "smartsexprfilebatch.h"
+
+#include "smartsexprfile.h"
+
+#include <QtConcurrent/QtConcurrent>
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+SmartSExprFileBatch::SmartSExprFileBatch() noexcept {
+}
+
+SmartSExprFileBatch::~SmartSExprFileBatch() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void SmartSExprFileBatch::add(SmartSExprFile&    file,
+                              const SExpression& domDocument) noexcept {
+  mJobs.append(Job{&file, domDocument, 0, QByteArray(), QString()});
+}
+
+bool SmartSExprFileBatch::save(bool toOriginal, QStringList& errors) noexcept {
+  // serialize all DOM trees concurrently
+  QtConcurrent::blockingMap(mJobs, [toOriginal](Job& job) {
+    try {
+      job.domHash = job.document.calculateHash();
+      if (!job.file->isUpToDate(job.domHash, toOriginal)) {
+        job.content = job.file->serialize(job.document);  // can throw
+      }
+      job.document = SExpression();  // release memory as early as possible
+    } catch (const Exception& e) {
+      job.error = e.getMsg();
+    }
+  });
+
+  // write the files in a deterministic order
+  bool success = true;
+  for (Job& job : mJobs) {
+    try {
+      if (job.error.isEmpty()) {
+        job.file->saveSerialized(job.content, job.domHash,
+                                 toOriginal);  // can throw
+      }
+    } catch (const Exception& e) {
+      job.error = e.getMsg();
+    }
+    if (!job.error.isEmpty()) {
+      success = false;
+      errors.append(job.error);
+    }
+  }
+  mJobs.clear();
+  return success;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
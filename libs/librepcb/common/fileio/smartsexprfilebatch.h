@@ -0,0 +1,109 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_SMARTSEXPRFILEBATCH_H
+#define LIBREPCB_SMARTSEXPRFILEBATCH_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "sexpression.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class SmartSExprFile;
+
+/*******************************************************************************
+ *  Class SmartSExprFileBatch
+ ******************************************************************************/
+
+/**
+ * @brief Saves several S-Expressions files at once
+ *
+ * The DOM trees of all added files are serialized concurrently on the global
+ * thread pool into in-memory buffers, which is the expensive part of saving
+ * large documents. Afterwards the files are written sequentially in the order
+ * they were added, so the result is the same as saving them one after another
+ * with SmartSExprFile#save(). DOM trees which have not changed since they
+ * were last saved are not serialized at all.
+ *
+ * The DOM trees must be created in the calling thread before adding them,
+ * since the serialized objects are not thread-safe.
+ */
+class SmartSExprFileBatch final {
+public:
+  // Constructors / Destructor
+  SmartSExprFileBatch() noexcept;
+  SmartSExprFileBatch(const SmartSExprFileBatch& other) = delete;
+  ~SmartSExprFileBatch() noexcept;
+
+  // Getters
+  int getCount() const noexcept { return mJobs.count(); }
+
+  // General Methods
+
+  /**
+   * @brief Add a file to be saved by #save()
+   *
+   * @param file          The file to save. Must not be destroyed before
+   *                      #save() was called.
+   * @param domDocument   The DOM document to save into the file.
+   */
+  void add(SmartSExprFile& file, const SExpression& domDocument) noexcept;
+
+  /**
+   * @brief Serialize and write all added files, then clear the batch
+   *
+   * @param toOriginal    Specifies whether the original or the backup files
+   *                      should be overwritten/created.
+   * @param errors        Error messages of all failed files are appended to
+   *                      this list.
+   *
+   * @return True if all files were saved successfully, false otherwise.
+   */
+  bool save(bool toOriginal, QStringList& errors) noexcept;
+
+  // Operator Overloadings
+  SmartSExprFileBatch& operator=(const SmartSExprFileBatch& rhs) = delete;
+
+private:  // Types
+  struct Job {
+    SmartSExprFile* file;
+    SExpression     document;
+    quint64         domHash;  ///< See SExpression#calculateHash()
+    QByteArray      content;  ///< Null if the file is up to date
+    QString         error;  ///< Empty if serialization succeeded
+  };
+
+private:  // Data
+  QVector<Job> mJobs;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif  // LIBREPCB_SMARTSEXPRFILEBATCH_H
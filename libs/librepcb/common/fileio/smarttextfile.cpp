@@ -43,6 +43,7 @@ SmartTextFile::SmartTextFile(const FilePath& filepath, bool restore,
   } else {
     // read the content of the file
     mContent = FileUtils::readFile(mOpenedFilePath);
+    setOpenedFileContent(mContent);
   }
 }
 
@@ -54,8 +55,8 @@ SmartTextFile::~SmartTextFile() noexcept {
  ******************************************************************************/
 
 void SmartTextFile::save(bool toOriginal) {
-  const FilePath& filepath = prepareSaveAndReturnFilePath(toOriginal);
-  FileUtils::writeFile(filepath, mContent);
+  prepareSaveAndReturnFilePath(toOriginal);
+  writeContent(toOriginal, mContent);
   updateMembersAfterSaving(toOriginal);
 }
 
@@ -39,6 +39,9 @@ SmartVersionFile::SmartVersionFile(const FilePath& filepath, bool restore,
                                    bool readOnly)
   : SmartFile(filepath, restore, readOnly, false),
     mVersion(readVersionFromFile(mOpenedFilePath)) {
+  if (!mIsReadOnly) {
+    setOpenedFileContent(FileUtils::readFile(mOpenedFilePath));  // can throw
+  }
 }
 
 SmartVersionFile::SmartVersionFile(const FilePath& filepath,
@@ -54,9 +57,8 @@ SmartVersionFile::~SmartVersionFile() noexcept {
  ******************************************************************************/
 
 void SmartVersionFile::save(bool toOriginal) {
-  const FilePath& filepath = prepareSaveAndReturnFilePath(toOriginal);
-  FileUtils::writeFile(filepath,
-                       QString("%1\n").arg(mVersion.toStr()).toUtf8());
+  prepareSaveAndReturnFilePath(toOriginal);
+  writeContent(toOriginal, QString("%1\n").arg(mVersion.toStr()).toUtf8());
   updateMembersAfterSaving(toOriginal);
 }
 
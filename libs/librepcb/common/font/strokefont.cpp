@@ -42,14 +42,11 @@ namespace fb = fontobene;
  ******************************************************************************/
 
 StrokeFont::StrokeFont(const FilePath& fontFilePath) noexcept
-  : QObject(nullptr), mFilePath(fontFilePath) {
+  : mFilePath(fontFilePath) {
   // load the font in another thread because it takes some time to load it
   qDebug() << "Start loading font" << mFilePath.toNative();
   mFuture = QtConcurrent::run(
       [fontFilePath]() { return fb::Font(fontFilePath.toStr()); });
-  connect(&mWatcher, &QFutureWatcher<fb::Font>::finished, this,
-          &StrokeFont::fontLoaded);
-  mWatcher.setFuture(mFuture);
 }
 
 StrokeFont::~StrokeFont() noexcept {
@@ -153,22 +150,19 @@ QVector<Path> StrokeFont::strokeLine(const QString&        text,
   Length        offset = 0;
   width                = 0;  // same as offset, but without last letter spacing
   for (int i = 0; i < text.length(); ++i) {
-    Length        glyphSpacing;
-    QVector<Path> glyphPaths = strokeGlyph(text.at(i), height, glyphSpacing);
-    if (!glyphPaths.isEmpty()) {
-      Point bottomLeft, topRight;
-      computeBoundingRect(glyphPaths, bottomLeft, topRight);
-      Length shift =
-          (i == 0) ? -bottomLeft.getX() : 0;  // left-align first character
-      foreach (const Path& p, glyphPaths) {
+    Glyph glyph = getGlyph(text.at(i), height);
+    if (!glyph.paths.isEmpty()) {
+      Length shift = (i == 0) ? -glyph.bottomLeft.getX()
+                              : Length(0);  // left-align first character
+      foreach (const Path& p, glyph.paths) {
         paths.append(p.translated(Point(offset + shift, Length(0))));
       }
-      width = offset + topRight.getX() +
+      width = offset + glyph.topRight.getX() +
               shift;  // do *not* count glyph spacing as width!
-      offset = width + glyphSpacing + letterSpacing;
-    } else if (glyphSpacing != 0) {
+      offset = width + glyph.spacing + letterSpacing;
+    } else if (glyph.spacing != 0) {
       // it's a whitespace-only glyph -> count additional glyph spacing as width
-      width  = offset + glyphSpacing;
+      width  = offset + glyph.spacing;
       offset = width + letterSpacing;
     }
   }
@@ -178,29 +172,17 @@ QVector<Path> StrokeFont::strokeLine(const QString&        text,
 QVector<Path> StrokeFont::strokeGlyph(const QChar&          glyph,
                                       const PositiveLength& height,
                                       Length& spacing) const noexcept {
-  try {
-    qreal                 glyphSpacing = 0;
-    QVector<fb::Polyline> polylines =
-        accessor().getAllPolylinesOfGlyph(glyph.unicode(),
-                                          &glyphSpacing);  // can throw
-    spacing = convertLength(height, glyphSpacing);
-    return polylines2paths(polylines, height);
-  } catch (const fb::Exception& e) {
-    qWarning() << "Failed to load stroke font glyph" << glyph;
-    spacing = 0;
-    return QVector<Path>();
-  }
+  Glyph g = getGlyph(glyph, height);
+  spacing = g.spacing;
+  return g.paths;
 }
 
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
-void StrokeFont::fontLoaded() noexcept {
-  accessor();  // trigger the message about loading succeeded or failed
-}
-
-const fb::GlyphListAccessor& StrokeFont::accessor() const noexcept {
+void StrokeFont::load() const noexcept {
+  // Note: The caller must hold mMutex!
   if (!mFont) {
     try {
       mFont.reset(new fb::Font(mFuture.result()));  // can throw
@@ -222,9 +204,44 @@ const fb::GlyphListAccessor& StrokeFont::accessor() const noexcept {
 
     mGlyphListAccessor.reset(new fb::GlyphListAccessor(*mGlyphListCache));
   }
+}
+
+const fb::GlyphListAccessor& StrokeFont::accessor() const noexcept {
+  QMutexLocker locker(&mMutex);
+  load();
   return *mGlyphListAccessor;
 }
 
+StrokeFont::Glyph StrokeFont::getGlyph(const QChar&          glyph,
+                                       const PositiveLength& height) const
+    noexcept {
+  QMutexLocker              locker(&mMutex);
+  QPair<uint, LengthBase_t> key(glyph.unicode(), height->toNm());
+  auto                      it = mGlyphCache.constFind(key);
+  if (it != mGlyphCache.constEnd()) {
+    return *it;  // already converted
+  }
+
+  load();
+  Glyph g;
+  try {
+    qreal                 glyphSpacing = 0;
+    QVector<fb::Polyline> polylines =
+        mGlyphListAccessor->getAllPolylinesOfGlyph(glyph.unicode(),
+                                                   &glyphSpacing);  // can throw
+    g.paths   = polylines2paths(polylines, height);
+    g.spacing = convertLength(height, glyphSpacing);
+    if (!g.paths.isEmpty()) {
+      computeBoundingRect(g.paths, g.bottomLeft, g.topRight);
+    }
+  } catch (const fb::Exception& e) {
+    qWarning() << "Failed to load stroke font glyph" << glyph;
+    g = Glyph();
+  }
+  mGlyphCache.insert(key, g);
+  return g;
+}
+
 QVector<Path> StrokeFont::polylines2paths(
     const QVector<fb::Polyline>& polylines,
     const PositiveLength&        height) noexcept {
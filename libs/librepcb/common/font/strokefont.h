@@ -48,10 +48,17 @@ namespace librepcb {
 
 /**
  * @brief The StrokeFont class
+ *
+ * The font file is parsed in a background thread and the converted paths of
+ * each glyph are cached per height, so stroking a text only needs to translate
+ * the cached paths. All methods are thread-safe, thus a single instance can be
+ * shared by several projects (see librepcb::StrokeFontPool).
+ *
+ * @note This class is intentionally not a QObject, so instances are not bound
+ *       to the thread which created them and can be created and destroyed in
+ *       any thread.
  */
-class StrokeFont final : public QObject {
-  Q_OBJECT
-
+class StrokeFont final {
 public:
   // Constructors / Destructor
   StrokeFont(const FilePath& fontFilePath) noexcept;
@@ -79,9 +86,19 @@ public:
   // Operator Overloadings
   StrokeFont& operator=(const StrokeFont& rhs) = delete;
 
-private:
-  void                                fontLoaded() noexcept;
+private:  // Types
+  struct Glyph {
+    QVector<Path> paths;
+    Point         bottomLeft;  ///< Bounding rect of #paths
+    Point         topRight;    ///< Bounding rect of #paths
+    Length        spacing;
+  };
+
+private:  // Methods
+  void                                load() const noexcept;
   const fontobene::GlyphListAccessor& accessor() const noexcept;
+  Glyph getGlyph(const QChar& glyph, const PositiveLength& height) const
+      noexcept;
   static QVector<Path>                polylines2paths(
                      const QVector<fontobene::Polyline>& polylines,
                      const PositiveLength&               height) noexcept;
@@ -97,10 +114,11 @@ private:
 private:  // Data
   FilePath                                             mFilePath;
   QFuture<fontobene::Font>                             mFuture;
-  QFutureWatcher<fontobene::Font>                      mWatcher;
   mutable QScopedPointer<fontobene::Font>              mFont;
   mutable QScopedPointer<fontobene::GlyphListCache>    mGlyphListCache;
   mutable QScopedPointer<fontobene::GlyphListAccessor> mGlyphListAccessor;
+  mutable QHash<QPair<uint, LengthBase_t>, Glyph>      mGlyphCache;
+  mutable QMutex mMutex;  ///< Protects the lazy loading and #mGlyphCache
 };
 
 /*******************************************************************************
@@ -37,16 +37,10 @@ namespace librepcb {
 
 StrokeFontPool::StrokeFontPool(const FilePath& directory) noexcept {
   try {
+    // fonts are loaded lazily in getFont()
     foreach (const FilePath& fp,
              FileUtils::getFilesInDirectory(directory, {"*.bene"})) {
-      try {
-        qDebug() << "Load stroke font:" << fp.getFilename();
-        mFonts.insert(fp.getFilename(),
-                      std::make_shared<StrokeFont>(fp));  // can throw
-      } catch (const Exception& e) {
-        qCritical() << "Failed to load stroke font" << fp.toNative() << ":"
-                    << e.getMsg();
-      }
+      mFontFiles.insert(fp.getFilename(), fp);
     }
   } catch (const Exception& e) {
     qCritical() << "Failed to load stroke font pool:" << e.getMsg();
@@ -61,8 +55,13 @@ StrokeFontPool::~StrokeFontPool() noexcept {
  ******************************************************************************/
 
 const StrokeFont& StrokeFontPool::getFont(const QString& filename) const {
-  if (mFonts.contains(filename)) {
-    return *mFonts[filename];
+  QMutexLocker locker(&mMutex);
+  if (std::shared_ptr<StrokeFont> font = mFonts.value(filename)) {
+    return *font;
+  } else if (mFontFiles.contains(filename)) {
+    font = getSharedFont(mFontFiles.value(filename));
+    mFonts.insert(filename, font);
+    return *font;
   } else {
     throw RuntimeError(
         __FILE__, __LINE__,
@@ -71,6 +70,65 @@ const StrokeFont& StrokeFontPool::getFont(const QString& filename) const {
   }
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+std::shared_ptr<StrokeFont> StrokeFontPool::getSharedFont(
+    const FilePath& fp) noexcept {
+  // Fonts are identified by their content since projects contain copies of
+  // the application fonts. To avoid reading every font file, only files with
+  // the same name and size as an already loaded font are compared by their
+  // content. Only weak references are kept here, so fonts are released as
+  // soon as no pool uses them anymore.
+  static QMutex                                         mutex;
+  static QMultiHash<QPair<QString, qint64>, SharedFont> fonts;
+
+  QPair<QString, qint64> key(fp.getFilename(), QFileInfo(fp.toStr()).size());
+  QMutexLocker           locker(&mutex);
+  QByteArray             contentHash;
+  for (auto it = fonts.find(key); (it != fonts.end()) && (it.key() == key);
+       ++it) {
+    std::shared_ptr<StrokeFont> font = it->font.lock();
+    if (!font) continue;
+    if (contentHash.isEmpty()) {
+      contentHash = calculateContentHash(fp);
+    }
+    if (it->contentHash.isEmpty()) {
+      it->contentHash = calculateContentHash(it->filePath);
+    }
+    if ((!contentHash.isEmpty()) && (contentHash == it->contentHash)) {
+      return font;
+    }
+  }
+
+  // remove released fonts before registering a new one
+  for (auto it = fonts.begin(); it != fonts.end();) {
+    if (it->font.expired()) {
+      it = fonts.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  qDebug() << "Load stroke font:" << fp.getFilename();
+  std::shared_ptr<StrokeFont> font = std::make_shared<StrokeFont>(fp);
+  fonts.insert(key, SharedFont{fp, contentHash, font});
+  return font;
+}
+
+QByteArray StrokeFontPool::calculateContentHash(const FilePath& fp) noexcept {
+  try {
+    return QCryptographicHash::hash(FileUtils::readFile(fp),  // can throw
+                                    QCryptographicHash::Sha256);
+  } catch (const Exception& e) {
+    // the font will fail to load as well and report the error
+    qCritical() << "Failed to read stroke font" << fp.toNative() << ":"
+                << e.getMsg();
+    return QByteArray();
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
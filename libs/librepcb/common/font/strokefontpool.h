@@ -40,6 +40,12 @@ namespace librepcb {
 
 /**
  * @brief The StrokeFontPool class
+ *
+ * Provides all stroke fonts (*.bene files) of a directory. Fonts are only
+ * loaded when they are requested the first time. Loaded fonts are shared
+ * process-wide between all pools which contain a font file with the same
+ * content (e.g. the application fonts and the fonts copied into projects), so
+ * each font is parsed only once and its glyph cache is shared as well.
  */
 class StrokeFontPool final {
   Q_DECLARE_TR_FUNCTIONS(StrokeFontPool)
@@ -56,8 +62,21 @@ public:
   // Operator Overloadings
   StrokeFontPool& operator=(const StrokeFontPool& rhs) noexcept;
 
+private:  // Types
+  struct SharedFont {
+    FilePath                  filePath;
+    QByteArray                contentHash;  ///< Empty if not calculated yet
+    std::weak_ptr<StrokeFont> font;
+  };
+
+private:  // Methods
+  static std::shared_ptr<StrokeFont> getSharedFont(const FilePath& fp) noexcept;
+  static QByteArray calculateContentHash(const FilePath& fp) noexcept;
+
 private:  // Data
-  QHash<QString, std::shared_ptr<StrokeFont>> mFonts;
+  QHash<QString, FilePath>                            mFontFiles;
+  mutable QHash<QString, std::shared_ptr<StrokeFont>> mFonts;  ///< Loaded fonts
+  mutable QMutex                                      mMutex;  ///< For #mFonts
 };
 
 /*******************************************************************************
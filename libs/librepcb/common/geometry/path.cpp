@@ -40,7 +40,9 @@ Path::Path(const Path& other) noexcept
 }
 
 Path::Path(const SExpression& node) {
-  foreach (const SExpression& child, node.getChildren("vertex")) {
+  QVector<SExpression::Ref> vertices = node.getChildren("vertex");
+  mVertices.reserve(vertices.count());
+  foreach (const SExpression& child, vertices) {
     mVertices.append(Vertex(child));
   }
 }
@@ -0,0 +1,391 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_SPATIALINDEX_H
+#define LIBREPCB_SPATIALINDEX_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+#include <QtGui>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class SpatialIndex
+ ******************************************************************************/
+
+/**
+ * @brief An R-tree of the scene bounding rectangles of graphical items
+ *
+ * This index allows to find all items at a scene position or within a scene
+ * rectangle in logarithmic time instead of testing every single item. The
+ * result is only a superset of the hit items, it is based on the bounding
+ * rectangles of the grab areas. The caller still needs to test the exact grab
+ * area of each returned item.
+ *
+ * The bounding rectangles are updated lazily: Items only need to be marked
+ * with #update() whenever their grab area might have changed (which is very
+ * cheap), and their new bounding rectangles are determined at the next query.
+ * So moving many items at once does not cause any overhead if there is no
+ * query in between.
+ *
+ * The tree is a classic R-tree with quadratic node splitting. Removed entries
+ * of underfull nodes get re-inserted to keep the tree balanced.
+ *
+ * @tparam T  The type of the indexed items. It must provide the method
+ *            `QPainterPath getGrabAreaScenePx() const noexcept`.
+ */
+template <typename T>
+class SpatialIndex final {
+public:
+  // Constructors / Destructor
+  SpatialIndex() noexcept : mRoot(new Node{true, {}}) {}
+  SpatialIndex(const SpatialIndex& other) = delete;
+  ~SpatialIndex() noexcept {}
+
+  // Getters
+  int  getCount() const noexcept { return mRects.count() + mNewItems.count(); }
+  bool contains(T& item) const noexcept {
+    return mRects.contains(&item) || mNewItems.contains(&item);
+  }
+
+  // General Methods
+
+  /**
+   * @brief Add an item to the index
+   *
+   * @param item  The item to add. Must not be destroyed before it is removed
+   *              from the index again.
+   */
+  void insert(T& item) noexcept {
+    if (!mRects.contains(&item)) mNewItems.insert(&item);
+  }
+
+  /**
+   * @brief Mark the grab area of an item as modified
+   *
+   * @param item  The modified item. If it is not contained in the index,
+   *              this call is ignored.
+   */
+  void update(T& item) noexcept {
+    if (mRects.contains(&item)) mModifiedItems.insert(&item);
+  }
+
+  /**
+   * @brief Remove an item from the index
+   *
+   * @param item  The item to remove. If it is not contained in the index,
+   *              this call is ignored.
+   */
+  void remove(T& item) noexcept {
+    mNewItems.remove(&item);
+    mModifiedItems.remove(&item);
+    auto it = mRects.find(&item);
+    if (it != mRects.end()) {
+      removeFromTree(&item, it.value());
+      mRects.erase(it);
+    }
+  }
+
+  void clear() noexcept {
+    mRoot.reset(new Node{true, {}});
+    mRects.clear();
+    mNewItems.clear();
+    mModifiedItems.clear();
+  }
+
+  /**
+   * @brief Find all items whose bounding rectangle contains a scene position
+   *
+   * @param pos   The scene position [px].
+   *
+   * @return All candidate items (unordered).
+   */
+  QVector<T*> find(const QPointF& pos) noexcept {
+    return find(QRectF(pos, QSizeF(0, 0)));
+  }
+
+  /**
+   * @brief Find all items whose bounding rectangle intersects a scene
+   *        rectangle
+   *
+   * @param rect  The scene rectangle [px].
+   *
+   * @return All candidate items (unordered).
+   */
+  QVector<T*> find(const QRectF& rect) noexcept {
+    flush();
+    QVector<T*> items;
+    find(*mRoot, rect.normalized(), items);
+    return items;
+  }
+
+  // Operator Overloadings
+  SpatialIndex& operator=(const SpatialIndex& rhs) = delete;
+
+private:  // Types
+  struct Node;
+
+  struct Entry {
+    QRectF                rect;
+    std::unique_ptr<Node> child;  ///< Only set in inner nodes
+    T*                    item;   ///< Only set in leaf nodes
+  };
+
+  struct Node {
+    bool               leaf;
+    std::vector<Entry> entries;
+  };
+
+private:  // Methods
+  void flush() noexcept {
+    foreach (T* item, mModifiedItems) {
+      QRectF& rect = mRects[item];
+      removeFromTree(item, rect);
+      rect = item->getGrabAreaScenePx().boundingRect();
+      insertIntoTree(item, rect);
+    }
+    mModifiedItems.clear();
+    foreach (T* item, mNewItems) {
+      QRectF rect = item->getGrabAreaScenePx().boundingRect();
+      mRects.insert(item, rect);
+      insertIntoTree(item, rect);
+    }
+    mNewItems.clear();
+  }
+
+  void find(const Node& node, const QRectF& rect, QVector<T*>& items) const
+      noexcept {
+    for (const Entry& entry : node.entries) {
+      if (intersects(entry.rect, rect)) {
+        if (node.leaf) {
+          items.append(entry.item);
+        } else {
+          find(*entry.child, rect, items);
+        }
+      }
+    }
+  }
+
+  void insertIntoTree(T* item, const QRectF& rect) noexcept {
+    std::unique_ptr<Node> sibling = insert(*mRoot, item, rect);
+    if (sibling) {
+      // the root node was split, so the tree grows by one level
+      std::unique_ptr<Node> root(new Node{false, {}});
+      QRectF                rootRect = bounds(*mRoot);
+      QRectF                siblingRect = bounds(*sibling);
+      root->entries.push_back(Entry{rootRect, std::move(mRoot), nullptr});
+      root->entries.push_back(Entry{siblingRect, std::move(sibling), nullptr});
+      mRoot = std::move(root);
+    }
+  }
+
+  std::unique_ptr<Node> insert(Node& node, T* item,
+                               const QRectF& rect) noexcept {
+    if (node.leaf) {
+      node.entries.push_back(Entry{rect, nullptr, item});
+    } else {
+      Entry&                entry   = chooseSubtree(node, rect);
+      std::unique_ptr<Node> sibling = insert(*entry.child, item, rect);
+      entry.rect = sibling ? bounds(*entry.child) : united(entry.rect, rect);
+      if (sibling) {
+        QRectF siblingRect = bounds(*sibling);
+        node.entries.push_back(Entry{siblingRect, std::move(sibling), nullptr});
+      }
+    }
+    if (node.entries.size() > sMaxEntries) {
+      return split(node);
+    } else {
+      return nullptr;
+    }
+  }
+
+  void removeFromTree(T* item, const QRectF& rect) noexcept {
+    std::vector<T*> orphans;
+    remove(*mRoot, item, rect, orphans);
+    // shrink the tree if the root has only one child left
+    while ((!mRoot->leaf) && (mRoot->entries.size() == 1)) {
+      std::unique_ptr<Node> child = std::move(mRoot->entries.front().child);
+      mRoot                       = std::move(child);
+    }
+    if ((!mRoot->leaf) && mRoot->entries.empty()) {
+      mRoot.reset(new Node{true, {}});
+    }
+    // re-insert all items of removed underfull nodes
+    for (T* orphan : orphans) {
+      insertIntoTree(orphan, mRects.value(orphan));
+    }
+  }
+
+  bool remove(Node& node, T* item, const QRectF& rect,
+              std::vector<T*>& orphans) noexcept {
+    for (auto it = node.entries.begin(); it != node.entries.end(); ++it) {
+      if (node.leaf) {
+        if (it->item == item) {
+          node.entries.erase(it);
+          return true;
+        }
+      } else if (intersects(it->rect, rect) &&
+                 remove(*it->child, item, rect, orphans)) {
+        if (it->child->entries.size() < sMinEntries) {
+          collectItems(*it->child, orphans);
+          node.entries.erase(it);
+        } else {
+          it->rect = bounds(*it->child);
+        }
+        return true;
+      }
+    }
+    return false;
+  }
+
+  static void collectItems(const Node& node, std::vector<T*>& items) noexcept {
+    for (const Entry& entry : node.entries) {
+      if (node.leaf) {
+        items.push_back(entry.item);
+      } else {
+        collectItems(*entry.child, items);
+      }
+    }
+  }
+
+  static Entry& chooseSubtree(Node& node, const QRectF& rect) noexcept {
+    // choose the entry which needs the least enlargement, resolve ties by
+    // choosing the entry with the smallest area
+    Entry* best            = &node.entries.front();
+    qreal  bestEnlargement = enlargement(best->rect, rect);
+    for (Entry& entry : node.entries) {
+      qreal e = enlargement(entry.rect, rect);
+      if ((e < bestEnlargement) ||
+          ((e == bestEnlargement) && (area(entry.rect) < area(best->rect)))) {
+        best            = &entry;
+        bestEnlargement = e;
+      }
+    }
+    return *best;
+  }
+
+  static std::unique_ptr<Node> split(Node& node) noexcept {
+    std::vector<Entry> entries = std::move(node.entries);
+    node.entries.clear();
+
+    // pick the two entries which would waste the most area in the same node
+    std::size_t seed1 = 0, seed2 = 1;
+    qreal       worstWaste = -1;
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+      for (std::size_t k = i + 1; k < entries.size(); ++k) {
+        qreal waste = area(united(entries[i].rect, entries[k].rect)) -
+                      area(entries[i].rect) - area(entries[k].rect);
+        if (waste > worstWaste) {
+          worstWaste = waste;
+          seed1      = i;
+          seed2      = k;
+        }
+      }
+    }
+
+    // distribute all other entries to the group which needs less enlargement,
+    // but make sure both groups get the minimum number of entries
+    std::unique_ptr<Node> sibling(new Node{node.leaf, {}});
+    QRectF                rect1 = entries[seed1].rect;
+    QRectF                rect2 = entries[seed2].rect;
+    node.entries.push_back(std::move(entries[seed1]));
+    sibling->entries.push_back(std::move(entries[seed2]));
+    std::size_t remaining = entries.size() - 2;
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+      if ((i == seed1) || (i == seed2)) continue;
+      bool toFirst;
+      if (node.entries.size() + remaining <= sMinEntries) {
+        toFirst = true;
+      } else if (sibling->entries.size() + remaining <= sMinEntries) {
+        toFirst = false;
+      } else {
+        qreal e1 = enlargement(rect1, entries[i].rect);
+        qreal e2 = enlargement(rect2, entries[i].rect);
+        toFirst  = (e1 < e2) || ((e1 == e2) && (area(rect1) <= area(rect2)));
+      }
+      if (toFirst) {
+        rect1 = united(rect1, entries[i].rect);
+        node.entries.push_back(std::move(entries[i]));
+      } else {
+        rect2 = united(rect2, entries[i].rect);
+        sibling->entries.push_back(std::move(entries[i]));
+      }
+      --remaining;
+    }
+    return sibling;
+  }
+
+  static QRectF bounds(const Node& node) noexcept {
+    QRectF rect = node.entries.front().rect;
+    for (const Entry& entry : node.entries) {
+      rect = united(rect, entry.rect);
+    }
+    return rect;
+  }
+
+  // Note: QRectF::united() and QRectF::intersects() ignore rectangles with
+  // zero width or height, but points and straight lines are valid here.
+
+  static QRectF united(const QRectF& a, const QRectF& b) noexcept {
+    return QRectF(QPointF(std::min(a.left(), b.left()),
+                          std::min(a.top(), b.top())),
+                  QPointF(std::max(a.right(), b.right()),
+                          std::max(a.bottom(), b.bottom())));
+  }
+
+  static bool intersects(const QRectF& a, const QRectF& b) noexcept {
+    return (a.left() <= b.right()) && (b.left() <= a.right()) &&
+           (a.top() <= b.bottom()) && (b.top() <= a.bottom());
+  }
+
+  static qreal area(const QRectF& rect) noexcept {
+    return rect.width() * rect.height();
+  }
+
+  static qreal enlargement(const QRectF& rect, const QRectF& add) noexcept {
+    return area(united(rect, add)) - area(rect);
+  }
+
+private:  // Data
+  std::unique_ptr<Node> mRoot;
+  QHash<T*, QRectF>     mRects;          ///< Bounding rects of indexed items
+  QSet<T*>              mNewItems;       ///< Not yet indexed items
+  QSet<T*>              mModifiedItems;  ///< Indexed items with outdated rect
+
+  static constexpr std::size_t sMaxEntries = 16;
+  static constexpr std::size_t sMinEntries = 6;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif  // LIBREPCB_SPATIALINDEX_H
@@ -49,9 +49,10 @@ LibraryCategory::LibraryCategory(const QString& shortElementName,
 
 LibraryCategory::LibraryCategory(const FilePath& elementDirectory,
                                  const QString&  shortElementName,
-                                 const QString& longElementName, bool readOnly)
+                                 const QString& longElementName, bool readOnly,
+                                 bool metadataOnly)
   : LibraryBaseElement(elementDirectory, true, shortElementName,
-                       longElementName, readOnly),
+                       longElementName, readOnly, metadataOnly),
     mParentUuid(
         mLoadingFileDocument.getValueByPath<tl::optional<Uuid>>("parent")) {
 }
@@ -56,7 +56,8 @@ public:
                   const QString&     keywords_en_US);
   LibraryCategory(const FilePath& elementDirectory,
                   const QString&  shortElementName,
-                  const QString& longElementName, bool readOnly);
+                  const QString& longElementName, bool readOnly,
+                  bool metadataOnly = false);
   virtual ~LibraryCategory() noexcept;
 
   // Getters: Attributes
@@ -48,9 +48,10 @@ Device::Device(const Uuid& uuid, const Version& version, const QString& author,
     mPadSignalMap() {
 }
 
-Device::Device(const FilePath& elementDirectory, bool readOnly)
+Device::Device(const FilePath& elementDirectory, bool readOnly,
+               bool metadataOnly)
   : LibraryElement(elementDirectory, getShortElementName(),
-                   getLongElementName(), readOnly),
+                   getLongElementName(), readOnly, metadataOnly),
     mComponentUuid(mLoadingFileDocument.getValueByPath<Uuid>("component")),
     mPackageUuid(mLoadingFileDocument.getValueByPath<Uuid>("package")),
     mAttributes(mLoadingFileDocument),
@@ -62,7 +62,8 @@ public:
          const ElementName& name_en_US, const QString& description_en_US,
          const QString& keywords_en_US, const Uuid& component,
          const Uuid& package);
-  Device(const FilePath& elementDirectory, bool readOnly);
+  Device(const FilePath& elementDirectory, bool readOnly,
+         bool metadataOnly = false);
   ~Device() noexcept;
 
   // Getters
@@ -51,6 +51,7 @@ LibraryBaseElement::LibraryBaseElement(
     mDirectory(FilePath::getRandomTempPath()),
     mDirectoryIsTemporary(true),
     mOpenedReadOnly(false),
+    mMetadataOnly(false),
     mDirectoryNameMustBeUuid(dirnameMustBeUuid),
     mShortElementName(shortElementName),
     mLongElementName(longElementName),
@@ -69,11 +70,12 @@ LibraryBaseElement::LibraryBaseElement(const FilePath& elementDirectory,
                                        bool            dirnameMustBeUuid,
                                        const QString&  shortElementName,
                                        const QString&  longElementName,
-                                       bool            readOnly)
+                                       bool readOnly, bool metadataOnly)
   : QObject(nullptr),
     mDirectory(elementDirectory),
     mDirectoryIsTemporary(false),
-    mOpenedReadOnly(readOnly),
+    mOpenedReadOnly(readOnly || metadataOnly),
+    mMetadataOnly(metadataOnly),
     mDirectoryNameMustBeUuid(dirnameMustBeUuid),
     mShortElementName(shortElementName),
     mLongElementName(longElementName),
@@ -120,7 +122,8 @@ LibraryBaseElement::LibraryBaseElement(const FilePath& elementDirectory,
   // open main file
   FilePath       sexprFilePath = mDirectory.getPathTo(mLongElementName % ".lp");
   SmartSExprFile sexprFile(sexprFilePath, false, true);
-  mLoadingFileDocument = sexprFile.parseFileAndBuildDomTree();
+  mLoadingFileDocument = sexprFile.parseFileAndBuildDomTree(
+      metadataOnly ? getNonMetadataListNames() : QSet<QString>());
 
   // read attributes
   if (mLoadingFileDocument.getChildByIndex(0).isString()) {
@@ -224,6 +227,22 @@ void LibraryBaseElement::moveIntoParentDirectory(const FilePath& parentDir) {
   moveTo(elemDir);
 }
 
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+const QSet<QString>& LibraryBaseElement::getNonMetadataListNames() noexcept {
+  // Lists which contain the geometry or other content of library elements,
+  // but never any metadata. Note that only the metadata of the base classes
+  // (LibraryBaseElement, LibraryElement, LibraryCategory) and the foreign keys
+  // of devices are guaranteed to be loaded in the metadata-only mode.
+  static const QSet<QString> names = {
+      "attribute", "circle", "ellipse", "footprint", "hole",    "pad",
+      "pin",       "polygon", "signal", "text",      "variant",
+  };
+  return names;
+}
+
 /*******************************************************************************
  *  Protected Methods
  ******************************************************************************/
@@ -234,6 +253,11 @@ void LibraryBaseElement::cleanupAfterLoadingElementFromFile() noexcept {
 
 void LibraryBaseElement::copyTo(const FilePath& destination,
                                 bool            removeSource) {
+  if (mMetadataOnly) {
+    // the element is not loaded completely, so saving it would lose data
+    throw LogicError(__FILE__, __LINE__);
+  }
+
   if (destination != mDirectory) {
     // check destination directory name validity
     if (mDirectoryNameMustBeUuid &&
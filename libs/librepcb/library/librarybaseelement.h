@@ -62,9 +62,28 @@ public:
                      const ElementName& name_en_US,
                      const QString&     description_en_US,
                      const QString&     keywords_en_US);
+
+  /**
+   * @brief Constructor to open an existing library element
+   *
+   * @param elementDirectory    The directory of the element to open.
+   * @param dirnameMustBeUuid   Whether the directory name must be the UUID.
+   * @param shortElementName    The short element name, e.g. "sym".
+   * @param longElementName     The long element name, e.g. "symbol".
+   * @param readOnly            Whether the element is opened read-only.
+   * @param metadataOnly        If true, only the metadata of the element is
+   *                            read (UUID, version, names, categories etc.)
+   *                            and all subtrees listed in
+   *                            #getNonMetadataListNames() are skipped while
+   *                            parsing. Much faster for scanning libraries,
+   *                            but the element is then always read-only.
+   *
+   * @throw Exception If the element could not be opened.
+   */
   LibraryBaseElement(const FilePath& elementDirectory, bool dirnameMustBeUuid,
                      const QString& shortElementName,
-                     const QString& longElementName, bool readOnly);
+                     const QString& longElementName, bool readOnly,
+                     bool metadataOnly = false);
   virtual ~LibraryBaseElement() noexcept;
 
   // Getters: General
@@ -76,6 +95,7 @@ public:
     return mLongElementName;
   }
   bool isOpenedReadOnly() const noexcept { return mOpenedReadOnly; }
+  bool isMetadataOnly() const noexcept { return mMetadataOnly; }
 
   // Getters: Attributes
   const Uuid&      getUuid() const noexcept { return mUuid; }
@@ -114,6 +134,7 @@ public:
   LibraryBaseElement& operator=(const LibraryBaseElement& rhs) = delete;
 
   // Static Methods
+  static const QSet<QString>& getNonMetadataListNames() noexcept;
   template <typename ElementType>
   static bool isValidElementDirectory(const FilePath& dir) noexcept {
     return dir.getPathTo(".librepcb-" % ElementType::getShortElementName())
@@ -132,6 +153,7 @@ protected:
   mutable FilePath mDirectory;
   mutable bool     mDirectoryIsTemporary;
   bool             mOpenedReadOnly;
+  bool             mMetadataOnly;
   bool             mDirectoryNameMustBeUuid;
   QString          mShortElementName;  ///< e.g. "lib", "cmpcat", "sym"
   QString mLongElementName;  ///< e.g. "library", "component_category", "symbol"
@@ -51,9 +51,10 @@ LibraryElement::LibraryElement(const QString& shortElementName,
 
 LibraryElement::LibraryElement(const FilePath& elementDirectory,
                                const QString&  shortElementName,
-                               const QString& longElementName, bool readOnly)
+                               const QString& longElementName, bool readOnly,
+                               bool metadataOnly)
   : LibraryBaseElement(elementDirectory, true, shortElementName,
-                       longElementName, readOnly) {
+                       longElementName, readOnly, metadataOnly) {
   // read category UUIDs
   foreach (const SExpression& node,
            mLoadingFileDocument.getChildren("category")) {
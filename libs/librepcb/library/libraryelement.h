@@ -57,7 +57,8 @@ public:
                  const QString&     keywords_en_US);
   LibraryElement(const FilePath& elementDirectory,
                  const QString&  shortElementName,
-                 const QString& longElementName, bool readOnly);
+                 const QString& longElementName, bool readOnly,
+                 bool metadataOnly = false);
   virtual ~LibraryElement() noexcept;
 
   // Getters: Attributes
@@ -30,6 +30,7 @@
 #include "boardairwiresbuilder.h"
 #include "boardfabricationoutputsettings.h"
 #include "boardlayerstack.h"
+#include "boardplanesrebuilder.h"
 #include "boardselectionquery.h"
 #include "boardusersettings.h"
 #include "items/bi_airwire.h"
@@ -49,6 +50,7 @@
 #include <librepcb/common/boarddesignrules.h>
 #include <librepcb/common/fileio/sexpression.h>
 #include <librepcb/common/fileio/smartsexprfile.h>
+#include <librepcb/common/fileio/smartsexprfilebatch.h>
 #include <librepcb/common/geometry/polygon.h>
 #include <librepcb/common/graphics/graphicsscene.h>
 #include <librepcb/common/graphics/graphicsview.h>
@@ -60,6 +62,8 @@
 #include <QtCore>
 #include <QtWidgets>
 
+#include <algorithm>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -81,6 +85,7 @@ Board::Board(const Board& other, const FilePath& filepath,
     mDefaultFontFileName(other.mDefaultFontFileName) {
   try {
     mGraphicsScene.reset(new GraphicsScene());
+    mPlanesRebuilder.reset(new BoardPlanesRebuilder(*this));
 
     // copy the other board
     mFile.reset(SmartSExprFile::create(mFilePath));
@@ -180,6 +185,7 @@ Board::Board(const Board& other, const FilePath& filepath,
     mGridProperties.reset();
     mLayerStack.reset();
     mFile.reset();
+    mPlanesRebuilder.reset();
     mGraphicsScene.reset();
     throw;  // ...and rethrow the exception
   }
@@ -195,6 +201,7 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
     mName("New Board") {
   try {
     mGraphicsScene.reset(new GraphicsScene());
+    mPlanesRebuilder.reset(new BoardPlanesRebuilder(*this));
 
     // try to open/create the board file
     if (create) {
@@ -379,6 +386,7 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
     mGridProperties.reset();
     mLayerStack.reset();
     mFile.reset();
+    mPlanesRebuilder.reset();
     mGraphicsScene.reset();
     throw;  // ...and rethrow the exception
   }
@@ -387,6 +395,8 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
 Board::~Board() noexcept {
   Q_ASSERT(!mIsAddedToProject);
 
+  mPlanesRebuilder.reset();  // cancel running plane rebuilds
+
   qDeleteAll(mErcMsgListUnplacedComponentInstances);
   mErcMsgListUnplacedComponentInstances.clear();
 
@@ -426,26 +436,48 @@ bool Board::isEmpty() const noexcept {
 }
 
 QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept {
-  QPointF scenePosPx = pos.toPxQPointF();
+  QPointF           scenePosPx = pos.toPxQPointF();
+  QVector<BI_Base*> items      = getSelectableItemsAtScenePos(scenePosPx);
+  QSet<BI_Base*>    hits;
+  QMap<Uuid, BI_Device*> devices;  // sorted like mDeviceInstances
+  foreach (BI_Base* item, items) {
+    hits.insert(item);
+    if (item->getType() == BI_Base::Type_t::Footprint) {
+      BI_Device& device = static_cast<BI_Footprint*>(item)->getDeviceInstance();
+      devices.insert(device.getComponentInstanceUuid(), &device);
+    } else if (item->getType() == BI_Base::Type_t::FootprintPad) {
+      BI_Device& device = static_cast<BI_FootprintPad*>(item)
+                              ->getFootprint()
+                              .getDeviceInstance();
+      devices.insert(device.getComponentInstanceUuid(), &device);
+    } else if (item->getType() == BI_Base::Type_t::StrokeText) {
+      BI_StrokeText* text = static_cast<BI_StrokeText*>(item);
+      if (BI_Footprint* footprint = text->getFootprint()) {
+        BI_Device& device = footprint->getDeviceInstance();
+        devices.insert(device.getComponentInstanceUuid(), &device);
+      }
+    }
+  }
+
   QList<BI_Base*>
       list;  // Note: The order of adding the items is very important (the
              // top most item must appear as the first item in the list)!
   // vias
-  foreach (BI_Via* via, getViasAtScenePos(pos, nullptr)) { list.append(via); }
+  foreach (BI_Base* item, items) {
+    if (item->getType() == BI_Base::Type_t::Via) list.append(item);
+  }
   // netpoints
-  foreach (BI_NetPoint* netpoint,
-           getNetPointsAtScenePos(pos, nullptr, nullptr)) {
-    list.append(netpoint);
+  foreach (BI_Base* item, items) {
+    if (item->getType() == BI_Base::Type_t::NetPoint) list.append(item);
   }
   // netlines
-  foreach (BI_NetLine* netline, getNetLinesAtScenePos(pos, nullptr, nullptr)) {
-    list.append(netline);
+  foreach (BI_Base* item, items) {
+    if (item->getType() == BI_Base::Type_t::NetLine) list.append(item);
   }
   // footprints & pads
-  foreach (BI_Device* device, mDeviceInstances) {
+  foreach (BI_Device* device, devices) {
     BI_Footprint& footprint = device->getFootprint();
-    if (footprint.isSelectable() &&
-        footprint.getGrabAreaScenePx().contains(scenePosPx)) {
+    if (hits.contains(&footprint)) {
       if (footprint.getIsMirrored()) {
         list.append(&footprint);
       } else {
@@ -453,8 +485,7 @@ QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept {
       }
     }
     foreach (BI_FootprintPad* pad, footprint.getPads()) {
-      if (pad->isSelectable() &&
-          pad->getGrabAreaScenePx().contains(scenePosPx)) {
+      if (hits.contains(pad)) {
         if (pad->getIsMirrored()) {
           list.append(pad);
         } else {
@@ -463,8 +494,7 @@ QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept {
       }
     }
     foreach (BI_StrokeText* text, device->getFootprint().getStrokeTexts()) {
-      if (text->isSelectable() &&
-          text->getGrabAreaScenePx().contains(scenePosPx)) {
+      if (hits.contains(text)) {
         if (GraphicsLayer::isTopLayer(*text->getText().getLayerName())) {
           list.prepend(text);
         } else {
@@ -474,11 +504,8 @@ QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept {
     }
   }
   // planes
-  foreach (BI_Plane* planes, mPlanes) {
-    if (planes->isSelectable() &&
-        planes->getGrabAreaScenePx().contains(scenePosPx)) {
-      list.append(planes);
-    }
+  foreach (BI_Base* item, items) {
+    if (item->getType() == BI_Base::Type_t::Plane) list.append(item);
   }
   // polygons
   foreach (BI_Polygon* polygon, mPolygons) {
@@ -488,10 +515,10 @@ QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept {
     }
   }
   // texts
-  foreach (BI_StrokeText* text, mStrokeTexts) {
-    if (text->isSelectable() &&
-        text->getGrabAreaScenePx().contains(scenePosPx)) {
-      list.append(text);
+  foreach (BI_Base* item, items) {
+    if ((item->getType() == BI_Base::Type_t::StrokeText) &&
+        (!static_cast<BI_StrokeText*>(item)->getFootprint())) {
+      list.append(item);
     }
   }
   // holes
@@ -508,9 +535,13 @@ QList<BI_Via*> Board::getViasAtScenePos(const Point&     pos,
                                         const NetSignal* netsignal) const
     noexcept {
   QList<BI_Via*> list;
-  foreach (BI_NetSegment* segment, mNetSegments) {
-    if ((!netsignal) || (&segment->getNetSignal() == netsignal)) {
-      segment->getViasAtScenePos(pos, list);
+  foreach (BI_Base* item, getSelectableItemsAtScenePos(pos.toPxQPointF())) {
+    if (item->getType() == BI_Base::Type_t::Via) {
+      BI_Via* via = static_cast<BI_Via*>(item);
+      if ((!netsignal) ||
+          (&via->getNetSegment().getNetSignal() == netsignal)) {
+        list.append(via);
+      }
     }
   }
   return list;
@@ -520,9 +551,14 @@ QList<BI_NetPoint*> Board::getNetPointsAtScenePos(
     const Point& pos, const GraphicsLayer* layer,
     const NetSignal* netsignal) const noexcept {
   QList<BI_NetPoint*> list;
-  foreach (BI_NetSegment* segment, mNetSegments) {
-    if ((!netsignal) || (&segment->getNetSignal() == netsignal)) {
-      segment->getNetPointsAtScenePos(pos, layer, list);
+  foreach (BI_Base* item, getSelectableItemsAtScenePos(pos.toPxQPointF())) {
+    if (item->getType() == BI_Base::Type_t::NetPoint) {
+      BI_NetPoint* netpoint = static_cast<BI_NetPoint*>(item);
+      if (((!layer) || (netpoint->getLayerOfLines() == layer)) &&
+          ((!netsignal) ||
+           (&netpoint->getNetSegment().getNetSignal() == netsignal))) {
+        list.append(netpoint);
+      }
     }
   }
   return list;
@@ -532,9 +568,14 @@ QList<BI_NetLine*> Board::getNetLinesAtScenePos(
     const Point& pos, const GraphicsLayer* layer,
     const NetSignal* netsignal) const noexcept {
   QList<BI_NetLine*> list;
-  foreach (BI_NetSegment* segment, mNetSegments) {
-    if ((!netsignal) || (&segment->getNetSignal() == netsignal)) {
-      segment->getNetLinesAtScenePos(pos, layer, list);
+  foreach (BI_Base* item, getSelectableItemsAtScenePos(pos.toPxQPointF())) {
+    if (item->getType() == BI_Base::Type_t::NetLine) {
+      BI_NetLine* netline = static_cast<BI_NetLine*>(item);
+      if (((!layer) || (&netline->getLayer() == layer)) &&
+          ((!netsignal) ||
+           (&netline->getNetSegment().getNetSignal() == netsignal))) {
+        list.append(netline);
+      }
     }
   }
   return list;
@@ -544,11 +585,10 @@ QList<BI_FootprintPad*> Board::getPadsAtScenePos(
     const Point& pos, const GraphicsLayer* layer,
     const NetSignal* netsignal) const noexcept {
   QList<BI_FootprintPad*> list;
-  foreach (BI_Device* device, mDeviceInstances) {
-    foreach (BI_FootprintPad* pad, device->getFootprint().getPads()) {
-      if (pad->isSelectable() &&
-          pad->getGrabAreaScenePx().contains(pos.toPxQPointF()) &&
-          ((!layer) || (pad->isOnLayer(layer->getName()))) &&
+  foreach (BI_Base* item, getSelectableItemsAtScenePos(pos.toPxQPointF())) {
+    if (item->getType() == BI_Base::Type_t::FootprintPad) {
+      BI_FootprintPad* pad = static_cast<BI_FootprintPad*>(item);
+      if (((!layer) || (pad->isOnLayer(layer->getName()))) &&
           ((!netsignal) || (pad->getCompSigInstNetSignal() == netsignal))) {
         list.append(pad);
       }
@@ -684,12 +724,11 @@ void Board::removePlane(BI_Plane& plane) {
 }
 
 void Board::rebuildAllPlanes() noexcept {
-  QList<BI_Plane*> planes = mPlanes;
-  qSort(planes.begin(), planes.end(),
-        [](const BI_Plane* p1, const BI_Plane* p2) {
-          return !(*p1 < *p2);
-        });  // sort by priority (highest priority first)
-  foreach (BI_Plane* plane, planes) { plane->rebuild(); }
+  mPlanesRebuilder->rebuild();
+}
+
+void Board::rebuildAllPlanesInBackground() noexcept {
+  mPlanesRebuilder->startRebuild();
 }
 
 /*******************************************************************************
@@ -765,25 +804,41 @@ void Board::triggerAirWiresRebuild() noexcept {
   }
 
   try {
+    // remove old airwires and take a snapshot of all nets to rebuild
+    QVector<NetSignal*>                   netsignals;
+    QVector<BoardAirWiresGraph::Snapshot> snapshots;
     foreach (NetSignal* netsignal, mScheduledNetSignalsForAirWireRebuild) {
-      // remove old airwires
       while (BI_AirWire* airWire = mAirWires.take(netsignal)) {
         airWire->removeFromBoard();  // can throw
         delete airWire;
       }
 
       if (netsignal && netsignal->isAddedToCircuit()) {
-        // calculate new airwires
-        BoardAirWiresBuilder         builder(*this, *netsignal);
-        QVector<QPair<Point, Point>> airwires = builder.buildAirWires();
-
-        // add new airwires
-        foreach (const auto& points, airwires) {
-          QScopedPointer<BI_AirWire> airWire(
-              new BI_AirWire(*this, *netsignal, points.first, points.second));
-          airWire->addToBoard();  // can throw
-          mAirWires.insertMulti(netsignal, airWire.take());
-        }
+        BoardAirWiresBuilder builder(*this, *netsignal);
+        netsignals.append(netsignal);
+        snapshots.append(builder.buildSnapshot());
+        mAirWiresGraphs[netsignal];  // make sure the graph exists
+      } else {
+        mAirWiresGraphs.remove(netsignal);
+      }
+    }
+
+    // calculate new airwires of all (independent) nets concurrently
+    QVector<BoardAirWiresGraph*> graphs;
+    foreach (NetSignal* netsignal, netsignals) {
+      graphs.append(&mAirWiresGraphs[netsignal]);
+    }
+    QVector<BoardAirWiresGraph::AirWires> airwires =
+        BoardAirWiresGraph::updateConcurrently(graphs, snapshots);
+
+    // add new airwires
+    for (int i = 0; i < netsignals.count(); ++i) {
+      NetSignal* netsignal = netsignals.at(i);
+      foreach (const auto& points, airwires.at(i)) {
+        QScopedPointer<BI_AirWire> airWire(
+            new BI_AirWire(*this, *netsignal, points.first, points.second));
+        airWire->addToBoard();  // can throw
+        mAirWires.insertMulti(netsignal, airWire.take());
       }
     }
     mScheduledNetSignalsForAirWireRebuild.clear();
@@ -837,14 +892,14 @@ void Board::removeFromProject() {
   sgl.dismiss();
 }
 
-bool Board::save(bool toOriginal, QStringList& errors) noexcept {
+bool Board::save(bool toOriginal, SmartSExprFileBatch& batch,
+                 QStringList& errors) noexcept {
   bool success = true;
 
   // save board file
   try {
     if (mIsAddedToProject) {
-      SExpression doc(serializeToDomElement("librepcb_board"));
-      mFile->save(doc, toOriginal);
+      batch.add(*mFile, serializeToDomElement("librepcb_board"));
     } else {
       mFile->removeFile(toOriginal);
     }
@@ -854,7 +909,7 @@ bool Board::save(bool toOriginal, QStringList& errors) noexcept {
   }
 
   // save user settings
-  if (!mUserSettings->save(toOriginal, errors)) {
+  if (!mUserSettings->save(toOriginal, batch, errors)) {
     success = false;
   }
 
@@ -870,40 +925,36 @@ void Board::setSelectionRect(const Point& p1, const Point& p2,
   mGraphicsScene->setSelectionRect(p1, p2);
   if (updateItems) {
     QRectF rectPx = QRectF(p1.toPxQPointF(), p2.toPxQPointF()).normalized();
-    foreach (BI_Device* component, mDeviceInstances) {
-      BI_Footprint& footprint       = component->getFootprint();
-      bool          selectFootprint = footprint.isSelectable() &&
-                             footprint.getGrabAreaScenePx().intersects(rectPx);
-      footprint.setSelected(selectFootprint);
-      foreach (BI_FootprintPad* pad, footprint.getPads()) {
-        bool selectPad =
-            pad->isSelectable() && pad->getGrabAreaScenePx().intersects(rectPx);
-        pad->setSelected(selectFootprint || selectPad);
-      }
-      foreach (BI_StrokeText* text, footprint.getStrokeTexts()) {
-        bool selectText = text->isSelectable() &&
-                          text->getGrabAreaScenePx().intersects(rectPx);
-        text->setSelected(selectFootprint || selectText);
+    QSet<BI_Base*> selectedItems;
+    foreach (BI_Base* item, mItemIndex.find(rectPx)) {
+      if (item->isSelectable() &&
+          item->getGrabAreaScenePx().intersects(rectPx)) {
+        selectedItems.insert(item);
+        if (item->getType() == BI_Base::Type_t::Footprint) {
+          // selecting a footprint also selects all its pads and texts
+          BI_Footprint* footprint = static_cast<BI_Footprint*>(item);
+          foreach (BI_FootprintPad* pad, footprint->getPads()) {
+            selectedItems.insert(pad);
+          }
+          foreach (BI_StrokeText* text, footprint->getStrokeTexts()) {
+            selectedItems.insert(text);
+          }
+        }
       }
     }
-    foreach (BI_NetSegment* segment, mNetSegments) {
-      segment->setSelectionRect(rectPx);
-    }
-    foreach (BI_Plane* plane, mPlanes) {
-      bool select = plane->isSelectable() &&
-                    plane->getGrabAreaScenePx().intersects(rectPx);
-      plane->setSelected(select);
+    // Note: Deselect first since deselecting a footprint also deselects its
+    // pads and texts, which might be selected on their own.
+    foreach (BI_Base* item, mSelectedItems.values()) {
+      if (mItemIndex.contains(*item) && (!selectedItems.contains(item))) {
+        item->setSelected(false);
+      }
     }
+    foreach (BI_Base* item, selectedItems) { item->setSelected(true); }
     foreach (BI_Polygon* polygon, mPolygons) {
       bool select = polygon->isSelectable() &&
                     polygon->getGrabAreaScenePx().intersects(rectPx);
       polygon->setSelected(select);
     }
-    foreach (BI_StrokeText* text, mStrokeTexts) {
-      bool select =
-          text->isSelectable() && text->getGrabAreaScenePx().intersects(rectPx);
-      text->setSelected(select);
-    }
     foreach (BI_Hole* hole, mHoles) {
       bool select =
           hole->isSelectable() && hole->getGrabAreaScenePx().intersects(rectPx);
@@ -913,20 +964,64 @@ void Board::setSelectionRect(const Point& p1, const Point& p2,
 }
 
 void Board::clearSelection() const noexcept {
-  foreach (BI_Device* device, mDeviceInstances)
-    device->getFootprint().setSelected(false);
-  foreach (BI_NetSegment* segment, mNetSegments) { segment->clearSelection(); }
-  foreach (BI_Plane* plane, mPlanes) { plane->setSelected(false); }
-  foreach (BI_Polygon* polygon, mPolygons) { polygon->setSelected(false); }
-  foreach (BI_StrokeText* text, mStrokeTexts) { text->setSelected(false); }
-  foreach (BI_Hole* hole, mHoles) { hole->setSelected(false); }
+  foreach (BI_Base* item, mSelectedItems.values()) {
+    if (mItemIndex.contains(*item) ||
+        (item->getType() == BI_Base::Type_t::Polygon) ||
+        (item->getType() == BI_Base::Type_t::Hole)) {
+      item->setSelected(false);
+    }
+  }
 }
 
 std::unique_ptr<BoardSelectionQuery> Board::createSelectionQuery() const
     noexcept {
-  return std::unique_ptr<BoardSelectionQuery>(new BoardSelectionQuery(
-      mDeviceInstances, mNetSegments, mPlanes, mPolygons, mStrokeTexts, mHoles,
-      const_cast<Board*>(this)));
+  return std::unique_ptr<BoardSelectionQuery>(
+      new BoardSelectionQuery(mSelectedItems, const_cast<Board*>(this)));
+}
+
+/*******************************************************************************
+ *  Item Index Methods
+ ******************************************************************************/
+
+void Board::registerItem(BI_Base& item) noexcept {
+  switch (item.getType()) {
+    case BI_Base::Type_t::Via:
+    case BI_Base::Type_t::NetPoint:
+    case BI_Base::Type_t::NetLine:
+    case BI_Base::Type_t::Footprint:
+    case BI_Base::Type_t::FootprintPad:
+    case BI_Base::Type_t::StrokeText:
+    case BI_Base::Type_t::Plane:
+      mItemIndex.insert(item);
+      mItemOrder.clear();
+      break;
+    default:
+      // Polygons and holes are modified through their geometry objects
+      // without notifying the board items, so they are still tested linearly.
+      // Devices, net segments and airwires are not hit-testable at all.
+      break;
+  }
+  if (item.isSelected()) {
+    mSelectedItems.insert(&item);
+  }
+}
+
+void Board::unregisterItem(BI_Base& item) noexcept {
+  mItemIndex.remove(item);
+  mItemOrder.remove(&item);
+  mSelectedItems.remove(&item);
+}
+
+void Board::updateItemGrabArea(BI_Base& item) noexcept {
+  mItemIndex.update(item);
+}
+
+void Board::updateItemSelection(BI_Base& item) noexcept {
+  if (item.isSelected()) {
+    mSelectedItems.insert(&item);
+  } else {
+    mSelectedItems.remove(&item);
+  }
 }
 
 /*******************************************************************************
@@ -1021,6 +1116,59 @@ void Board::updateErcMessages() noexcept {
   }
 }
 
+QVector<BI_Base*> Board::getSelectableItemsAtScenePos(
+    const QPointF& posPx) const noexcept {
+  QVector<BI_Base*> items;
+  foreach (BI_Base* item, mItemIndex.find(posPx)) {
+    if (item->isSelectable() && item->getGrabAreaScenePx().contains(posPx)) {
+      items.append(item);
+    }
+  }
+  sortByModelOrder(items);
+  return items;
+}
+
+void Board::sortByModelOrder(QVector<BI_Base*>& items) const noexcept {
+  // The index returns the items in an order depending on its modification
+  // history, but overlapping items must always be returned in the same order
+  // to get a deterministic behavior when clicking on them.
+  if (mItemOrder.isEmpty()) {
+    mItemOrder.reserve(mItemIndex.getCount());
+    foreach (const BI_NetSegment* segment, mNetSegments) {
+      foreach (const BI_Via* via, segment->getVias()) {
+        mItemOrder.insert(via, mItemOrder.count());
+      }
+      foreach (const BI_NetPoint* netpoint, segment->getNetPoints()) {
+        mItemOrder.insert(netpoint, mItemOrder.count());
+      }
+      foreach (const BI_NetLine* netline, segment->getNetLines()) {
+        mItemOrder.insert(netline, mItemOrder.count());
+      }
+    }
+    foreach (const BI_Device* device, mDeviceInstances) {
+      const BI_Footprint& footprint = device->getFootprint();
+      mItemOrder.insert(&footprint, mItemOrder.count());
+      foreach (const BI_FootprintPad* pad, footprint.getPads()) {
+        mItemOrder.insert(pad, mItemOrder.count());
+      }
+      foreach (const BI_StrokeText* text, footprint.getStrokeTexts()) {
+        mItemOrder.insert(text, mItemOrder.count());
+      }
+    }
+    foreach (const BI_Plane* plane, mPlanes) {
+      mItemOrder.insert(plane, mItemOrder.count());
+    }
+    foreach (const BI_StrokeText* text, mStrokeTexts) {
+      mItemOrder.insert(text, mItemOrder.count());
+    }
+  }
+  std::stable_sort(items.begin(), items.end(),
+                   [this](const BI_Base* a, const BI_Base* b) {
+                     return mItemOrder.value(a, INT_MAX) <
+                            mItemOrder.value(b, INT_MAX);
+                   });
+}
+
 /*******************************************************************************
  *  Static Methods
  ******************************************************************************/
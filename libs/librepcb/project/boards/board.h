@@ -24,6 +24,7 @@
  *  Includes
  ******************************************************************************/
 #include "../erc/if_ercmsgprovider.h"
+#include "boardairwiresgraph.h"
 
 #include <librepcb/common/attributes/attributeprovider.h>
 #include <librepcb/common/elementname.h>
@@ -31,6 +32,7 @@
 #include <librepcb/common/fileio/filepath.h>
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/units/all_length_units.h>
+#include <librepcb/common/utils/spatialindex.h>
 #include <librepcb/common/uuid.h>
 
 #include <QtCore>
@@ -47,6 +49,7 @@ class GridProperties;
 class GraphicsView;
 class GraphicsScene;
 class SmartSExprFile;
+class SmartSExprFileBatch;
 class GraphicsLayer;
 class BoardDesignRules;
 
@@ -70,6 +73,7 @@ class BoardLayerStack;
 class BoardFabricationOutputSettings;
 class BoardUserSettings;
 class BoardSelectionQuery;
+class BoardPlanesRebuilder;
 
 /*******************************************************************************
  *  Class Board
@@ -196,6 +200,7 @@ public:
   void                    addPlane(BI_Plane& plane);
   void                    removePlane(BI_Plane& plane);
   void                    rebuildAllPlanes() noexcept;
+  void                    rebuildAllPlanesInBackground() noexcept;
 
   // Polygon Methods
   const QList<BI_Polygon*>& getPolygons() const noexcept { return mPolygons; }
@@ -224,7 +229,8 @@ public:
   // General Methods
   void addToProject();
   void removeFromProject();
-  bool save(bool toOriginal, QStringList& errors) noexcept;
+  bool save(bool toOriginal, SmartSExprFileBatch& batch,
+            QStringList& errors) noexcept;
   void showInView(GraphicsView& view) noexcept;
   void saveViewSceneRect(const QRectF& rect) noexcept { mViewRect = rect; }
   const QRectF& restoreViewSceneRect() const noexcept { return mViewRect; }
@@ -233,6 +239,12 @@ public:
   void          clearSelection() const noexcept;
   std::unique_ptr<BoardSelectionQuery> createSelectionQuery() const noexcept;
 
+  // Item Index Methods (called by BI_Base when adding/modifying/removing items)
+  void registerItem(BI_Base& item) noexcept;
+  void unregisterItem(BI_Base& item) noexcept;
+  void updateItemGrabArea(BI_Base& item) noexcept;
+  void updateItemSelection(BI_Base& item) noexcept;
+
   // Inherited from AttributeProvider
   /// @copydoc librepcb::AttributeProvider::getBuiltInAttributeValue()
   QString getBuiltInAttributeValue(const QString& key) const noexcept override;
@@ -262,6 +274,9 @@ private:
         bool create, const QString& newName);
   void updateIcon() noexcept;
   void updateErcMessages() noexcept;
+  QVector<BI_Base*> getSelectableItemsAtScenePos(const QPointF& posPx) const
+      noexcept;
+  void sortByModelOrder(QVector<BI_Base*>& items) const noexcept;
 
   /// @copydoc librepcb::SerializableObject::serialize()
   void serialize(SExpression& root) const override;
@@ -278,6 +293,7 @@ private:
   QScopedPointer<BoardDesignRules>               mDesignRules;
   QScopedPointer<BoardFabricationOutputSettings> mFabricationOutputSettings;
   QScopedPointer<BoardUserSettings>              mUserSettings;
+  QScopedPointer<BoardPlanesRebuilder>           mPlanesRebuilder;
   QRectF                                         mViewRect;
   QSet<NetSignal*> mScheduledNetSignalsForAirWireRebuild;
 
@@ -296,6 +312,18 @@ private:
   QList<BI_Hole*>                     mHoles;
   QMultiHash<NetSignal*, BI_AirWire*> mAirWires;
 
+  /// Bounding rectangles of all hit-testable items (except polygons & holes)
+  mutable SpatialIndex<BI_Base> mItemIndex;
+
+  /// Position of each indexed item in the model (empty if outdated)
+  mutable QHash<const BI_Base*, int> mItemOrder;
+
+  /// All currently selected items which are added to the board
+  QSet<BI_Base*> mSelectedItems;
+
+  /// Incrementally updated airwire graphs of all net signals
+  QHash<const NetSignal*, BoardAirWiresGraph> mAirWiresGraphs;
+
   // ERC messages
   QHash<Uuid, ErcMsg*> mErcMsgListUnplacedComponentInstances;
 };
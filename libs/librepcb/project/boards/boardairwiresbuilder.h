@@ -23,6 +23,8 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include "boardairwiresgraph.h"
+
 #include <librepcb/common/units/point.h>
 
 #include <QtCore>
@@ -52,6 +54,7 @@ public:
   ~BoardAirWiresBuilder() noexcept;
 
   // General Methods
+  BoardAirWiresGraph::Snapshot buildSnapshot() const;
   QVector<QPair<Point, Point>> buildAirWires() const;
 
   // Operator Overloadings
@@ -0,0 +1,337 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boardairwiresgraph.h"
+
+#include <delaunay-triangulation/delaunay.h>
+
+#include <QtConcurrent/QtConcurrent>
+#include <QtCore>
+
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+#include <unordered_map>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*******************************************************************************
+ *  Class BoardAirWiresGraph::UnionFind
+ ******************************************************************************/
+
+class BoardAirWiresGraph::UnionFind final {
+public:
+  explicit UnionFind(int size) noexcept : mParents(size), mSizes(size, 1) {
+    std::iota(mParents.begin(), mParents.end(), 0);
+  }
+
+  int find(int i) noexcept {
+    while (mParents[i] != i) {
+      mParents[i] = mParents[mParents[i]];  // path halving
+      i           = mParents[i];
+    }
+    return i;
+  }
+
+  bool unite(int a, int b) noexcept {
+    a = find(a);
+    b = find(b);
+    if (a == b) return false;
+    if (mSizes[a] < mSizes[b]) std::swap(a, b);
+    mParents[b] = a;
+    mSizes[a] += mSizes[b];
+    return true;
+  }
+
+private:
+  std::vector<int> mParents;
+  std::vector<int> mSizes;
+};
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BoardAirWiresGraph::BoardAirWiresGraph() noexcept
+  : mStaleCount(0),
+    mNeedsFullRebuild(true),
+    mFullRebuildCount(0),
+    mIncrementalUpdateCount(0) {
+}
+
+BoardAirWiresGraph::~BoardAirWiresGraph() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+BoardAirWiresGraph::AirWires BoardAirWiresGraph::update(
+    const Snapshot& snapshot) {
+  // assign anchors to slots and invalidate all moved or added anchors
+  int               oldSlotCount = static_cast<int>(mSlots.size());
+  std::vector<bool> seen(oldSlotCount, false);
+  QVector<int>      slotOfAnchor(snapshot.anchors.count());
+  for (int i = 0; i < snapshot.anchors.count(); ++i) {
+    const Anchor& anchor = snapshot.anchors.at(i);
+    int           slot   = mSlotIndices.value(anchor.key, -1);
+    if (slot < 0) {
+      slot = static_cast<int>(mSlots.size());
+      mSlots.push_back(Slot{anchor.key, anchor.position, true, false});
+      mNeighbors.emplace_back();
+      mSlotIndices.insert(anchor.key, slot);
+      seen.push_back(true);
+      ++mStaleCount;
+    } else if (seen[slot]) {
+      mNeedsFullRebuild = true;  // duplicate key, should not happen
+    } else {
+      seen[slot] = true;
+      if (mSlots[slot].position != anchor.position) {
+        invalidateSlot(slot);
+        mSlots[slot].position = anchor.position;
+      }
+    }
+    slotOfAnchor[i] = slot;
+  }
+
+  // invalidate all removed anchors
+  for (int slot = 0; slot < oldSlotCount; ++slot) {
+    if (mSlots[slot].alive && (!seen[slot])) {
+      invalidateSlot(slot);
+      mSlots[slot].alive = false;
+      mSlotIndices.remove(mSlots[slot].key);
+    }
+  }
+
+  // fall back to a full rebuild if patching the graph is not worth it
+  if (mNeedsFullRebuild || (mStaleCount > sMaxStaleSlots) ||
+      (mStaleCount * 4 > snapshot.anchors.count())) {
+    return rebuild(snapshot);
+  }
+  ++mIncrementalUpdateCount;
+
+  // determine islands of already connected anchors
+  UnionFind islands(static_cast<int>(mSlots.size()));
+  foreach (const auto& connection, snapshot.connections) {
+    islands.unite(slotOfAnchor.at(connection.first),
+                  slotOfAnchor.at(connection.second));
+  }
+
+  // collect candidate edges between different islands
+  std::vector<Edge> edges;
+  for (int a = 0; a < static_cast<int>(mSlots.size()); ++a) {
+    const Slot& slot = mSlots[a];
+    if (!slot.alive) {
+      continue;
+    } else if (slot.clean) {
+      foreach (int b, mNeighbors[a]) {
+        if ((a < b) && (islands.find(a) != islands.find(b))) {
+          edges.push_back(makeEdge(a, b));
+        }
+      }
+    } else {
+      addNearestEdges(a, islands, edges);
+    }
+  }
+
+  return buildSpanningTree(edges, islands);
+}
+
+void BoardAirWiresGraph::clear() noexcept {
+  mSlots.clear();
+  mNeighbors.clear();
+  mSlotIndices.clear();
+  mStaleCount       = 0;
+  mNeedsFullRebuild = true;
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+BoardAirWiresGraph::AirWires BoardAirWiresGraph::build(
+    const Snapshot& snapshot) {
+  BoardAirWiresGraph graph;
+  return graph.rebuild(snapshot);
+}
+
+QVector<BoardAirWiresGraph::AirWires> BoardAirWiresGraph::updateConcurrently(
+    const QVector<BoardAirWiresGraph*>& graphs,
+    const QVector<Snapshot>&            snapshots) {
+  Q_ASSERT(graphs.count() == snapshots.count());
+  QVector<AirWires> airwires(graphs.count());
+  if (graphs.count() == 1) {
+    airwires[0] = graphs.first()->update(snapshots.first());
+  } else if (graphs.count() > 1) {
+    QVector<QFuture<AirWires>> futures;
+    for (int i = 0; i < graphs.count(); ++i) {
+      BoardAirWiresGraph* graph    = graphs.at(i);
+      Snapshot            snapshot = snapshots.at(i);  // implicitly shared
+      futures.append(QtConcurrent::run(
+          [graph, snapshot]() { return graph->update(snapshot); }));
+    }
+    for (int i = 0; i < futures.count(); ++i) {
+      airwires[i] = futures[i].result();  // waits for the result, can throw
+    }
+  }
+  return airwires;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+BoardAirWiresGraph::AirWires BoardAirWiresGraph::rebuild(
+    const Snapshot& snapshot) {
+  clear();
+  ++mFullRebuildCount;
+
+  std::vector<delaunay::Vector2<qreal>> points;
+  points.reserve(snapshot.anchors.count());
+  foreach (const Anchor& anchor, snapshot.anchors) {
+    int id = static_cast<int>(mSlots.size());
+    mSlots.push_back(Slot{anchor.key, anchor.position, true, true});
+    mNeighbors.emplace_back();
+    mSlotIndices.insert(anchor.key, id);
+    points.emplace_back(anchor.position.getX().toNm(),
+                        anchor.position.getY().toNm(), id);
+  }
+
+  // determine candidate edges (superset of the minimum spanning tree)
+  if (points.size() >= 3) {  // minimum 3 points needed for triangulation
+    delaunay::Delaunay<qreal> del;
+    del.triangulate(points);
+    for (const auto& edge : del.getEdges()) {
+      addNeighbors(edge.p1.id, edge.p2.id);
+    }
+  } else if (points.size() == 2) {
+    addNeighbors(0, 1);
+  }
+  mNeedsFullRebuild = false;
+
+  // determine islands of already connected anchors
+  UnionFind islands(static_cast<int>(mSlots.size()));
+  foreach (const auto& connection, snapshot.connections) {
+    islands.unite(connection.first, connection.second);
+  }
+
+  // collect candidate edges between different islands
+  std::vector<Edge> edges;
+  for (int a = 0; a < static_cast<int>(mSlots.size()); ++a) {
+    foreach (int b, mNeighbors[a]) {
+      if ((a < b) && (islands.find(a) != islands.find(b))) {
+        edges.push_back(makeEdge(a, b));
+      }
+    }
+  }
+
+  return buildSpanningTree(edges, islands);
+}
+
+void BoardAirWiresGraph::invalidateSlot(int slot) noexcept {
+  Slot& s = mSlots[slot];
+  if (!s.clean) return;  // already stale
+
+  // remove the anchor from the triangulation
+  QVector<int> neighbors = mNeighbors[slot];
+  mNeighbors[slot].clear();
+  foreach (int neighbor, neighbors) { mNeighbors[neighbor].removeOne(slot); }
+  s.clean = false;
+  ++mStaleCount;
+
+  // the triangulation of the remaining anchors may contain new edges between
+  // the former neighbors of the removed anchor, so add all of them
+  if (neighbors.count() > sMaxPatchedNeighbors) {
+    mNeedsFullRebuild = true;
+  } else if (!mNeedsFullRebuild) {
+    for (int i = 0; i < neighbors.count(); ++i) {
+      for (int k = i + 1; k < neighbors.count(); ++k) {
+        addNeighbors(neighbors.at(i), neighbors.at(k));
+      }
+    }
+  }
+}
+
+void BoardAirWiresGraph::addNeighbors(int a, int b) noexcept {
+  if ((a != b) && (!mNeighbors[a].contains(b))) {
+    mNeighbors[a].append(b);
+    mNeighbors[b].append(a);
+  }
+}
+
+void BoardAirWiresGraph::addNearestEdges(int slot, UnionFind& islands,
+                                         std::vector<Edge>& edges) const
+    noexcept {
+  // Only the shortest edge to each other island can be part of the minimum
+  // spanning tree, all other edges to the same island are longer.
+  std::unordered_map<int, Edge> nearest;
+  int                           island = islands.find(slot);
+  for (int other = 0; other < static_cast<int>(mSlots.size()); ++other) {
+    if ((other == slot) || (!mSlots[other].alive)) continue;
+    int otherIsland = islands.find(other);
+    if (otherIsland == island) continue;
+    Edge edge = makeEdge(slot, other);
+    auto it   = nearest.find(otherIsland);
+    if ((it == nearest.end()) || (edge.weight < it->second.weight)) {
+      nearest[otherIsland] = edge;
+    }
+  }
+  for (const auto& pair : nearest) { edges.push_back(pair.second); }
+}
+
+BoardAirWiresGraph::Edge BoardAirWiresGraph::makeEdge(int a, int b) const
+    noexcept {
+  if (a > b) std::swap(a, b);
+  qreal dx = static_cast<qreal>(mSlots[a].position.getX().toNm() -
+                                mSlots[b].position.getX().toNm());
+  qreal dy = static_cast<qreal>(mSlots[a].position.getY().toNm() -
+                                mSlots[b].position.getY().toNm());
+  return Edge{dx * dx + dy * dy, a, b};
+}
+
+BoardAirWiresGraph::AirWires BoardAirWiresGraph::buildSpanningTree(
+    std::vector<Edge>& edges, UnionFind& islands) const noexcept {
+  // Kruskal algorithm, sorted by weight and then by slots for determinism
+  std::sort(edges.begin(), edges.end(), [](const Edge& lhs, const Edge& rhs) {
+    return std::tie(lhs.weight, lhs.a, lhs.b) <
+           std::tie(rhs.weight, rhs.a, rhs.b);
+  });
+  AirWires airwires;
+  for (const Edge& edge : edges) {
+    if (islands.unite(edge.a, edge.b)) {
+      airwires.append(
+          qMakePair(mSlots[edge.a].position, mSlots[edge.b].position));
+    }
+  }
+  return airwires;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
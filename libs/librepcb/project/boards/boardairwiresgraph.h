@@ -0,0 +1,175 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDAIRWIRESGRAPH_H
+#define LIBREPCB_PROJECT_BOARDAIRWIRESGRAPH_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <librepcb/common/units/point.h>
+
+#include <QtCore>
+
+#include <vector>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*******************************************************************************
+ *  Class BoardAirWiresGraph
+ ******************************************************************************/
+
+/**
+ * @brief Incrementally updated airwire graph of a single net signal
+ *
+ * The airwires of a net are the minimum spanning tree between all islands of
+ * anchors (pads, vias, netpoints) which are not yet connected by netlines or
+ * planes. Candidate edges for this tree are taken from a Delaunay
+ * triangulation of all anchors, which is expensive for large nets.
+ *
+ * This class keeps the candidate edges of the last triangulation and only
+ * patches them locally when anchors are moved, added or removed:
+ *
+ *   - When an anchor is removed from the triangulation (because it was moved
+ *     or deleted), the triangulation of the remaining anchors only gets new
+ *     edges between the former neighbors of that anchor, so all these pairs
+ *     are added as candidates.
+ *   - Anchors which are not part of the triangulation ("stale" anchors) get
+ *     candidate edges to the nearest anchor of every other island.
+ *
+ * The connectivity (union-find over netlines and plane connections) is cheap
+ * and thus determined again on every update. As soon as too many anchors are
+ * stale, the triangulation is rebuilt from scratch.
+ *
+ * The resulting airwires connect exactly the same islands as a full rebuild
+ * would do, and their total length is never longer.
+ */
+class BoardAirWiresGraph final {
+public:
+  // Types
+
+  /**
+   * @brief An anchor point of a net
+   */
+  struct Anchor {
+    const void* key;  ///< Identity of the anchor (never dereferenced)
+    Point       position;
+  };
+
+  /**
+   * @brief All anchors and known connections of a net
+   */
+  struct Snapshot {
+    QVector<Anchor>          anchors;
+    QVector<QPair<int, int>> connections;  ///< Indices into #anchors
+  };
+
+  typedef QVector<QPair<Point, Point>> AirWires;
+
+  // Constructors / Destructor
+  BoardAirWiresGraph() noexcept;
+  BoardAirWiresGraph(const BoardAirWiresGraph& other) = default;
+  ~BoardAirWiresGraph() noexcept;
+
+  // Getters
+  int getFullRebuildCount() const noexcept { return mFullRebuildCount; }
+  int getIncrementalUpdateCount() const noexcept {
+    return mIncrementalUpdateCount;
+  }
+
+  // General Methods
+  AirWires update(const Snapshot& snapshot);
+  void     clear() noexcept;
+
+  // Static Methods
+  static AirWires build(const Snapshot& snapshot);
+
+  /**
+   * @brief Update several independent graphs concurrently
+   *
+   * Each graph is updated with the snapshot at the same index on the global
+   * thread pool. The graphs must be distinct objects.
+   *
+   * @param graphs      The graphs to update.
+   * @param snapshots   The snapshots to update the graphs with.
+   *
+   * @return The airwires of each graph, in the same order as the graphs.
+   *         They are identical to calling #update() on each graph serially.
+   */
+  static QVector<AirWires> updateConcurrently(
+      const QVector<BoardAirWiresGraph*>& graphs,
+      const QVector<Snapshot>&            snapshots);
+
+  // Operator Overloadings
+  BoardAirWiresGraph& operator=(const BoardAirWiresGraph& rhs) = default;
+
+private:  // Types
+  struct Slot {
+    const void* key;
+    Point       position;
+    bool        alive;  ///< Whether the anchor still exists
+    bool        clean;  ///< Whether the anchor is part of the triangulation
+  };
+
+  struct Edge {
+    qreal weight;
+    int   a;
+    int   b;
+  };
+
+  class UnionFind;
+
+private:  // Methods
+  AirWires rebuild(const Snapshot& snapshot);
+  void     invalidateSlot(int slot) noexcept;
+  void     addNeighbors(int a, int b) noexcept;
+  void     addNearestEdges(int slot, UnionFind& islands,
+                           std::vector<Edge>& edges) const noexcept;
+  Edge     makeEdge(int a, int b) const noexcept;
+  AirWires buildSpanningTree(std::vector<Edge>& edges,
+                             UnionFind&         islands) const noexcept;
+
+private:  // Data
+  std::vector<Slot>         mSlots;
+  std::vector<QVector<int>> mNeighbors;  ///< Candidate edges of clean slots
+  QHash<const void*, int>   mSlotIndices;
+  int                       mStaleCount;
+  bool                      mNeedsFullRebuild;
+  int                       mFullRebuildCount;
+  int                       mIncrementalUpdateCount;
+
+  /// Above this number of stale anchors, a full rebuild is cheaper
+  static constexpr int sMaxStaleSlots = 64;
+
+  /// Above this number of neighbors, patching the triangulation is too costly
+  static constexpr int sMaxPatchedNeighbors = 24;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
+
+#endif  // LIBREPCB_PROJECT_BOARDAIRWIRESGRAPH_H
@@ -0,0 +1,470 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boardcamsnapshot.h"
+
+#include "board.h"
+#include "items/bi_device.h"
+#include "items/bi_footprint.h"
+#include "items/bi_footprintpad.h"
+#include "items/bi_hole.h"
+#include "items/bi_netline.h"
+#include "items/bi_netpoint.h"
+#include "items/bi_netsegment.h"
+#include "items/bi_plane.h"
+#include "items/bi_polygon.h"
+#include "items/bi_stroketext.h"
+#include "items/bi_via.h"
+
+#include <librepcb/common/boarddesignrules.h>
+#include <librepcb/common/cam/gerbergenerator.h>
+#include <librepcb/common/geometry/hole.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/library/pkg/footprint.h>
+#include <librepcb/library/pkg/footprintpad.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BoardCamSnapshot::BoardCamSnapshot(const Board&       board,
+                                   const QStringList& layerNames)
+  : mBoard(board) {
+  foreach (const QString& name, layerNames) { mLayers.insert(name, Layer()); }
+
+  // footprints incl. pads
+  foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+    Q_ASSERT(device);
+    addFootprint(device->getFootprint());  // can throw
+  }
+
+  // vias
+  QList<BI_NetSegment*> netsegments = sortedByUuid(mBoard.getNetSegments());
+  foreach (const BI_NetSegment* netsegment, netsegments) {
+    Q_ASSERT(netsegment);
+    foreach (const BI_Via* via, sortedByUuid(netsegment->getVias())) {
+      Q_ASSERT(via);
+      for (auto it = mLayers.begin(); it != mLayers.end(); ++it) {
+        addVia(it.value(), it.key(), *via);
+      }
+      mPthDrills.append(Drill{via->getPosition(), *via->getDrillDiameter()});
+    }
+  }
+
+  // traces
+  foreach (const BI_NetSegment* netsegment, netsegments) {
+    foreach (const BI_NetLine* netline,
+             sortedByUuid(netsegment->getNetLines())) {
+      Q_ASSERT(netline);
+      if (Layer* layer = getLayer(netline->getLayer().getName())) {
+        addLine(*layer, netline->getStartPoint().getPosition(),
+                netline->getEndPoint().getPosition(),
+                positiveToUnsigned(netline->getWidth()));
+      }
+    }
+  }
+
+  // planes
+  foreach (const BI_Plane* plane, sortedByUuid(mBoard.getPlanes())) {
+    Q_ASSERT(plane);
+    if (Layer* layer = getLayer(plane->getLayerName())) {
+      foreach (const Path& fragment, plane->getFragments()) {
+        addPathArea(*layer, fragment);
+      }
+    }
+  }
+
+  // polygons
+  foreach (const BI_Polygon* polygon, sortedByUuid(mBoard.getPolygons())) {
+    Q_ASSERT(polygon);
+    const QString& layerName = polygon->getPolygon().getLayerName();
+    if (Layer* layer = getLayer(layerName)) {
+      UnsignedLength lineWidth =
+          calcWidthOfLayer(polygon->getPolygon().getLineWidth(), layerName);
+      addPath(*layer, polygon->getPolygon().getPath(), lineWidth, false);
+    }
+  }
+
+  // stroke texts
+  foreach (const BI_StrokeText* text, sortedByUuid(mBoard.getStrokeTexts())) {
+    Q_ASSERT(text);
+    const QString& layerName = text->getText().getLayerName();
+    if (Layer* layer = getLayer(layerName)) {
+      UnsignedLength lineWidth =
+          calcWidthOfLayer(text->getText().getStrokeWidth(), layerName);
+      foreach (Path path, text->getText().getPaths()) {
+        path.rotate(text->getText().getRotation());
+        if (text->getText().getMirrored()) path.mirror(Qt::Horizontal);
+        path.translate(text->getText().getPosition());
+        addPath(*layer, path, lineWidth, false);
+      }
+    }
+  }
+
+  // board holes (footprint holes are already added)
+  foreach (const BI_Hole* hole, mBoard.getHoles()) {
+    mNpthDrills.append(Drill{hole->getHole().getPosition(),
+                             *hole->getHole().getDiameter()});
+  }
+}
+
+BoardCamSnapshot::~BoardCamSnapshot() noexcept {
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+int BoardCamSnapshot::getPrimitiveCount(const QString& layerName) const
+    noexcept {
+  return mLayers.value(layerName).primitives.count();
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void BoardCamSnapshot::drawLayer(GerberGenerator& gen,
+                                 const QString&   layerName) const {
+  auto it = mLayers.find(layerName);
+  if (it == mLayers.end()) {
+    throw LogicError(__FILE__, __LINE__,
+                     QString("Layer \"%1\" is not part of the snapshot.")
+                         .arg(layerName));
+  }
+  const Layer& layer = it.value();
+  foreach (const Primitive& p, layer.primitives) {
+    switch (p.type) {
+      case Primitive::Type::Line: {
+        gen.drawLine(p.position, p.end, UnsignedLength(p.width));
+        break;
+      }
+      case Primitive::Type::PathOutline: {
+        gen.drawPathOutline(layer.paths.at(p.index), UnsignedLength(p.width));
+        break;
+      }
+      case Primitive::Type::PathArea: {
+        gen.drawPathArea(layer.paths.at(p.index));
+        break;
+      }
+      case Primitive::Type::CircleOutline: {
+        gen.drawCircleOutline(layer.circles.at(p.index));
+        break;
+      }
+      case Primitive::Type::CircleArea: {
+        gen.drawCircleArea(layer.circles.at(p.index));
+        break;
+      }
+      case Primitive::Type::Circle: {
+        gen.flashCircle(p.position, UnsignedLength(p.width),
+                        UnsignedLength(p.hole));
+        break;
+      }
+      case Primitive::Type::Rect: {
+        gen.flashRect(p.position, UnsignedLength(p.width),
+                      UnsignedLength(p.height), p.rotation,
+                      UnsignedLength(p.hole));
+        break;
+      }
+      case Primitive::Type::Obround: {
+        gen.flashObround(p.position, UnsignedLength(p.width),
+                         UnsignedLength(p.height), p.rotation,
+                         UnsignedLength(p.hole));
+        break;
+      }
+      case Primitive::Type::Octagon: {
+        gen.flashRegularPolygon(p.position, UnsignedLength(p.width), 8,
+                                p.rotation, UnsignedLength(p.hole));
+        break;
+      }
+      default: { throw LogicError(__FILE__, __LINE__); }
+    }
+  }
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void BoardCamSnapshot::addFootprint(const BI_Footprint& footprint) {
+  // pads
+  foreach (const BI_FootprintPad* pad, footprint.getPads()) {
+    for (auto it = mLayers.begin(); it != mLayers.end(); ++it) {
+      addFootprintPad(it.value(), it.key(), *pad);  // can throw
+    }
+    const library::FootprintPad& libPad = pad->getLibPad();
+    if (libPad.getBoardSide() == library::FootprintPad::BoardSide::THT) {
+      mPthDrills.append(
+          Drill{pad->getPosition(), *libPad.getDrillDiameter()});
+    }
+  }
+
+  // polygons
+  for (const Polygon& polygon :
+       footprint.getLibFootprint().getPolygons().sortedByUuid()) {
+    QString layerName = footprint.getIsMirrored()
+                            ? GraphicsLayer::getMirroredLayerName(
+                                  polygon.getLayerName())
+                            : polygon.getLayerName();
+    if (Layer* layer = getLayer(layerName)) {
+      Path path = polygon.getPath();
+      path.rotate(footprint.getRotation());
+      if (footprint.getIsMirrored()) path.mirror(Qt::Horizontal);
+      path.translate(footprint.getPosition());
+      addPath(*layer, path,
+              calcWidthOfLayer(polygon.getLineWidth(), polygon.getLayerName()),
+              polygon.isFilled());
+    }
+  }
+
+  // circles
+  for (const Circle& circle :
+       footprint.getLibFootprint().getCircles().sortedByUuid()) {
+    QString layerName = footprint.getIsMirrored()
+                            ? GraphicsLayer::getMirroredLayerName(
+                                  circle.getLayerName())
+                            : circle.getLayerName();
+    if (Layer* layer = getLayer(layerName)) {
+      Circle e = circle;
+      if (footprint.getIsMirrored())
+        e.setCenter(e.getCenter().mirrored(Qt::Horizontal));
+      e.translate(footprint.getPosition());
+      e.setLineWidth(calcWidthOfLayer(e.getLineWidth(), e.getLayerName()));
+      addCircle(*layer, e);
+    }
+  }
+
+  // stroke texts (from footprint instance, *NOT* from library footprint!)
+  foreach (const BI_StrokeText* text,
+           sortedByUuid(footprint.getStrokeTexts())) {
+    const QString& layerName = text->getText().getLayerName();
+    if (Layer* layer = getLayer(layerName)) {
+      UnsignedLength lineWidth =
+          calcWidthOfLayer(text->getText().getStrokeWidth(), layerName);
+      foreach (Path path, text->getText().getPaths()) {
+        path.rotate(text->getText().getRotation());
+        if (text->getText().getMirrored()) path.mirror(Qt::Horizontal);
+        path.translate(text->getPosition());
+        addPath(*layer, path, lineWidth, false);
+      }
+    }
+  }
+
+  // holes
+  for (const Hole& hole : footprint.getLibFootprint().getHoles()) {
+    mNpthDrills.append(Drill{footprint.mapToScene(hole.getPosition()),
+                             *hole.getDiameter()});
+  }
+}
+
+void BoardCamSnapshot::addFootprintPad(Layer& layer, const QString& layerName,
+                                       const BI_FootprintPad& pad) {
+  bool isSmt =
+      pad.getLibPad().getBoardSide() != library::FootprintPad::BoardSide::THT;
+  bool isOnCopperLayer   = pad.isOnLayer(layerName);
+  bool isOnSolderMaskTop = pad.isOnLayer(GraphicsLayer::sTopCopper) &&
+                           (layerName == GraphicsLayer::sTopStopMask);
+  bool isOnSolderMaskBottom = pad.isOnLayer(GraphicsLayer::sBotCopper) &&
+                              (layerName == GraphicsLayer::sBotStopMask);
+  bool isOnSolderPasteTop = isSmt && pad.isOnLayer(GraphicsLayer::sTopCopper) &&
+                            (layerName == GraphicsLayer::sTopSolderPaste);
+  bool isOnSolderPasteBottom = isSmt &&
+                               pad.isOnLayer(GraphicsLayer::sBotCopper) &&
+                               (layerName == GraphicsLayer::sBotSolderPaste);
+  if (!isOnCopperLayer && !isOnSolderMaskTop && !isOnSolderMaskBottom &&
+      !isOnSolderPasteTop && !isOnSolderPasteBottom) {
+    return;
+  }
+
+  Angle rot = pad.getIsMirrored() ? -pad.getRotation() : pad.getRotation();
+  const library::FootprintPad& libPad = pad.getLibPad();
+  Length                       width  = *libPad.getWidth();
+  Length                       height = *libPad.getHeight();
+  if (isOnSolderMaskTop || isOnSolderMaskBottom) {
+    Length         size = qMin(width, height);
+    UnsignedLength clearance =
+        mBoard.getDesignRules().calcStopMaskClearance(size);
+    width += clearance * 2;
+    height += clearance * 2;
+  } else if (isOnSolderPasteTop || isOnSolderPasteBottom) {
+    Length size      = qMin(width, height);
+    Length clearance = -mBoard.getDesignRules().calcCreamMaskClearance(size);
+    width += clearance * 2;
+    height += clearance * 2;
+  }
+
+  if ((width <= 0) || (height <= 0)) {
+    qWarning() << "Pad with zero size ignored in gerber export:"
+               << pad.getLibPadUuid();
+    return;
+  }
+
+  switch (libPad.getShape()) {
+    case library::FootprintPad::Shape::ROUND: {
+      if (width == height) {
+        addFlash(layer, Primitive::Type::Circle, pad.getPosition(), width,
+                 height, Angle::deg0());
+      } else {
+        addFlash(layer, Primitive::Type::Obround, pad.getPosition(), width,
+                 height, rot);
+      }
+      break;
+    }
+    case library::FootprintPad::Shape::RECT: {
+      addFlash(layer, Primitive::Type::Rect, pad.getPosition(), width, height,
+               rot);
+      break;
+    }
+    case library::FootprintPad::Shape::OCTAGON: {
+      if (width != height) {
+        throw LogicError(
+            __FILE__, __LINE__,
+            tr("Sorry, non-square octagons are not yet supported."));
+      }
+      addFlash(layer, Primitive::Type::Octagon, pad.getPosition(), width,
+               height, rot);
+      break;
+    }
+    default: { throw LogicError(__FILE__, __LINE__); }
+  }
+}
+
+void BoardCamSnapshot::addVia(Layer& layer, const QString& layerName,
+                              const BI_Via& via) {
+  bool drawCopper = via.isOnLayer(layerName);
+  bool drawStopMask =
+      (layerName == GraphicsLayer::sTopStopMask ||
+       layerName == GraphicsLayer::sBotStopMask) &&
+      mBoard.getDesignRules().doesViaRequireStopMask(*via.getDrillDiameter());
+  if (drawCopper || drawStopMask) {
+    Length outerDiameter = *via.getSize();
+    if (drawStopMask) {
+      outerDiameter +=
+          mBoard.getDesignRules().calcStopMaskClearance(*via.getSize()) * 2;
+    }
+    switch (via.getShape()) {
+      case BI_Via::Shape::Round: {
+        addFlash(layer, Primitive::Type::Circle, via.getPosition(),
+                 outerDiameter, outerDiameter, Angle::deg0());
+        break;
+      }
+      case BI_Via::Shape::Square: {
+        addFlash(layer, Primitive::Type::Rect, via.getPosition(),
+                 outerDiameter, outerDiameter, Angle::deg0());
+        break;
+      }
+      case BI_Via::Shape::Octagon: {
+        addFlash(layer, Primitive::Type::Octagon, via.getPosition(),
+                 outerDiameter, outerDiameter, Angle::deg0());
+        break;
+      }
+      default: { throw LogicError(__FILE__, __LINE__); }
+    }
+  }
+}
+
+void BoardCamSnapshot::addLine(Layer& layer, const Point& start,
+                               const Point&          end,
+                               const UnsignedLength& width) noexcept {
+  layer.primitives.append(Primitive{Primitive::Type::Line, start, end, *width,
+                                    Length(0), Length(0), Angle::deg0(), -1});
+}
+
+void BoardCamSnapshot::addPath(Layer& layer, const Path& path,
+                               const UnsignedLength& lineWidth,
+                               bool                  filled) noexcept {
+  int index = layer.paths.count();
+  layer.paths.append(path);
+  layer.primitives.append(Primitive{Primitive::Type::PathOutline, Point(),
+                                    Point(), *lineWidth, Length(0), Length(0),
+                                    Angle::deg0(), index});
+  if (filled) {
+    layer.primitives.append(Primitive{Primitive::Type::PathArea, Point(),
+                                      Point(), Length(0), Length(0), Length(0),
+                                      Angle::deg0(), index});
+  }
+}
+
+void BoardCamSnapshot::addPathArea(Layer& layer, const Path& path) noexcept {
+  int index = layer.paths.count();
+  layer.paths.append(path);
+  layer.primitives.append(Primitive{Primitive::Type::PathArea, Point(),
+                                    Point(), Length(0), Length(0), Length(0),
+                                    Angle::deg0(), index});
+}
+
+void BoardCamSnapshot::addCircle(Layer& layer, const Circle& circle) noexcept {
+  int index = layer.circles.count();
+  layer.circles.append(circle);
+  layer.primitives.append(Primitive{Primitive::Type::CircleOutline, Point(),
+                                    Point(), Length(0), Length(0), Length(0),
+                                    Angle::deg0(), index});
+  if (circle.isFilled()) {
+    layer.primitives.append(Primitive{Primitive::Type::CircleArea, Point(),
+                                      Point(), Length(0), Length(0), Length(0),
+                                      Angle::deg0(), index});
+  }
+}
+
+void BoardCamSnapshot::addFlash(Layer& layer, Primitive::Type type,
+                                const Point& pos, const Length& width,
+                                const Length& height, const Angle& rot,
+                                const Length& hole) noexcept {
+  layer.primitives.append(
+      Primitive{type, pos, Point(), width, height, hole, rot, -1});
+}
+
+BoardCamSnapshot::Layer* BoardCamSnapshot::getLayer(
+    const QString& name) noexcept {
+  auto it = mLayers.find(name);
+  return (it != mLayers.end()) ? &it.value() : nullptr;
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+UnsignedLength BoardCamSnapshot::calcWidthOfLayer(
+    const UnsignedLength& width, const QString& name) noexcept {
+  if ((name == GraphicsLayer::sBoardOutlines) &&
+      (width < UnsignedLength(1000))) {
+    return UnsignedLength(1000);  // outlines should have a minimum width of 1um
+  } else {
+    return width;
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
@@ -0,0 +1,163 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_PROJECT_BOARDCAMSNAPSHOT_H
+#define LIBREPCB_PROJECT_BOARDCAMSNAPSHOT_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <librepcb/common/geometry/circle.h>
+#include <librepcb/common/geometry/path.h>
+#include <librepcb/common/units/all_length_units.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class GerberGenerator;
+
+namespace project {
+
+class Board;
+class BI_Via;
+class BI_Footprint;
+class BI_FootprintPad;
+
+/*******************************************************************************
+ *  Class BoardCamSnapshot
+ ******************************************************************************/
+
+/**
+ * @brief Read-only snapshot of all drawable primitives of a board, bucketed
+ *        by layer
+ *
+ * The constructor walks over all board items exactly once (sorted by UUID to
+ * get reproducible files) and appends their primitives to the buckets of all
+ * requested layers, in the same order as they are drawn. Afterwards, drawing
+ * a layer only iterates over its own primitives.
+ *
+ * After construction, the snapshot does not access the board anymore and can
+ * be used from several threads concurrently.
+ */
+class BoardCamSnapshot final {
+  Q_DECLARE_TR_FUNCTIONS(BoardCamSnapshot)
+
+public:
+  // Types
+  struct Drill {
+    Point  position;
+    Length diameter;
+  };
+
+  // Constructors / Destructor
+  BoardCamSnapshot()                              = delete;
+  BoardCamSnapshot(const BoardCamSnapshot& other) = delete;
+  BoardCamSnapshot(const Board& board, const QStringList& layerNames);
+  ~BoardCamSnapshot() noexcept;
+
+  // Getters
+  int getPrimitiveCount(const QString& layerName) const noexcept;
+  const QVector<Drill>& getPthDrills() const noexcept { return mPthDrills; }
+  const QVector<Drill>& getNpthDrills() const noexcept { return mNpthDrills; }
+
+  // General Methods
+  void drawLayer(GerberGenerator& gen, const QString& layerName) const;
+
+  // Operator Overloadings
+  BoardCamSnapshot& operator=(const BoardCamSnapshot& rhs) = delete;
+
+private:  // Types
+  struct Primitive {
+    enum class Type : quint8 {
+      Line,           ///< Line from #position to #end
+      PathOutline,    ///< Outline of Layer::paths[#index]
+      PathArea,       ///< Area of Layer::paths[#index]
+      CircleOutline,  ///< Outline of Layer::circles[#index]
+      CircleArea,     ///< Area of Layer::circles[#index]
+      Circle,         ///< Flashed circle with diameter #width and #hole
+      Rect,           ///< Flashed rect with #width, #height and #rotation
+      Obround,        ///< Flashed obround with #width, #height and #rotation
+      Octagon,        ///< Flashed octagon with diameter #width and #rotation
+    };
+
+    Type   type;
+    Point  position;
+    Point  end;
+    Length width;  ///< Also used as line width of lines and path outlines
+    Length height;
+    Length hole;
+    Angle  rotation;
+    int    index;  ///< Index in Layer::paths or Layer::circles
+  };
+
+  struct Layer {
+    QVector<Primitive> primitives;
+    QVector<Path>      paths;
+    QList<Circle>      circles;  ///< QList since Circle has no default ctor
+  };
+
+private:  // Methods
+  void addFootprint(const BI_Footprint& footprint);
+  void addFootprintPad(Layer& layer, const QString& layerName,
+                       const BI_FootprintPad& pad);
+  void addVia(Layer& layer, const QString& layerName, const BI_Via& via);
+  void addLine(Layer& layer, const Point& start, const Point& end,
+               const UnsignedLength& width) noexcept;
+  void addPath(Layer& layer, const Path& path, const UnsignedLength& lineWidth,
+               bool filled) noexcept;
+  void addPathArea(Layer& layer, const Path& path) noexcept;
+  void addCircle(Layer& layer, const Circle& circle) noexcept;
+  void addFlash(Layer& layer, Primitive::Type type, const Point& pos,
+                const Length& width, const Length& height, const Angle& rot,
+                const Length& hole = Length(0)) noexcept;
+  Layer* getLayer(const QString& name) noexcept;
+
+  // Static Methods
+  static UnsignedLength calcWidthOfLayer(const UnsignedLength& width,
+                                         const QString&        name) noexcept;
+  template <typename T>
+  static QList<T*> sortedByUuid(const QList<T*>& list) noexcept {
+    // sort a list of objects by their UUID to get reproducable gerber files
+    QList<T*> copy = list;
+    qSort(copy.begin(), copy.end(), [](const T* o1, const T* o2) {
+      return o1->getUuid() < o2->getUuid();
+    });
+    return copy;
+  }
+
+private:  // Data
+  const Board&          mBoard;  ///< Only used during construction
+  QHash<QString, Layer> mLayers;
+  QVector<Drill>        mPthDrills;
+  QVector<Drill>        mNpthDrills;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
+
+#endif  // LIBREPCB_PROJECT_BOARDCAMSNAPSHOT_H
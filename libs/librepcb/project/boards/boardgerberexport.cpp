@@ -25,29 +25,16 @@
 #include "../metadata/projectmetadata.h"
 #include "../project.h"
 #include "board.h"
+#include "boardcamsnapshot.h"
 #include "boardfabricationoutputsettings.h"
 #include "boardlayerstack.h"
-#include "items/bi_device.h"
-#include "items/bi_footprint.h"
-#include "items/bi_footprintpad.h"
-#include "items/bi_hole.h"
-#include "items/bi_netline.h"
-#include "items/bi_netpoint.h"
-#include "items/bi_netsegment.h"
-#include "items/bi_plane.h"
-#include "items/bi_polygon.h"
-#include "items/bi_stroketext.h"
-#include "items/bi_via.h"
 
 #include <librepcb/common/attributes/attributesubstitutor.h>
-#include <librepcb/common/boarddesignrules.h>
 #include <librepcb/common/cam/excellongenerator.h>
 #include <librepcb/common/cam/gerbergenerator.h>
-#include <librepcb/common/geometry/hole.h>
 #include <librepcb/common/graphics/graphicslayer.h>
-#include <librepcb/library/pkg/footprint.h>
-#include <librepcb/library/pkg/footprintpad.h>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -81,26 +68,41 @@ FilePath BoardGerberExport::getOutputDirectory() const noexcept {
 
 void BoardGerberExport::exportAllLayers() const {
   mWrittenFiles.clear();
+  QVector<Job>     jobs     = createJobs();
+  BoardCamSnapshot snapshot(mBoard, getLayerNames(jobs));  // can throw
+  foreach (const Job& job, jobs) {
+    if (job.generate(job.filePath, snapshot)) {  // can throw
+      mWrittenFiles.append(job.filePath);
+    }
+  }
+}
 
-  if (mBoard.getFabricationOutputSettings().getMergeDrillFiles()) {
-    exportDrills();
-  } else {
-    exportDrillsNpth();
-    exportDrillsPth();
+void BoardGerberExport::exportAllLayersConcurrently() const {
+  mWrittenFiles.clear();
+  QVector<Job>                            jobs = createJobs();
+  std::shared_ptr<const BoardCamSnapshot> snapshot =
+      std::make_shared<BoardCamSnapshot>(mBoard,
+                                         getLayerNames(jobs));  // can throw
+  QVector<QFuture<bool>> futures;
+  foreach (const Job& job, jobs) {
+    futures.append(QtConcurrent::run(
+        [job, snapshot]() { return job.generate(job.filePath, *snapshot); }));
   }
-  exportLayerBoardOutlines();
-  exportLayerTopCopper();
-  exportLayerInnerCopper();
-  exportLayerBottomCopper();
-  exportLayerTopSolderMask();
-  exportLayerBottomSolderMask();
-  exportLayerTopSilkscreen();
-  exportLayerBottomSilkscreen();
-  if (mBoard.getFabricationOutputSettings().getEnableSolderPasteTop()) {
-    exportLayerTopSolderPaste();
+
+  // Wait until all workers are finished before throwing any exception since
+  // they access this object. Afterwards, the results are collected in the
+  // same order as in #exportAllLayers() to get an identical list of files.
+  for (QFuture<bool>& future : futures) {
+    try {
+      future.waitForFinished();
+    } catch (...) {
+      // rethrown below
+    }
   }
-  if (mBoard.getFabricationOutputSettings().getEnableSolderPasteBot()) {
-    exportLayerBottomSolderPaste();
+  for (int i = 0; i < jobs.count(); ++i) {
+    if (futures[i].result()) {  // can throw
+      mWrittenFiles.append(jobs.at(i).filePath);
+    }
   }
 }
 
@@ -126,465 +128,153 @@ BoardGerberExport::getAttributeProviderParents() const noexcept {
  *  Private Methods
  ******************************************************************************/
 
-void BoardGerberExport::exportDrills() const {
-  FilePath fp = getOutputFilePath(
-      mBoard.getFabricationOutputSettings().getSuffixDrills());
-  ExcellonGenerator gen;
-  drawPthDrills(gen);
-  drawNpthDrills(gen);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
-}
-
-void BoardGerberExport::exportDrillsNpth() const {
-  FilePath fp = getOutputFilePath(
-      mBoard.getFabricationOutputSettings().getSuffixDrillsNpth());
-  ExcellonGenerator gen;
-  int               count = drawNpthDrills(gen);
-  if (count > 0) {
-    // Some PCB manufacturers don't like to have separate drill files for PTH
-    // and NPTH. As many boards don't have non-plated holes anyway, we create
-    // this file only if it's really needed. Maybe this avoids unnecessary
-    // issues with manufacturers...
-    gen.generate();
-    gen.saveToFile(fp);
-    mWrittenFiles.append(fp);
-  }
-}
-
-void BoardGerberExport::exportDrillsPth() const {
-  FilePath fp = getOutputFilePath(
-      mBoard.getFabricationOutputSettings().getSuffixDrillsPth());
-  ExcellonGenerator gen;
-  drawPthDrills(gen);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
-}
-
-void BoardGerberExport::exportLayerBoardOutlines() const {
-  FilePath fp = getOutputFilePath(
-      mBoard.getFabricationOutputSettings().getSuffixOutlines());
-  GerberGenerator gen(
-      mProject.getMetadata().getName() % " - " % mBoard.getName(),
-      mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sBoardOutlines);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
-}
-
-void BoardGerberExport::exportLayerTopCopper() const {
-  FilePath fp = getOutputFilePath(
-      mBoard.getFabricationOutputSettings().getSuffixCopperTop());
-  GerberGenerator gen(
+QVector<BoardGerberExport::Job> BoardGerberExport::createJobs() const {
+  // Note: All output file paths and the project information are determined
+  // here in the calling thread because the attribute substitution depends on
+  // mCurrentInnerCopperLayer and the jobs must not access the project.
+  const BoardFabricationOutputSettings& settings =
+      mBoard.getFabricationOutputSettings();
+  const GerberHeader header{
       mProject.getMetadata().getName() % " - " % mBoard.getName(),
-      mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sTopCopper);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
-}
-
-void BoardGerberExport::exportLayerBottomCopper() const {
-  FilePath fp = getOutputFilePath(
-      mBoard.getFabricationOutputSettings().getSuffixCopperBot());
-  GerberGenerator gen(
-      mProject.getMetadata().getName() % " - " % mBoard.getName(),
-      mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sBotCopper);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
-}
-
-void BoardGerberExport::exportLayerInnerCopper() const {
+      mBoard.getUuid(), mProject.getMetadata().getVersion()};
+  QVector<Job> jobs;
+
+  auto addLayerJob = [&](const QString& suffix, const QString& layerName) {
+    jobs.append(Job{getOutputFilePath(suffix), {layerName},
+                    [this, header, layerName](
+                        const FilePath& fp, const BoardCamSnapshot& snapshot) {
+                      return exportLayer(fp, snapshot, header, layerName);
+                    }});
+  };
+  auto addSilkscreenJob = [&](const QString&     suffix,
+                              const QStringList& layerNames,
+                              const QString&     stopMaskLayerName) {
+    jobs.append(Job{getOutputFilePath(suffix),
+                    layerNames + QStringList{stopMaskLayerName},
+                    [this, header, layerNames, stopMaskLayerName](
+                        const FilePath& fp, const BoardCamSnapshot& snapshot) {
+                      return exportLayerSilkscreen(fp, snapshot, header,
+                                                   layerNames,
+                                                   stopMaskLayerName);
+                    }});
+  };
+
+  if (settings.getMergeDrillFiles()) {
+    jobs.append(Job{getOutputFilePath(settings.getSuffixDrills()),
+                    {},
+                    [this](const FilePath&         fp,
+                           const BoardCamSnapshot& snapshot) {
+                      return exportDrills(fp, snapshot);
+                    }});
+  } else {
+    jobs.append(Job{getOutputFilePath(settings.getSuffixDrillsNpth()),
+                    {},
+                    [this](const FilePath&         fp,
+                           const BoardCamSnapshot& snapshot) {
+                      return exportDrillsNpth(fp, snapshot);
+                    }});
+    jobs.append(Job{getOutputFilePath(settings.getSuffixDrillsPth()),
+                    {},
+                    [this](const FilePath&         fp,
+                           const BoardCamSnapshot& snapshot) {
+                      return exportDrillsPth(fp, snapshot);
+                    }});
+  }
+  addLayerJob(settings.getSuffixOutlines(), GraphicsLayer::sBoardOutlines);
+  addLayerJob(settings.getSuffixCopperTop(), GraphicsLayer::sTopCopper);
   for (int i = 1; i <= mBoard.getLayerStack().getInnerLayerCount(); ++i) {
     mCurrentInnerCopperLayer = i;  // used for attribute provider
-    FilePath fp              = getOutputFilePath(
-        mBoard.getFabricationOutputSettings().getSuffixCopperInner());
-    GerberGenerator gen(
-        mProject.getMetadata().getName() % " - " % mBoard.getName(),
-        mBoard.getUuid(), mProject.getMetadata().getVersion());
-    drawLayer(gen, GraphicsLayer::getInnerLayerName(i));
-    gen.generate();
-    gen.saveToFile(fp);
-    mWrittenFiles.append(fp);
+    addLayerJob(settings.getSuffixCopperInner(),
+                GraphicsLayer::getInnerLayerName(i));
   }
   mCurrentInnerCopperLayer = 0;
+  addLayerJob(settings.getSuffixCopperBot(), GraphicsLayer::sBotCopper);
+  addLayerJob(settings.getSuffixSolderMaskTop(), GraphicsLayer::sTopStopMask);
+  addLayerJob(settings.getSuffixSolderMaskBot(), GraphicsLayer::sBotStopMask);
+  // don't create silkscreen files if no layers selected
+  if (settings.getSilkscreenLayersTop().count() > 0) {
+    addSilkscreenJob(settings.getSuffixSilkscreenTop(),
+                     settings.getSilkscreenLayersTop(),
+                     GraphicsLayer::sTopStopMask);
+  }
+  if (settings.getSilkscreenLayersBot().count() > 0) {
+    addSilkscreenJob(settings.getSuffixSilkscreenBot(),
+                     settings.getSilkscreenLayersBot(),
+                     GraphicsLayer::sBotStopMask);
+  }
+  if (settings.getEnableSolderPasteTop()) {
+    addLayerJob(settings.getSuffixSolderPasteTop(),
+                GraphicsLayer::sTopSolderPaste);
+  }
+  if (settings.getEnableSolderPasteBot()) {
+    addLayerJob(settings.getSuffixSolderPasteBot(),
+                GraphicsLayer::sBotSolderPaste);
+  }
+  return jobs;
 }
 
-void BoardGerberExport::exportLayerTopSolderMask() const {
-  FilePath fp = getOutputFilePath(
-      mBoard.getFabricationOutputSettings().getSuffixSolderMaskTop());
-  GerberGenerator gen(
-      mProject.getMetadata().getName() % " - " % mBoard.getName(),
-      mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sTopStopMask);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
-}
-
-void BoardGerberExport::exportLayerBottomSolderMask() const {
-  FilePath fp = getOutputFilePath(
-      mBoard.getFabricationOutputSettings().getSuffixSolderMaskBot());
-  GerberGenerator gen(
-      mProject.getMetadata().getName() % " - " % mBoard.getName(),
-      mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sBotStopMask);
+bool BoardGerberExport::exportDrills(const FilePath&         fp,
+                                     const BoardCamSnapshot& snapshot) const {
+  ExcellonGenerator gen;
+  drawDrills(gen, snapshot.getPthDrills());
+  drawDrills(gen, snapshot.getNpthDrills());
   gen.generate();
   gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
-}
-
-void BoardGerberExport::exportLayerTopSilkscreen() const {
-  QStringList layers =
-      mBoard.getFabricationOutputSettings().getSilkscreenLayersTop();
-  if (layers.count() >
-      0) {  // don't create silkscreen file if no layers selected
-    FilePath fp = getOutputFilePath(
-        mBoard.getFabricationOutputSettings().getSuffixSilkscreenTop());
-    GerberGenerator gen(
-        mProject.getMetadata().getName() % " - " % mBoard.getName(),
-        mBoard.getUuid(), mProject.getMetadata().getVersion());
-    foreach (const QString& layer, layers) { drawLayer(gen, layer); }
-    gen.setLayerPolarity(GerberGenerator::LayerPolarity::Negative);
-    drawLayer(gen, GraphicsLayer::sTopStopMask);
-    gen.generate();
-    gen.saveToFile(fp);
-    mWrittenFiles.append(fp);
-  }
+  return true;
 }
 
-void BoardGerberExport::exportLayerBottomSilkscreen() const {
-  QStringList layers =
-      mBoard.getFabricationOutputSettings().getSilkscreenLayersBot();
-  if (layers.count() >
-      0) {  // don't create silkscreen file if no layers selected
-    FilePath fp = getOutputFilePath(
-        mBoard.getFabricationOutputSettings().getSuffixSilkscreenBot());
-    GerberGenerator gen(
-        mProject.getMetadata().getName() % " - " % mBoard.getName(),
-        mBoard.getUuid(), mProject.getMetadata().getVersion());
-    foreach (const QString& layer, layers) { drawLayer(gen, layer); }
-    gen.setLayerPolarity(GerberGenerator::LayerPolarity::Negative);
-    drawLayer(gen, GraphicsLayer::sBotStopMask);
+bool BoardGerberExport::exportDrillsNpth(
+    const FilePath& fp, const BoardCamSnapshot& snapshot) const {
+  if (snapshot.getNpthDrills().count() > 0) {
+    // Some PCB manufacturers don't like to have separate drill files for PTH
+    // and NPTH. As many boards don't have non-plated holes anyway, we create
+    // this file only if it's really needed. Maybe this avoids unnecessary
+    // issues with manufacturers...
+    ExcellonGenerator gen;
+    drawDrills(gen, snapshot.getNpthDrills());
     gen.generate();
     gen.saveToFile(fp);
-    mWrittenFiles.append(fp);
+    return true;
+  } else {
+    return false;
   }
 }
 
-void BoardGerberExport::exportLayerTopSolderPaste() const {
-  FilePath fp = getOutputFilePath(
-      mBoard.getFabricationOutputSettings().getSuffixSolderPasteTop());
-  GerberGenerator gen(
-      mProject.getMetadata().getName() % " - " % mBoard.getName(),
-      mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sTopSolderPaste);
+bool BoardGerberExport::exportDrillsPth(
+    const FilePath& fp, const BoardCamSnapshot& snapshot) const {
+  ExcellonGenerator gen;
+  drawDrills(gen, snapshot.getPthDrills());
   gen.generate();
   gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+  return true;
 }
 
-void BoardGerberExport::exportLayerBottomSolderPaste() const {
-  FilePath fp = getOutputFilePath(
-      mBoard.getFabricationOutputSettings().getSuffixSolderPasteBot());
-  GerberGenerator gen(
-      mProject.getMetadata().getName() % " - " % mBoard.getName(),
-      mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sBotSolderPaste);
-  gen.generate();
+bool BoardGerberExport::exportLayer(const FilePath&         fp,
+                                    const BoardCamSnapshot& snapshot,
+                                    const GerberHeader&     header,
+                                    const QString&          layerName) const {
+  GerberGenerator gen(header.projName, header.projUuid, header.projRevision);
+  snapshot.drawLayer(gen, layerName);
   gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
-}
-
-int BoardGerberExport::drawNpthDrills(ExcellonGenerator& gen) const {
-  int count = 0;
-
-  // footprint holes
-  foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
-    const BI_Footprint& footprint = device->getFootprint();
-    for (const Hole& hole : footprint.getLibFootprint().getHoles()) {
-      gen.drill(footprint.mapToScene(hole.getPosition()), hole.getDiameter());
-      ++count;
-    }
-  }
-
-  // board holes
-  foreach (const BI_Hole* hole, mBoard.getHoles()) {
-    gen.drill(hole->getHole().getPosition(), hole->getHole().getDiameter());
-    ++count;
-  }
-
-  return count;
-}
-
-int BoardGerberExport::drawPthDrills(ExcellonGenerator& gen) const {
-  int count = 0;
-
-  // footprint pads
-  foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
-    const BI_Footprint& footprint = device->getFootprint();
-    foreach (const BI_FootprintPad* pad, footprint.getPads()) {
-      const library::FootprintPad& libPad = pad->getLibPad();
-      if (libPad.getBoardSide() == library::FootprintPad::BoardSide::THT) {
-        gen.drill(pad->getPosition(),
-                  PositiveLength(*libPad.getDrillDiameter()));  // can throw
-        ++count;
-      }
-    }
-  }
-
-  // vias
-  foreach (const BI_NetSegment* netsegment,
-           sortedByUuid(mBoard.getNetSegments())) {
-    foreach (const BI_Via* via, sortedByUuid(netsegment->getVias())) {
-      gen.drill(via->getPosition(), via->getDrillDiameter());
-      ++count;
-    }
-  }
-
-  return count;
-}
-
-void BoardGerberExport::drawLayer(GerberGenerator& gen,
-                                  const QString&   layerName) const {
-  // draw footprints incl. pads
-  foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
-    Q_ASSERT(device);
-    drawFootprint(gen, device->getFootprint(), layerName);
-  }
-
-  // draw vias
-  foreach (const BI_NetSegment* netsegment,
-           sortedByUuid(mBoard.getNetSegments())) {
-    Q_ASSERT(netsegment);
-    foreach (const BI_Via* via, sortedByUuid(netsegment->getVias())) {
-      Q_ASSERT(via);
-      drawVia(gen, *via, layerName);
-    }
-  }
-
-  // draw traces
-  foreach (const BI_NetSegment* netsegment,
-           sortedByUuid(mBoard.getNetSegments())) {
-    Q_ASSERT(netsegment);
-    foreach (const BI_NetLine* netline,
-             sortedByUuid(netsegment->getNetLines())) {
-      Q_ASSERT(netline);
-      if (netline->getLayer().getName() == layerName) {
-        gen.drawLine(netline->getStartPoint().getPosition(),
-                     netline->getEndPoint().getPosition(),
-                     positiveToUnsigned(netline->getWidth()));
-      }
-    }
-  }
-
-  // draw planes
-  foreach (const BI_Plane* plane, sortedByUuid(mBoard.getPlanes())) {
-    Q_ASSERT(plane);
-    if (plane->getLayerName() == layerName) {
-      foreach (const Path& fragment, plane->getFragments()) {
-        gen.drawPathArea(fragment);
-      }
-    }
-  }
-
-  // draw polygons
-  foreach (const BI_Polygon* polygon, sortedByUuid(mBoard.getPolygons())) {
-    Q_ASSERT(polygon);
-    if (layerName == polygon->getPolygon().getLayerName()) {
-      UnsignedLength lineWidth =
-          calcWidthOfLayer(polygon->getPolygon().getLineWidth(), layerName);
-      gen.drawPathOutline(polygon->getPolygon().getPath(), lineWidth);
-    }
-  }
-
-  // draw stroke texts
-  foreach (const BI_StrokeText* text, sortedByUuid(mBoard.getStrokeTexts())) {
-    Q_ASSERT(text);
-    if (layerName == text->getText().getLayerName()) {
-      UnsignedLength lineWidth =
-          calcWidthOfLayer(text->getText().getStrokeWidth(), layerName);
-      foreach (Path path, text->getText().getPaths()) {
-        path.rotate(text->getText().getRotation());
-        if (text->getText().getMirrored()) path.mirror(Qt::Horizontal);
-        path.translate(text->getText().getPosition());
-        gen.drawPathOutline(path, lineWidth);
-      }
-    }
-  }
+  return true;
 }
 
-void BoardGerberExport::drawVia(GerberGenerator& gen, const BI_Via& via,
-                                const QString& layerName) const {
-  bool drawCopper = via.isOnLayer(layerName);
-  bool drawStopMask =
-      (layerName == GraphicsLayer::sTopStopMask ||
-       layerName == GraphicsLayer::sBotStopMask) &&
-      mBoard.getDesignRules().doesViaRequireStopMask(*via.getDrillDiameter());
-  if (drawCopper || drawStopMask) {
-    UnsignedLength outerDiameter = positiveToUnsigned(via.getSize());
-    if (drawStopMask) {
-      outerDiameter += UnsignedLength(
-          mBoard.getDesignRules().calcStopMaskClearance(*via.getSize()) * 2);
-    }
-    switch (via.getShape()) {
-      case BI_Via::Shape::Round: {
-        gen.flashCircle(via.getPosition(), outerDiameter, UnsignedLength(0));
-        break;
-      }
-      case BI_Via::Shape::Square: {
-        gen.flashRect(via.getPosition(), outerDiameter, outerDiameter,
-                      Angle::deg0(), UnsignedLength(0));
-        break;
-      }
-      case BI_Via::Shape::Octagon: {
-        gen.flashRegularPolygon(via.getPosition(), outerDiameter, 8,
-                                Angle::deg0(), UnsignedLength(0));
-        break;
-      }
-      default: { throw LogicError(__FILE__, __LINE__); }
-    }
-  }
-}
-
-void BoardGerberExport::drawFootprint(GerberGenerator&    gen,
-                                      const BI_Footprint& footprint,
-                                      const QString&      layerName) const {
-  // draw pads
-  foreach (const BI_FootprintPad* pad, footprint.getPads()) {
-    drawFootprintPad(gen, *pad, layerName);
-  }
-
-  // draw polygons
-  for (const Polygon& polygon :
-       footprint.getLibFootprint().getPolygons().sortedByUuid()) {
-    QString layer = footprint.getIsMirrored()
-                        ? GraphicsLayer::getMirroredLayerName(layerName)
-                        : layerName;
-    if (layer == polygon.getLayerName()) {
-      Path path = polygon.getPath();
-      path.rotate(footprint.getRotation());
-      if (footprint.getIsMirrored()) path.mirror(Qt::Horizontal);
-      path.translate(footprint.getPosition());
-      gen.drawPathOutline(path,
-                          calcWidthOfLayer(polygon.getLineWidth(), layer));
-      if (polygon.isFilled()) {
-        gen.drawPathArea(path);
-      }
-    }
-  }
-
-  // draw circles
-  for (const Circle& circle :
-       footprint.getLibFootprint().getCircles().sortedByUuid()) {
-    QString layer = footprint.getIsMirrored()
-                        ? GraphicsLayer::getMirroredLayerName(layerName)
-                        : layerName;
-    if (layer == circle.getLayerName()) {
-      Circle e = circle;
-      if (footprint.getIsMirrored())
-        e.setCenter(e.getCenter().mirrored(Qt::Horizontal));
-      e.translate(footprint.getPosition());
-      e.setLineWidth(calcWidthOfLayer(e.getLineWidth(), layer));
-      gen.drawCircleOutline(e);
-      if (e.isFilled()) {
-        gen.drawCircleArea(e);
-      }
-    }
-  }
-
-  // draw stroke texts (from footprint instance, *NOT* from library footprint!)
-  foreach (const BI_StrokeText* text,
-           sortedByUuid(footprint.getStrokeTexts())) {
-    if (layerName == text->getText().getLayerName()) {
-      UnsignedLength lineWidth =
-          calcWidthOfLayer(text->getText().getStrokeWidth(), layerName);
-      foreach (Path path, text->getText().getPaths()) {
-        path.rotate(text->getText().getRotation());
-        if (text->getText().getMirrored()) path.mirror(Qt::Horizontal);
-        path.translate(text->getPosition());
-        gen.drawPathOutline(path, lineWidth);
-      }
-    }
-  }
+bool BoardGerberExport::exportLayerSilkscreen(
+    const FilePath& fp, const BoardCamSnapshot& snapshot,
+    const GerberHeader& header, const QStringList& layerNames,
+    const QString& stopMaskLayerName) const {
+  GerberGenerator gen(header.projName, header.projUuid, header.projRevision);
+  foreach (const QString& layer, layerNames) { snapshot.drawLayer(gen, layer); }
+  gen.setLayerPolarity(GerberGenerator::LayerPolarity::Negative);
+  snapshot.drawLayer(gen, stopMaskLayerName);
+  gen.saveToFile(fp);
+  return true;
 }
 
-void BoardGerberExport::drawFootprintPad(GerberGenerator&       gen,
-                                         const BI_FootprintPad& pad,
-                                         const QString& layerName) const {
-  bool isSmt =
-      pad.getLibPad().getBoardSide() != library::FootprintPad::BoardSide::THT;
-  bool isOnCopperLayer   = pad.isOnLayer(layerName);
-  bool isOnSolderMaskTop = pad.isOnLayer(GraphicsLayer::sTopCopper) &&
-                           (layerName == GraphicsLayer::sTopStopMask);
-  bool isOnSolderMaskBottom = pad.isOnLayer(GraphicsLayer::sBotCopper) &&
-                              (layerName == GraphicsLayer::sBotStopMask);
-  bool isOnSolderPasteTop = isSmt && pad.isOnLayer(GraphicsLayer::sTopCopper) &&
-                            (layerName == GraphicsLayer::sTopSolderPaste);
-  bool isOnSolderPasteBottom = isSmt &&
-                               pad.isOnLayer(GraphicsLayer::sBotCopper) &&
-                               (layerName == GraphicsLayer::sBotSolderPaste);
-  if (!isOnCopperLayer && !isOnSolderMaskTop && !isOnSolderMaskBottom &&
-      !isOnSolderPasteTop && !isOnSolderPasteBottom) {
-    return;
-  }
-
-  Angle rot = pad.getIsMirrored() ? -pad.getRotation() : pad.getRotation();
-  const library::FootprintPad& libPad = pad.getLibPad();
-  Length                       width  = *libPad.getWidth();
-  Length                       height = *libPad.getHeight();
-  if (isOnSolderMaskTop || isOnSolderMaskBottom) {
-    Length         size = qMin(width, height);
-    UnsignedLength clearance =
-        mBoard.getDesignRules().calcStopMaskClearance(size);
-    width += clearance * 2;
-    height += clearance * 2;
-  } else if (isOnSolderPasteTop || isOnSolderPasteBottom) {
-    Length size      = qMin(width, height);
-    Length clearance = -mBoard.getDesignRules().calcCreamMaskClearance(size);
-    width += clearance * 2;
-    height += clearance * 2;
-  }
-
-  if ((width <= 0) || (height <= 0)) {
-    qWarning() << "Pad with zero size ignored in gerber export:"
-               << pad.getLibPadUuid();
-    return;
-  }
-
-  UnsignedLength uWidth(width);
-  UnsignedLength uHeight(height);
-
-  switch (libPad.getShape()) {
-    case library::FootprintPad::Shape::ROUND: {
-      if (width == height) {
-        gen.flashCircle(pad.getPosition(), uWidth, UnsignedLength(0));
-      } else {
-        gen.flashObround(pad.getPosition(), uWidth, uHeight, rot,
-                         UnsignedLength(0));
-      }
-      break;
-    }
-    case library::FootprintPad::Shape::RECT: {
-      gen.flashRect(pad.getPosition(), uWidth, uHeight, rot, UnsignedLength(0));
-      break;
-    }
-    case library::FootprintPad::Shape::OCTAGON: {
-      if (width != height) {
-        throw LogicError(
-            __FILE__, __LINE__,
-            tr("Sorry, non-square octagons are not yet supported."));
-      }
-      gen.flashRegularPolygon(pad.getPosition(), uWidth, 8, rot,
-                              UnsignedLength(0));
-      break;
-    }
-    default: { throw LogicError(__FILE__, __LINE__); }
+void BoardGerberExport::drawDrills(
+    ExcellonGenerator& gen, const QVector<BoardCamSnapshot::Drill>& drills) {
+  foreach (const BoardCamSnapshot::Drill& drill, drills) {
+    gen.drill(drill.position, PositiveLength(drill.diameter));  // can throw
   }
 }
 
@@ -608,14 +298,12 @@ FilePath BoardGerberExport::getOutputFilePath(const QString& suffix) const
  *  Static Methods
  ******************************************************************************/
 
-UnsignedLength BoardGerberExport::calcWidthOfLayer(
-    const UnsignedLength& width, const QString& name) noexcept {
-  if ((name == GraphicsLayer::sBoardOutlines) &&
-      (width < UnsignedLength(1000))) {
-    return UnsignedLength(1000);  // outlines should have a minimum width of 1um
-  } else {
-    return width;
-  }
+QStringList BoardGerberExport::getLayerNames(
+    const QVector<Job>& jobs) noexcept {
+  QStringList names;
+  foreach (const Job& job, jobs) { names += job.layerNames; }
+  names.removeDuplicates();
+  return names;
 }
 
 /*******************************************************************************
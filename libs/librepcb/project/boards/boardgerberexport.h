@@ -23,29 +23,28 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include "boardcamsnapshot.h"
+
 #include <librepcb/common/attributes/attributeprovider.h>
 #include <librepcb/common/fileio/filepath.h>
 #include <librepcb/common/units/all_length_units.h>
+#include <librepcb/common/uuid.h>
 
 #include <QtCore>
 
+#include <functional>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
 namespace librepcb {
 
-class Polygon;
-class Circle;
 class ExcellonGenerator;
-class GerberGenerator;
 
 namespace project {
 
 class Project;
 class Board;
-class BI_Via;
-class BI_Footprint;
-class BI_FootprintPad;
 
 /*******************************************************************************
  *  Class BoardGerberExport
@@ -76,6 +75,18 @@ public:
   // General Methods
   void exportAllLayers() const;
 
+  /**
+   * @brief Export all layers with one worker thread per output file
+   *
+   * Generates exactly the same files as #exportAllLayers(), but each file is
+   * generated on the global thread pool from a shared BoardCamSnapshot. The
+   * board itself is only accessed in the calling thread.
+   *
+   * @throw Exception   The first exception of all files, in the same order
+   *                    as #exportAllLayers() would throw it.
+   */
+  void exportAllLayersConcurrently() const;
+
   // Inherited from AttributeProvider
   /// @copydoc librepcb::AttributeProvider::getBuiltInAttributeValue()
   QString getBuiltInAttributeValue(const QString& key) const noexcept override;
@@ -90,45 +101,42 @@ signals:
   void attributesChanged() override;
 
 private:
-  // Private Methods
-  void exportDrills() const;
-  void exportDrillsNpth() const;
-  void exportDrillsPth() const;
-  void exportLayerBoardOutlines() const;
-  void exportLayerTopCopper() const;
-  void exportLayerInnerCopper() const;
-  void exportLayerBottomCopper() const;
-  void exportLayerTopSolderMask() const;
-  void exportLayerBottomSolderMask() const;
-  void exportLayerTopSilkscreen() const;
-  void exportLayerBottomSilkscreen() const;
-  void exportLayerTopSolderPaste() const;
-  void exportLayerBottomSolderPaste() const;
-
-  int  drawNpthDrills(ExcellonGenerator& gen) const;
-  int  drawPthDrills(ExcellonGenerator& gen) const;
-  void drawLayer(GerberGenerator& gen, const QString& layerName) const;
-  void drawVia(GerberGenerator& gen, const BI_Via& via,
-               const QString& layerName) const;
-  void drawFootprint(GerberGenerator& gen, const BI_Footprint& footprint,
-                     const QString& layerName) const;
-  void drawFootprintPad(GerberGenerator& gen, const BI_FootprintPad& pad,
-                        const QString& layerName) const;
+  // Types
+
+  /// Project information written into the header of every Gerber file
+  struct GerberHeader {
+    QString projName;
+    Uuid    projUuid;
+    QString projRevision;
+  };
+
+  /// A single output file, independent of all other output files
+  struct Job {
+    FilePath    filePath;
+    QStringList layerNames;  ///< Layers needed from the snapshot
+    std::function<bool(const FilePath&, const BoardCamSnapshot&)> generate;
+  };
 
+  // Private Methods
+  QVector<Job> createJobs() const;
+  bool exportDrills(const FilePath& fp, const BoardCamSnapshot& snapshot) const;
+  bool exportDrillsNpth(const FilePath&         fp,
+                        const BoardCamSnapshot& snapshot) const;
+  bool exportDrillsPth(const FilePath&         fp,
+                       const BoardCamSnapshot& snapshot) const;
+  bool exportLayer(const FilePath& fp, const BoardCamSnapshot& snapshot,
+                   const GerberHeader& header, const QString& layerName) const;
+  bool exportLayerSilkscreen(const FilePath&         fp,
+                             const BoardCamSnapshot& snapshot,
+                             const GerberHeader&     header,
+                             const QStringList&      layerNames,
+                             const QString&          stopMaskLayerName) const;
   FilePath getOutputFilePath(const QString& suffix) const noexcept;
 
   // Static Methods
-  static UnsignedLength calcWidthOfLayer(const UnsignedLength& width,
-                                         const QString&        name) noexcept;
-  template <typename T>
-  static QList<T*> sortedByUuid(const QList<T*>& list) noexcept {
-    // sort a list of objects by their UUID to get reproducable gerber files
-    QList<T*> copy = list;
-    qSort(copy.begin(), copy.end(), [](const T* o1, const T* o2) {
-      return o1->getUuid() < o2->getUuid();
-    });
-    return copy;
-  }
+  static void drawDrills(ExcellonGenerator&                      gen,
+                         const QVector<BoardCamSnapshot::Drill>& drills);
+  static QStringList getLayerNames(const QVector<Job>& jobs) noexcept;
 
   // Private Member Variables
   const Project&            mProject;
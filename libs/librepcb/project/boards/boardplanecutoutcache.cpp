@@ -0,0 +1,163 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boardplanecutoutcache.h"
+
+#include <librepcb/common/utils/clipperhelpers.h>
+#include <librepcb/library/pkg/footprintpad.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*******************************************************************************
+ *  Class BoardPlaneCutOutCache::Key
+ ******************************************************************************/
+
+bool BoardPlaneCutOutCache::Key::operator==(const Key& rhs) const noexcept {
+  return (via == rhs.via) && (shape == rhs.shape) && (width == rhs.width) &&
+         (height == rhs.height) && (rotation == rhs.rotation) &&
+         (mirrored == rhs.mirrored) && (expansion == rhs.expansion) &&
+         (maxArcTolerance == rhs.maxArcTolerance);
+}
+
+uint qHash(const BoardPlaneCutOutCache::Key& key, uint seed) noexcept {
+  int flags = (key.shape << 2) | (key.via ? 2 : 0) | (key.mirrored ? 1 : 0);
+  seed      = ::qHash(flags, seed);
+  seed      = ::qHash(key.width, seed);
+  seed      = ::qHash(key.height, seed);
+  seed      = ::qHash(key.rotation, seed);
+  seed      = ::qHash(key.expansion, seed);
+  return ::qHash(key.maxArcTolerance, seed);
+}
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BoardPlaneCutOutCache::BoardPlaneCutOutCache() noexcept
+  : mHitCount(0), mMissCount(0) {
+}
+
+BoardPlaneCutOutCache::~BoardPlaneCutOutCache() noexcept {
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+int BoardPlaneCutOutCache::getCount() const noexcept {
+  QMutexLocker lock(&mMutex);
+  return mOutlines.count();
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+ClipperLib::Path BoardPlaneCutOutCache::getPadOutline(
+    const library::FootprintPad& pad, const Angle& rotation, bool mirrored,
+    const Length& expansion, const PositiveLength& maxArcTolerance,
+    const Point& position) noexcept {
+  Key key{false,
+          static_cast<int>(pad.getShape()),
+          pad.getWidth()->toNm(),
+          pad.getHeight()->toNm(),
+          rotation.toMicroDeg(),
+          mirrored,
+          expansion.toNm(),
+          maxArcTolerance->toNm()};
+  return get(key, position, [&]() {
+    return ClipperHelpers::convert(pad.getOutline(expansion).rotated(rotation),
+                                   maxArcTolerance);
+  });
+}
+
+ClipperLib::Path BoardPlaneCutOutCache::getViaOutline(
+    BI_Via::Shape shape, const PositiveLength& size, const Length& expansion,
+    const PositiveLength& maxArcTolerance, const Point& position) noexcept {
+  Key key{true,
+          static_cast<int>(shape),
+          size->toNm(),
+          size->toNm(),
+          0,
+          false,
+          expansion.toNm(),
+          maxArcTolerance->toNm()};
+  return get(key, position, [&]() {
+    return ClipperHelpers::convert(BI_Via::getOutline(shape, size, expansion),
+                                   maxArcTolerance);
+  });
+}
+
+void BoardPlaneCutOutCache::clear() noexcept {
+  QMutexLocker lock(&mMutex);
+  mOutlines.clear();
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+template <typename Func>
+ClipperLib::Path BoardPlaneCutOutCache::get(const Key& key,
+                                            const Point& position,
+                                            Func createOutline) noexcept {
+  {
+    QMutexLocker lock(&mMutex);
+    auto         it = mOutlines.constFind(key);
+    if (it != mOutlines.constEnd()) {
+      ++mHitCount;
+      return translated(*it, position);
+    }
+  }
+
+  // flatten the outline without holding the lock, it's the expensive part
+  ClipperLib::Path outline = createOutline();
+  ++mMissCount;
+  {
+    QMutexLocker lock(&mMutex);
+    mOutlines.insert(key, outline);
+  }
+  return translated(outline, position);
+}
+
+ClipperLib::Path BoardPlaneCutOutCache::translated(
+    const ClipperLib::Path& path, const Point& offset) noexcept {
+  ClipperLib::Path result = path;
+  for (ClipperLib::IntPoint& p : result) {
+    p.X += offset.getX().toNm();
+    p.Y += offset.getY().toNm();
+  }
+  return result;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
@@ -0,0 +1,123 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDPLANECUTOUTCACHE_H
+#define LIBREPCB_PROJECT_BOARDPLANECUTOUTCACHE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "items/bi_via.h"
+
+#include <clipper/clipper.hpp>
+#include <librepcb/common/units/all_length_units.h>
+
+#include <QtCore>
+
+#include <atomic>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+namespace library {
+class FootprintPad;
+}
+
+namespace project {
+
+/*******************************************************************************
+ *  Class BoardPlaneCutOutCache
+ ******************************************************************************/
+
+/**
+ * @brief Thread-safe cache of flattened pad and via outlines for planes
+ *
+ * The outlines only depend on the shape, size, rotation and clearance of pads
+ * and vias, but not on their position. So all instances of the same library
+ * pad (e.g. all footprints of the same package) and all vias of the same size
+ * share the same cached outline, which only needs to be translated to the
+ * position of each instance.
+ */
+class BoardPlaneCutOutCache final {
+public:
+  // Constructors / Destructor
+  BoardPlaneCutOutCache() noexcept;
+  BoardPlaneCutOutCache(const BoardPlaneCutOutCache& other) = delete;
+  ~BoardPlaneCutOutCache() noexcept;
+
+  // Getters
+  int getCount() const noexcept;
+  int getHitCount() const noexcept { return mHitCount.load(); }
+  int getMissCount() const noexcept { return mMissCount.load(); }
+
+  // General Methods
+  ClipperLib::Path getPadOutline(const library::FootprintPad& pad,
+                                 const Angle& rotation, bool mirrored,
+                                 const Length&         expansion,
+                                 const PositiveLength& maxArcTolerance,
+                                 const Point&          position) noexcept;
+  ClipperLib::Path getViaOutline(BI_Via::Shape         shape,
+                                 const PositiveLength& size,
+                                 const Length&         expansion,
+                                 const PositiveLength& maxArcTolerance,
+                                 const Point&          position) noexcept;
+  void             clear() noexcept;
+
+  // Operator Overloadings
+  BoardPlaneCutOutCache& operator=(const BoardPlaneCutOutCache& rhs) = delete;
+
+private:  // Types
+  struct Key {
+    bool         via;
+    int          shape;
+    LengthBase_t width;
+    LengthBase_t height;
+    qint32       rotation;  ///< [µdeg]
+    bool         mirrored;
+    LengthBase_t expansion;
+    LengthBase_t maxArcTolerance;
+
+    bool operator==(const Key& rhs) const noexcept;
+  };
+  friend uint qHash(const Key& key, uint seed) noexcept;
+
+private:  // Methods
+  template <typename Func>
+  ClipperLib::Path get(const Key& key, const Point& position,
+                       Func createOutline) noexcept;
+  static ClipperLib::Path translated(const ClipperLib::Path& path,
+                                     const Point&            offset) noexcept;
+
+private:  // Data
+  mutable QMutex               mMutex;
+  QHash<Key, ClipperLib::Path> mOutlines;  ///< Outlines at origin
+  std::atomic<int>             mHitCount;
+  std::atomic<int>             mMissCount;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
+
+#endif  // LIBREPCB_PROJECT_BOARDPLANECUTOUTCACHE_H
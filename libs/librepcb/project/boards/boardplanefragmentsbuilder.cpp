@@ -22,6 +22,9 @@
  ******************************************************************************/
 #include "boardplanefragmentsbuilder.h"
 
+#include "../circuit/netsignal.h"
+#include "board.h"
+#include "boardplanecutoutcache.h"
 #include "items/bi_device.h"
 #include "items/bi_footprint.h"
 #include "items/bi_footprintpad.h"
@@ -34,24 +37,71 @@
 #include "items/bi_via.h"
 
 #include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/scopeguard.h>
 #include <librepcb/common/utils/clipperhelpers.h>
 #include <librepcb/library/pkg/footprint.h>
 #include <librepcb/library/pkg/footprintpad.h>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 
+#include <algorithm>
+#include <cmath>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
 namespace librepcb {
 namespace project {
 
+/*******************************************************************************
+ *  Class BoardPlaneFragmentsBuilder::Snapshot
+ ******************************************************************************/
+
+bool BoardPlaneFragmentsBuilder::Snapshot::Pad::isOnLayer(
+    const QString& layerName) const noexcept {
+  if (mirrored) {
+    return libPad->isOnLayer(GraphicsLayer::getMirroredLayerName(layerName));
+  } else {
+    return libPad->isOnLayer(layerName);
+  }
+}
+
+Path BoardPlaneFragmentsBuilder::Snapshot::Pad::getSceneOutline(
+    const Length& expansion) const noexcept {
+  return libPad->getOutline(expansion).rotated(rotation).translated(position);
+}
+
+Path BoardPlaneFragmentsBuilder::Snapshot::Via::getSceneOutline(
+    const Length& expansion) const noexcept {
+  return BI_Via::getOutline(shape, size, expansion).translated(position);
+}
+
+Path BoardPlaneFragmentsBuilder::Snapshot::NetLine::getSceneOutline(
+    const Length& expansion) const noexcept {
+  Length w = width + (expansion * 2);
+  if (w > 0) {
+    return Path::obround(startPoint, endPoint, PositiveLength(w));
+  } else {
+    return Path();
+  }
+}
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
 
-BoardPlaneFragmentsBuilder::BoardPlaneFragmentsBuilder(BI_Plane& plane) noexcept
-  : mPlane(plane) {
+BoardPlaneFragmentsBuilder::BoardPlaneFragmentsBuilder(
+    const Snapshot& snapshot, int planeIndex, const PlaneCache* cache,
+    const std::atomic_bool* abort) noexcept
+  : mSnapshot(snapshot),
+    mPlane(snapshot.planes.at(planeIndex)),
+    mPlaneIndex(planeIndex),
+    mCache(cache),
+    mAbort(abort),
+    mTilingEnabled(false),
+    mCutOutCache(nullptr),
+    mDirtyTileCount(-1) {
 }
 
 BoardPlaneFragmentsBuilder::~BoardPlaneFragmentsBuilder() noexcept {
@@ -64,47 +114,158 @@ BoardPlaneFragmentsBuilder::~BoardPlaneFragmentsBuilder() noexcept {
 QVector<Path> BoardPlaneFragmentsBuilder::buildFragments() noexcept {
   try {
     mResult.clear();
+    mConnectedNetSignalAreas.clear();
+    mObstacles.clear();
+    mSortedObstacles.clear();
+    mNewCache.reset();
+    mDirtyTileCount = -1;
     addPlaneOutline();
     clipToBoardOutline();
-    subtractOtherObjects();
-    ensureMinimumWidth();
+    collectObstacles();
+    if (!rebuildDirtyTiles()) {
+      if ((!mTilingEnabled) || (!subtractObstaclesInTiles())) {
+        subtractObstacles();
+      }
+      ensureMinimumWidth(mResult);
+    }
+    updateCache();
     flattenResult();
-    if (!mPlane.getKeepOrphans()) {
+    if (!mPlane.keepOrphans) {
       removeOrphans();
     }
     return ClipperHelpers::convert(mResult);
+  } catch (const UserCanceled&) {
+    return QVector<Path>();
   } catch (const Exception& e) {
     qCritical() << "Failed to build plane fragments! Leave plane empty...";
     qCritical() << "Inner error message:" << e.getMsg();
+    mNewCache.reset();  // enforce a full rebuild next time
     return QVector<Path>();
   }
 }
 
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+BoardPlaneFragmentsBuilder::Snapshot BoardPlaneFragmentsBuilder::takeSnapshot(
+    const Board& board) noexcept {
+  Snapshot snapshot;
+
+  // planes, sorted by priority (highest priority first)
+  QList<BI_Plane*> planes = board.getPlanes();
+  qSort(planes.begin(), planes.end(),
+        [](const BI_Plane* p1, const BI_Plane* p2) { return !(*p1 < *p2); });
+  foreach (const BI_Plane* plane, planes) {
+    snapshot.planes.push_back(Snapshot::Plane{
+        plane->getUuid(), &plane->getNetSignal(), *plane->getLayerName(),
+        plane->getOutline(), plane->getMinWidth(), plane->getMinClearance(),
+        plane->getKeepOrphans(), plane->getConnectStyle(),
+        plane->getFragments()});
+  }
+
+  // board outlines
+  foreach (const BI_Polygon* polygon, board.getPolygons()) {
+    if (polygon->getPolygon().getLayerName() == GraphicsLayer::sBoardOutlines) {
+      snapshot.boardOutlines.append(polygon->getPolygon().getPath());
+    }
+  }
+
+  // holes and pads of devices (library pads are shared between instances)
+  QHash<const library::FootprintPad*,
+        std::shared_ptr<const library::FootprintPad>>
+      libPads;
+  foreach (const BI_Device* device, board.getDeviceInstances()) {
+    const BI_Footprint& footprint = device->getFootprint();
+    for (const Hole& hole : footprint.getLibFootprint().getHoles()) {
+      snapshot.holes.push_back(Snapshot::Hole{
+          footprint.mapToScene(hole.getPosition()), hole.getDiameter()});
+    }
+    foreach (const BI_FootprintPad* pad, footprint.getPads()) {
+      std::shared_ptr<const library::FootprintPad>& libPad =
+          libPads[&pad->getLibPad()];
+      if (!libPad) {
+        libPad = std::make_shared<library::FootprintPad>(pad->getLibPad());
+      }
+      snapshot.pads.push_back(
+          Snapshot::Pad{libPad, pad->getCompSigInstNetSignal(),
+                        pad->getPosition(), pad->getRotation(),
+                        pad->getIsMirrored()});
+    }
+  }
+
+  // board holes
+  foreach (const BI_Hole* hole, board.getHoles()) {
+    snapshot.holes.push_back(Snapshot::Hole{hole->getHole().getPosition(),
+                                            hole->getHole().getDiameter()});
+  }
+
+  // vias and netlines
+  foreach (const BI_NetSegment* netsegment, board.getNetSegments()) {
+    const NetSignal* netsignal = &netsegment->getNetSignal();
+    foreach (const BI_Via* via, netsegment->getVias()) {
+      snapshot.vias.push_back(Snapshot::Via{netsignal, via->getPosition(),
+                                            via->getShape(), via->getSize()});
+    }
+    foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
+      snapshot.netLines.push_back(Snapshot::NetLine{
+          netsignal, netline->getLayer().getName(),
+          netline->getStartPoint().getPosition(),
+          netline->getEndPoint().getPosition(), netline->getWidth()});
+    }
+  }
+
+  return snapshot;
+}
+
+bool BoardPlaneFragmentsBuilder::buildAllFragments(
+    Snapshot& snapshot, Cache* cache, const std::atomic_bool* abort,
+    bool tiling, BoardPlaneCutOutCache* cutOutCache) noexcept {
+  Cache newCache;
+  for (std::size_t i = 0; i < snapshot.planes.size(); ++i) {
+    const Uuid&                       uuid = snapshot.planes[i].uuid;
+    std::shared_ptr<const PlaneCache> planeCache;
+    if (cache) {
+      planeCache = cache->value(uuid);
+    }
+    BoardPlaneFragmentsBuilder builder(snapshot, static_cast<int>(i),
+                                       planeCache.get(), abort);
+    builder.setTilingEnabled(tiling);
+    builder.setCutOutCache(cutOutCache);
+    QVector<Path> fragments = builder.buildFragments();
+    if (abort && abort->load()) {
+      return false;
+    }
+    snapshot.planes[i].fragments = fragments;
+    if (cache && builder.getCache()) {
+      newCache.insert(uuid, builder.getCache());
+    }
+  }
+  if (cache) *cache = newCache;  // drops entries of removed planes
+  return true;
+}
+
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
 void BoardPlaneFragmentsBuilder::addPlaneOutline() {
-  mResult.push_back(
-      ClipperHelpers::convert(mPlane.getOutline(), maxArcTolerance()));
+  mResult.push_back(ClipperHelpers::convert(mPlane.outline, maxArcTolerance()));
 }
 
 void BoardPlaneFragmentsBuilder::clipToBoardOutline() {
   // determine board area
   ClipperLib::Paths   boardArea;
   ClipperLib::Clipper boardAreaClipper;
-  foreach (const BI_Polygon* polygon, mPlane.getBoard().getPolygons()) {
-    if (polygon->getPolygon().getLayerName() == GraphicsLayer::sBoardOutlines) {
-      ClipperLib::Path path = ClipperHelpers::convert(
-          polygon->getPolygon().getPath(), maxArcTolerance());
-      boardAreaClipper.AddPath(path, ClipperLib::ptSubject, true);
-    }
+  foreach (const Path& outline, mSnapshot.boardOutlines) {
+    ClipperLib::Path path = ClipperHelpers::convert(outline, maxArcTolerance());
+    boardAreaClipper.AddPath(path, ClipperLib::ptSubject, true);
   }
   boardAreaClipper.Execute(ClipperLib::ctXor, boardArea, ClipperLib::pftEvenOdd,
                            ClipperLib::pftEvenOdd);
 
   // perform clearance offset
-  ClipperHelpers::offset(boardArea, -mPlane.getMinClearance(),
+  ClipperHelpers::offset(boardArea, -mPlane.minClearance,
                          maxArcTolerance());  // can throw
 
   // if we have no board area, abort here
@@ -118,93 +279,261 @@ void BoardPlaneFragmentsBuilder::clipToBoardOutline() {
                ClipperLib::pftNonZero);
 }
 
-void BoardPlaneFragmentsBuilder::subtractOtherObjects() {
-  ClipperLib::Clipper c;
-  c.AddPaths(mResult, ClipperLib::ptSubject, true);
+void BoardPlaneFragmentsBuilder::collectObstacles() {
+  mArea = mResult;
 
-  // subtract other planes
-  foreach (const BI_Plane* plane, mPlane.getBoard().getPlanes()) {
-    if (plane == &mPlane) continue;
-    if (*plane < mPlane) continue;  // ignore planes with lower priority
-    if (plane->getLayerName() != mPlane.getLayerName()) continue;
-    if (&plane->getNetSignal() == &mPlane.getNetSignal()) continue;
+  // other planes (only those with higher priority, i.e. which were built
+  // before this plane)
+  for (int i = 0; i < mPlaneIndex; ++i) {
+    const Snapshot::Plane& plane = mSnapshot.planes.at(i);
+    if (plane.layerName != mPlane.layerName) continue;
+    if (plane.netSignal == mPlane.netSignal) continue;
     ClipperLib::Paths paths =
-        ClipperHelpers::convert(plane->getFragments(), maxArcTolerance());
-    ClipperHelpers::offset(paths, *mPlane.getMinClearance(),
+        ClipperHelpers::convert(plane.fragments, maxArcTolerance());
+    ClipperHelpers::offset(paths, *mPlane.minClearance,
                            maxArcTolerance());  // can throw
-    c.AddPaths(paths, ClipperLib::ptClip, true);
-  }
-
-  // subtract holes and pads from devices
-  foreach (const BI_Device* device, mPlane.getBoard().getDeviceInstances()) {
-    for (const Hole& hole :
-         device->getFootprint().getLibFootprint().getHoles()) {
-      Point pos = device->getFootprint().mapToScene(hole.getPosition());
-      PositiveLength dia(hole.getDiameter() + mPlane.getMinClearance() * 2);
-      Path           path = Path::circle(dia).translated(pos);
-      c.AddPath(ClipperHelpers::convert(path, maxArcTolerance()),
-                ClipperLib::ptClip, true);
+    for (const ClipperLib::Path& path : paths) {
+      addObstacle(path);
+    }
+  }
+  throwIfAborted();
+
+  // holes
+  for (const Snapshot::Hole& hole : mSnapshot.holes) {
+    PositiveLength dia(hole.diameter + mPlane.minClearance * 2);
+    Path           path = Path::circle(dia).translated(hole.position);
+    addObstacle(ClipperHelpers::convert(path, maxArcTolerance()));
+  }
+  throwIfAborted();
+
+  // pads
+  for (const Snapshot::Pad& pad : mSnapshot.pads) {
+    if (!pad.isOnLayer(mPlane.layerName)) continue;
+    if (pad.netSignal == mPlane.netSignal) {
+      mConnectedNetSignalAreas.push_back(getPadOutline(pad, Length(0)));
+    }
+    addObstacle(createPadCutOut(pad));
+  }
+  throwIfAborted();
+
+  // vias
+  for (const Snapshot::Via& via : mSnapshot.vias) {
+    if (via.netSignal == mPlane.netSignal) {
+      mConnectedNetSignalAreas.push_back(getViaOutline(via, Length(0)));
+    }
+    addObstacle(createViaCutOut(via));
+  }
+  throwIfAborted();
+
+  // netlines
+  for (const Snapshot::NetLine& netline : mSnapshot.netLines) {
+    if (netline.layerName != mPlane.layerName) continue;
+    if (netline.netSignal == mPlane.netSignal) {
+      ClipperLib::Path path =
+          ClipperHelpers::convert(netline.getSceneOutline(), maxArcTolerance());
+      mConnectedNetSignalAreas.push_back(path);
+    } else {
+      addObstacle(ClipperHelpers::convert(
+          netline.getSceneOutline(*mPlane.minClearance), maxArcTolerance()));
+    }
+  }
+  throwIfAborted();
+}
+
+bool BoardPlaneFragmentsBuilder::rebuildDirtyTiles() {
+  if ((!mCache) || (mCache->area != mArea) ||
+      (mCache->minWidth != *mPlane.minWidth)) {
+    return false;  // no (valid) cache available, full rebuild required
+  }
+
+  // determine added, removed and modified obstacles
+  sortObstacles();
+  std::vector<ClipperLib::Path> changed;
+  std::set_symmetric_difference(
+      mCache->obstacles.begin(), mCache->obstacles.end(),
+      mSortedObstacles.begin(), mSortedObstacles.end(),
+      std::back_inserter(changed), &BoardPlaneFragmentsBuilder::lessThan);
+
+  // Determine the dirty tiles. Changed obstacles modify the raw area only
+  // within their bounds, but the minimum width of the area within a distance
+  // of the minimum width around them.
+  ClipperLib::cInt    margin = mPlane.minWidth->toNm() + 2 * sTileOverlap;
+  ClipperLib::IntRect bounds = getBounds(mArea);
+  qint64 maxTiles = ((bounds.right - bounds.left) / sTileSize + 1) *
+                    ((bounds.bottom - bounds.top) / sTileSize + 1) / 2;
+  QSet<QPair<ClipperLib::cInt, ClipperLib::cInt>> tiles;
+  for (const ClipperLib::Path& path : changed) {
+    ClipperLib::IntRect r  = getBounds(path);
+    ClipperLib::cInt    x0 = std::floor((r.left - margin) / qreal(sTileSize));
+    ClipperLib::cInt    x1 = std::floor((r.right + margin) / qreal(sTileSize));
+    ClipperLib::cInt    y0 = std::floor((r.top - margin) / qreal(sTileSize));
+    ClipperLib::cInt    y1 = std::floor((r.bottom + margin) / qreal(sTileSize));
+    if ((x1 - x0 + 1) * (y1 - y0 + 1) > maxTiles) {
+      return false;  // a full rebuild is cheaper
     }
-    foreach (const BI_FootprintPad* pad, device->getFootprint().getPads()) {
-      if (!pad->isOnLayer(*mPlane.getLayerName())) continue;
-      if (pad->getCompSigInstNetSignal() == &mPlane.getNetSignal()) {
-        ClipperLib::Path path =
-            ClipperHelpers::convert(pad->getSceneOutline(), maxArcTolerance());
-        mConnectedNetSignalAreas.push_back(path);
+    for (ClipperLib::cInt x = x0; x <= x1; ++x) {
+      for (ClipperLib::cInt y = y0; y <= y1; ++y) {
+        tiles.insert(qMakePair(x, y));
       }
-      c.AddPath(createPadCutOut(*pad), ClipperLib::ptClip, true);
+    }
+    if (tiles.count() > maxTiles) {
+      return false;  // a full rebuild is cheaper
     }
   }
+  mDirtyTileCount = tiles.count();
+  if (tiles.isEmpty()) {
+    mRaw    = mCache->raw;
+    mResult = mCache->opened;
+    return true;
+  }
 
-  // subtract board holes
-  for (const BI_Hole* hole : mPlane.getBoard().getHoles()) {
-    PositiveLength dia(hole->getHole().getDiameter() +
-                       mPlane.getMinClearance() * 2);
-    Path path = Path::circle(dia).translated(hole->getHole().getPosition());
-    c.AddPath(ClipperHelpers::convert(path, maxArcTolerance()),
-              ClipperLib::ptClip, true);
+  // The region to replace, a slightly larger region to overlap with the
+  // cached area (avoids gaps due to rounding) and the region to rebuild.
+  ClipperLib::Paths region, overlapRegion, rebuildRegion;
+  foreach (const auto& tile, tiles) {
+    region.push_back(createTile(tile.first, tile.second, 0, sTileSize));
+    overlapRegion.push_back(
+        createTile(tile.first, tile.second, sTileOverlap, sTileSize));
+    rebuildRegion.push_back(
+        createTile(tile.first, tile.second, margin, sTileSize));
   }
+  region        = clip(region, ClipperLib::Paths(), ClipperLib::ctUnion);
+  overlapRegion = clip(overlapRegion, ClipperLib::Paths(), ClipperLib::ctUnion);
+  rebuildRegion = clip(rebuildRegion, ClipperLib::Paths(), ClipperLib::ctUnion);
+  throwIfAborted();
 
-  // subtract net segment items
-  foreach (const BI_NetSegment* netsegment,
-           mPlane.getBoard().getNetSegments()) {
-    // subtract vias
-    foreach (const BI_Via* via, netsegment->getVias()) {
-      if (&netsegment->getNetSignal() == &mPlane.getNetSignal()) {
-        ClipperLib::Path path =
-            ClipperHelpers::convert(via->getSceneOutline(), maxArcTolerance());
-        mConnectedNetSignalAreas.push_back(path);
+  // rebuild the raw area within the rebuild region
+  ClipperLib::IntRect rebuildBounds = getBounds(rebuildRegion);
+  ClipperLib::Clipper c;
+  c.AddPaths(clip(mArea, rebuildRegion, ClipperLib::ctIntersection),
+             ClipperLib::ptSubject, true);
+  for (const ClipperLib::Path& path : mObstacles) {
+    ClipperLib::IntRect r = getBounds(path);
+    if ((r.right >= rebuildBounds.left) && (r.left <= rebuildBounds.right) &&
+        (r.bottom >= rebuildBounds.top) && (r.top <= rebuildBounds.bottom)) {
+      c.AddPath(path, ClipperLib::ptClip, true);
+    }
+  }
+  ClipperLib::Paths raw;
+  c.Execute(ClipperLib::ctDifference, raw, ClipperLib::pftEvenOdd,
+            ClipperLib::pftNonZero);
+  ClipperLib::Paths opened = raw;
+  ensureMinimumWidth(opened);
+  throwIfAborted();
+
+  // stitch the rebuilt tiles into the cached areas
+  mRaw = clip(clip(mCache->raw, region, ClipperLib::ctDifference),
+              clip(raw, overlapRegion, ClipperLib::ctIntersection),
+              ClipperLib::ctUnion);
+  mResult = clip(clip(mCache->opened, region, ClipperLib::ctDifference),
+                 clip(opened, overlapRegion, ClipperLib::ctIntersection),
+                 ClipperLib::ctUnion);
+  return true;
+}
+
+void BoardPlaneFragmentsBuilder::subtractObstacles() {
+  ClipperLib::Clipper c;
+  c.AddPaths(mArea, ClipperLib::ptSubject, true);
+  for (const ClipperLib::Path& path : mObstacles) {
+    c.AddPath(path, ClipperLib::ptClip, true);
+  }
+  c.Execute(ClipperLib::ctDifference, mResult, ClipperLib::pftEvenOdd,
+            ClipperLib::pftNonZero);
+  mRaw = mResult;
+}
+
+bool BoardPlaneFragmentsBuilder::subtractObstaclesInTiles() {
+  qreal               size    = sParallelTileSize;
+  ClipperLib::IntRect bounds  = getBounds(mArea);
+  ClipperLib::cInt    x0      = std::floor(bounds.left / size);
+  ClipperLib::cInt    x1      = std::floor(bounds.right / size);
+  ClipperLib::cInt    y0      = std::floor(bounds.top / size);
+  ClipperLib::cInt    y1      = std::floor(bounds.bottom / size);
+  int                 columns = static_cast<int>(x1 - x0 + 1);
+  int                 rows    = static_cast<int>(y1 - y0 + 1);
+  if (columns * rows < 2) {
+    return false;  // tiling not worth it
+  }
+
+  // assign obstacles to all tiles they intersect with
+  QVector<QVector<int>> tileObstacles(columns * rows);
+  for (int i = 0; i < static_cast<int>(mObstacles.size()); ++i) {
+    ClipperLib::IntRect r   = getBounds(mObstacles.at(i));
+    ClipperLib::cInt    ox0 = std::floor((r.left - sTileOverlap) / size);
+    ClipperLib::cInt    ox1 = std::floor((r.right + sTileOverlap) / size);
+    ClipperLib::cInt    oy0 = std::floor((r.top - sTileOverlap) / size);
+    ClipperLib::cInt    oy1 = std::floor((r.bottom + sTileOverlap) / size);
+    for (ClipperLib::cInt x = qMax(ox0, x0); x <= qMin(ox1, x1); ++x) {
+      for (ClipperLib::cInt y = qMax(oy0, y0); y <= qMin(oy1, y1); ++y) {
+        tileObstacles[(y - y0) * columns + (x - x0)].append(i);
       }
-      c.AddPath(createViaCutOut(*via), ClipperLib::ptClip, true);
     }
+  }
 
-    // subtract netlines
-    foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
-      if (netline->getLayer().getName() != mPlane.getLayerName()) continue;
-      if (&netsegment->getNetSignal() == &mPlane.getNetSignal()) {
-        ClipperLib::Path path = ClipperHelpers::convert(
-            netline->getSceneOutline(), maxArcTolerance());
-        mConnectedNetSignalAreas.push_back(path);
-      } else {
-        ClipperLib::Path path = ClipperHelpers::convert(
-            netline->getSceneOutline(*mPlane.getMinClearance()),
-            maxArcTolerance());
-        c.AddPath(path, ClipperLib::ptClip, true);
+  // clip all tiles in parallel, each overlapping its neighbors slightly
+  auto buildTile = [this, &tileObstacles, x0, y0, columns](int index) {
+    ClipperLib::Paths result;
+    if (mAbort && mAbort->load()) return result;
+    ClipperLib::cInt x    = x0 + (index % columns);
+    ClipperLib::cInt y    = y0 + (index / columns);
+    ClipperLib::Path tile = createTile(x, y, sTileOverlap, sParallelTileSize);
+    ClipperLib::Clipper c;
+    ClipperLib::Paths area =
+        clip(mArea, ClipperLib::Paths{tile}, ClipperLib::ctIntersection);
+    c.AddPaths(area, ClipperLib::ptSubject, true);
+    foreach (int i, tileObstacles.at(index)) {
+      c.AddPath(mObstacles.at(i), ClipperLib::ptClip, true);
+    }
+    c.Execute(ClipperLib::ctDifference, result, ClipperLib::pftEvenOdd,
+              ClipperLib::pftNonZero);
+    return result;
+  };
+  QVector<QFuture<ClipperLib::Paths>> futures;
+  // The tiles reference local data, so they must have finished before leaving
+  // this scope, even if one of them has thrown an exception.
+  auto waitForTiles = scopeGuard([&futures]() {
+    for (QFuture<ClipperLib::Paths>& future : futures) {
+      try {
+        future.waitForFinished();
+      } catch (...) {
+        // already propagated by QFuture::result()
       }
     }
+  });
+  for (int i = 0; i < tileObstacles.count(); ++i) {
+    futures.append(
+        QtConcurrent::run([buildTile, i]() { return buildTile(i); }));
   }
 
-  c.Execute(ClipperLib::ctDifference, mResult, ClipperLib::pftEvenOdd,
+  // merge the tiles
+  ClipperLib::Clipper c;
+  for (QFuture<ClipperLib::Paths>& future : futures) {
+    c.AddPaths(future.result(), ClipperLib::ptSubject, true);
+  }
+  throwIfAborted();
+  c.Execute(ClipperLib::ctUnion, mResult, ClipperLib::pftNonZero,
             ClipperLib::pftNonZero);
+  mRaw = mResult;
+  return true;
+}
+
+void BoardPlaneFragmentsBuilder::ensureMinimumWidth(
+    ClipperLib::Paths& paths) const {
+  throwIfAborted();
+  Length delta = mPlane.minWidth / 2;
+  ClipperHelpers::offset(paths, -delta, maxArcTolerance());  // can throw
+  ClipperHelpers::offset(paths, delta, maxArcTolerance());   // can throw
 }
 
-void BoardPlaneFragmentsBuilder::ensureMinimumWidth() {
-  Length delta = mPlane.getMinWidth() / 2;
-  ClipperHelpers::offset(mResult, -delta, maxArcTolerance());  // can throw
-  ClipperHelpers::offset(mResult, delta, maxArcTolerance());   // can throw
+void BoardPlaneFragmentsBuilder::updateCache() {
+  sortObstacles();
+  mNewCache.reset(new PlaneCache{mArea, *mPlane.minWidth, mSortedObstacles,
+                                 mRaw, mResult});
 }
 
 void BoardPlaneFragmentsBuilder::flattenResult() {
+  throwIfAborted();
+
   // convert paths to tree
   ClipperLib::PolyTree tree;
   ClipperLib::Clipper  c;
@@ -217,6 +546,7 @@ void BoardPlaneFragmentsBuilder::flattenResult() {
 }
 
 void BoardPlaneFragmentsBuilder::removeOrphans() {
+  throwIfAborted();
   mResult.erase(std::remove_if(
                     mResult.begin(), mResult.end(),
                     [this](const ClipperLib::Path& p) {
@@ -236,32 +566,140 @@ void BoardPlaneFragmentsBuilder::removeOrphans() {
  *  Helper Methods
  ******************************************************************************/
 
+void BoardPlaneFragmentsBuilder::throwIfAborted() const {
+  if (mAbort && mAbort->load()) {
+    throw UserCanceled(__FILE__, __LINE__);
+  }
+}
+
+void BoardPlaneFragmentsBuilder::addObstacle(
+    const ClipperLib::Path& path) noexcept {
+  if (!path.empty()) {
+    mObstacles.push_back(path);
+  }
+}
+
 ClipperLib::Path BoardPlaneFragmentsBuilder::createPadCutOut(
-    const BI_FootprintPad& pad) const noexcept {
-  bool differentNetSignal =
-      (pad.getCompSigInstNetSignal() != &mPlane.getNetSignal());
-  if ((mPlane.getConnectStyle() == BI_Plane::ConnectStyle::None) ||
+    const Snapshot::Pad& pad) const noexcept {
+  bool differentNetSignal = (pad.netSignal != mPlane.netSignal);
+  if ((mPlane.connectStyle == BI_Plane::ConnectStyle::None) ||
       differentNetSignal) {
-    return ClipperHelpers::convert(
-        pad.getSceneOutline(*mPlane.getMinClearance()), maxArcTolerance());
+    return getPadOutline(pad, *mPlane.minClearance);
   } else {
     return ClipperLib::Path();
   }
 }
 
 ClipperLib::Path BoardPlaneFragmentsBuilder::createViaCutOut(
-    const BI_Via& via) const noexcept {
-  bool differentNetSignal =
-      (&via.getNetSignalOfNetSegment() != &mPlane.getNetSignal());
-  if ((mPlane.getConnectStyle() == BI_Plane::ConnectStyle::None) ||
+    const Snapshot::Via& via) const noexcept {
+  bool differentNetSignal = (via.netSignal != mPlane.netSignal);
+  if ((mPlane.connectStyle == BI_Plane::ConnectStyle::None) ||
       differentNetSignal) {
-    return ClipperHelpers::convert(
-        via.getSceneOutline(*mPlane.getMinClearance()), maxArcTolerance());
+    return getViaOutline(via, *mPlane.minClearance);
   } else {
     return ClipperLib::Path();
   }
 }
 
+void BoardPlaneFragmentsBuilder::sortObstacles() noexcept {
+  if (mSortedObstacles.size() != mObstacles.size()) {
+    mSortedObstacles = mObstacles;
+    std::sort(mSortedObstacles.begin(), mSortedObstacles.end(),
+              &BoardPlaneFragmentsBuilder::lessThan);
+  }
+}
+
+ClipperLib::Path BoardPlaneFragmentsBuilder::getPadOutline(
+    const Snapshot::Pad& pad, const Length& expansion) const noexcept {
+  if (mCutOutCache) {
+    return mCutOutCache->getPadOutline(*pad.libPad, pad.rotation, pad.mirrored,
+                                       expansion, maxArcTolerance(),
+                                       pad.position);
+  } else {
+    return ClipperHelpers::convert(pad.getSceneOutline(expansion),
+                                   maxArcTolerance());
+  }
+}
+
+ClipperLib::Path BoardPlaneFragmentsBuilder::getViaOutline(
+    const Snapshot::Via& via, const Length& expansion) const noexcept {
+  if (mCutOutCache) {
+    return mCutOutCache->getViaOutline(via.shape, via.size, expansion,
+                                       maxArcTolerance(), via.position);
+  } else {
+    return ClipperHelpers::convert(via.getSceneOutline(expansion),
+                                   maxArcTolerance());
+  }
+}
+
+/*******************************************************************************
+ *  Static Helper Methods
+ ******************************************************************************/
+
+ClipperLib::Path BoardPlaneFragmentsBuilder::createTile(
+    ClipperLib::cInt x, ClipperLib::cInt y, ClipperLib::cInt expansion,
+    ClipperLib::cInt size) noexcept {
+  ClipperLib::cInt left   = x * size - expansion;
+  ClipperLib::cInt top    = y * size - expansion;
+  ClipperLib::cInt right  = (x + 1) * size + expansion;
+  ClipperLib::cInt bottom = (y + 1) * size + expansion;
+  return ClipperLib::Path{
+      ClipperLib::IntPoint(left, top), ClipperLib::IntPoint(right, top),
+      ClipperLib::IntPoint(right, bottom), ClipperLib::IntPoint(left, bottom)};
+}
+
+ClipperLib::IntRect BoardPlaneFragmentsBuilder::getBounds(
+    const ClipperLib::Path& path) noexcept {
+  ClipperLib::IntRect r{0, 0, 0, 0};
+  for (std::size_t i = 0; i < path.size(); ++i) {
+    const ClipperLib::IntPoint& p = path[i];
+    if ((i == 0) || (p.X < r.left)) r.left = p.X;
+    if ((i == 0) || (p.X > r.right)) r.right = p.X;
+    if ((i == 0) || (p.Y < r.top)) r.top = p.Y;
+    if ((i == 0) || (p.Y > r.bottom)) r.bottom = p.Y;
+  }
+  return r;
+}
+
+ClipperLib::IntRect BoardPlaneFragmentsBuilder::getBounds(
+    const ClipperLib::Paths& paths) noexcept {
+  ClipperLib::IntRect r{0, 0, 0, 0};
+  bool                first = true;
+  for (const ClipperLib::Path& path : paths) {
+    if (path.empty()) continue;
+    ClipperLib::IntRect pathBounds = getBounds(path);
+    r.left   = first ? pathBounds.left : qMin(r.left, pathBounds.left);
+    r.right  = first ? pathBounds.right : qMax(r.right, pathBounds.right);
+    r.top    = first ? pathBounds.top : qMin(r.top, pathBounds.top);
+    r.bottom = first ? pathBounds.bottom : qMax(r.bottom, pathBounds.bottom);
+    first    = false;
+  }
+  return r;
+}
+
+bool BoardPlaneFragmentsBuilder::lessThan(
+    const ClipperLib::Path& lhs, const ClipperLib::Path& rhs) noexcept {
+  if (lhs.size() != rhs.size()) {
+    return lhs.size() < rhs.size();
+  }
+  for (std::size_t i = 0; i < lhs.size(); ++i) {
+    if (lhs[i].X != rhs[i].X) return lhs[i].X < rhs[i].X;
+    if (lhs[i].Y != rhs[i].Y) return lhs[i].Y < rhs[i].Y;
+  }
+  return false;
+}
+
+ClipperLib::Paths BoardPlaneFragmentsBuilder::clip(
+    const ClipperLib::Paths& subject, const ClipperLib::Paths& clip,
+    ClipperLib::ClipType type) {
+  ClipperLib::Paths   result;
+  ClipperLib::Clipper c;
+  c.AddPaths(subject, ClipperLib::ptSubject, true);
+  c.AddPaths(clip, ClipperLib::ptClip, true);
+  c.Execute(type, result, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+  return result;
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
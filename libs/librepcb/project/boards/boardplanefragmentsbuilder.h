@@ -23,20 +23,33 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include "items/bi_plane.h"
+#include "items/bi_via.h"
+
 #include <clipper/clipper.hpp>
 #include <librepcb/common/geometry/path.h>
+#include <librepcb/common/uuid.h>
 
 #include <QtCore>
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
 namespace librepcb {
+
+namespace library {
+class FootprintPad;
+}
+
 namespace project {
 
-class BI_Plane;
-class BI_Via;
-class BI_FootprintPad;
+class Board;
+class BoardPlaneCutOutCache;
+class NetSignal;
 
 /*******************************************************************************
  *  Class BoardPlaneFragmentsBuilder
@@ -44,18 +57,179 @@ class BI_FootprintPad;
 
 /**
  * @brief The BoardPlaneFragmentsBuilder class
+ *
+ * The fragments are calculated from a #Snapshot of the board geometry instead
+ * of the board items themselves, so they can be built in a worker thread while
+ * the board is modified in the main thread.
+ *
+ * If a #PlaneCache of the previous build is passed, only the tiles of the
+ * plane which are affected by changed obstacles (pads, vias, netlines, holes
+ * and other planes) are clipped again and stitched into the cached area. This
+ * makes local modifications (e.g. moving a via) cheap even on large boards.
+ *
+ * In tiling mode, a full build splits the plane into tiles which are clipped
+ * in parallel, each only with the obstacles within the tile. The results may
+ * differ by a few nanometers at tile borders from a build without tiling.
  */
 class BoardPlaneFragmentsBuilder final {
 public:
+  // Types
+
+  /**
+   * @brief Copy of all board geometry needed to build plane fragments
+   *
+   * Net signals are only used to compare identities, they are never
+   * dereferenced.
+   */
+  struct Snapshot {
+    struct Plane {
+      Uuid                   uuid;
+      const NetSignal*       netSignal;
+      QString                layerName;
+      Path                   outline;
+      UnsignedLength         minWidth;
+      UnsignedLength         minClearance;
+      bool                   keepOrphans;
+      BI_Plane::ConnectStyle connectStyle;
+      QVector<Path>          fragments;
+    };
+
+    struct Pad {
+      std::shared_ptr<const library::FootprintPad> libPad;
+      const NetSignal*                             netSignal;
+      Point                                        position;
+      Angle                                        rotation;
+      bool                                         mirrored;
+
+      bool isOnLayer(const QString& layerName) const noexcept;
+      Path getSceneOutline(const Length& expansion = Length(0)) const noexcept;
+    };
+
+    struct Via {
+      const NetSignal* netSignal;
+      Point            position;
+      BI_Via::Shape    shape;
+      PositiveLength   size;
+
+      Path getSceneOutline(const Length& expansion = Length(0)) const noexcept;
+    };
+
+    struct NetLine {
+      const NetSignal* netSignal;
+      QString          layerName;
+      Point            startPoint;
+      Point            endPoint;
+      PositiveLength   width;
+
+      Path getSceneOutline(const Length& expansion = Length(0)) const noexcept;
+    };
+
+    struct Hole {
+      Point          position;
+      PositiveLength diameter;
+    };
+
+    std::vector<Plane>   planes;  ///< Sorted by priority, highest first
+    std::vector<Pad>     pads;
+    std::vector<Via>     vias;
+    std::vector<NetLine> netLines;
+    std::vector<Hole>    holes;  ///< Device holes and board holes
+    QVector<Path>        boardOutlines;
+  };
+
+  /**
+   * @brief Intermediate results of the last build of a plane
+   */
+  struct PlaneCache {
+    ClipperLib::Paths             area;  ///< Plane outline clipped to board
+    Length                        minWidth;
+    std::vector<ClipperLib::Path> obstacles;  ///< Sorted cutouts
+    ClipperLib::Paths             raw;        ///< Area minus obstacles
+    ClipperLib::Paths             opened;     ///< Raw area with minimum width
+  };
+  typedef QHash<Uuid, std::shared_ptr<const PlaneCache>> Cache;
+
   // Constructors / Destructor
   BoardPlaneFragmentsBuilder()                                        = delete;
   BoardPlaneFragmentsBuilder(const BoardPlaneFragmentsBuilder& other) = delete;
-  BoardPlaneFragmentsBuilder(BI_Plane& plane) noexcept;
+  BoardPlaneFragmentsBuilder(const Snapshot& snapshot, int planeIndex,
+                             const PlaneCache*       cache = nullptr,
+                             const std::atomic_bool* abort = nullptr) noexcept;
   ~BoardPlaneFragmentsBuilder() noexcept;
 
+  // Getters
+
+  /**
+   * @brief Get the number of tiles clipped again by the last build
+   *
+   * @return Number of dirty tiles, or -1 if the whole plane was built.
+   */
+  int getDirtyTileCount() const noexcept { return mDirtyTileCount; }
+
+  /**
+   * @brief Get the intermediate results of the last build
+   *
+   * @return The cache to pass to the next build of the same plane
+   */
+  std::shared_ptr<const PlaneCache> getCache() const noexcept {
+    return mNewCache;
+  }
+
+  // Setters
+  void setTilingEnabled(bool enabled) noexcept { mTilingEnabled = enabled; }
+  void setCutOutCache(BoardPlaneCutOutCache* cache) noexcept {
+    mCutOutCache = cache;
+  }
+
   // General Methods
   QVector<Path> buildFragments() noexcept;
 
+  // Static Methods
+
+  /**
+   * Returns the maximum allowed arc tolerance when flattening arcs. Do not
+   * change this if you don't know exactly what you're doing (it affects all
+   * planes in all existing boards)!
+   */
+  static PositiveLength maxArcTolerance() noexcept {
+    return PositiveLength(5000);
+  }
+
+  /**
+   * @brief Copy the geometry of a board which is relevant for its planes
+   *
+   * Must be called from the thread the board lives in.
+   */
+  static Snapshot takeSnapshot(const Board& board) noexcept;
+
+  /**
+   * @brief Build the fragments of all planes of a snapshot
+   *
+   * The planes are filled in priority order, the fragments of each plane are
+   * stored in the snapshot. This is thread-safe as long as the snapshot is not
+   * accessed from other threads.
+   *
+   * @param snapshot    The snapshot to build (and to store the result into).
+   * @param cache       Optional cache of the previous build, will be updated.
+   *                    Entries of planes not contained in the snapshot are
+   *                    removed. The cached data itself is never modified, so
+   *                    copies of the cache can be used concurrently.
+   * @param abort       Optional flag to abort the operation from another
+   *                    thread.
+   * @param tiling      Whether full builds of planes shall be split into
+   *                    tiles which are built in parallel.
+   * @param cutOutCache Optional cache of pad and via outlines, shared by all
+   *                    planes.
+   *
+   * @retval true   All planes have been built.
+   * @retval false  The operation has been aborted, the snapshot contains only
+   *                partial results.
+   */
+  static bool buildAllFragments(
+      Snapshot& snapshot, Cache* cache = nullptr,
+      const std::atomic_bool* abort = nullptr, bool tiling = false,
+      BoardPlaneCutOutCache* cutOutCache = nullptr) noexcept;
+
   // Operator Overloadings
   BoardPlaneFragmentsBuilder& operator=(const BoardPlaneFragmentsBuilder& rhs) =
       delete;
@@ -63,28 +237,63 @@ public:
 private:  // Methods
   void addPlaneOutline();
   void clipToBoardOutline();
-  void subtractOtherObjects();
-  void ensureMinimumWidth();
+  void collectObstacles();
+  bool rebuildDirtyTiles();
+  void subtractObstacles();
+  bool subtractObstaclesInTiles();
+  void ensureMinimumWidth(ClipperLib::Paths& paths) const;
+  void updateCache();
   void flattenResult();
   void removeOrphans();
 
   // Helper Methods
-  ClipperLib::Path createPadCutOut(const BI_FootprintPad& pad) const noexcept;
-  ClipperLib::Path createViaCutOut(const BI_Via& via) const noexcept;
+  void             throwIfAborted() const;
+  void             addObstacle(const ClipperLib::Path& path) noexcept;
+  ClipperLib::Path createPadCutOut(const Snapshot::Pad& pad) const noexcept;
+  ClipperLib::Path createViaCutOut(const Snapshot::Via& via) const noexcept;
+  ClipperLib::Path getPadOutline(const Snapshot::Pad& pad,
+                                 const Length& expansion) const noexcept;
+  ClipperLib::Path getViaOutline(const Snapshot::Via& via,
+                                 const Length& expansion) const noexcept;
+  void                          sortObstacles() noexcept;
 
-  /**
-   * Returns the maximum allowed arc tolerance when flattening arcs. Do not
-   * change this if you don't know exactly what you're doing (it affects all
-   * planes in all existing boards)!
-   */
-  static PositiveLength maxArcTolerance() noexcept {
-    return PositiveLength(5000);
-  }
+  // Static Helper Methods
+  static ClipperLib::Path    createTile(ClipperLib::cInt x, ClipperLib::cInt y,
+                                        ClipperLib::cInt expansion,
+                                        ClipperLib::cInt size) noexcept;
+  static ClipperLib::IntRect getBounds(const ClipperLib::Path& path) noexcept;
+  static ClipperLib::IntRect getBounds(const ClipperLib::Paths& paths) noexcept;
+  static bool                lessThan(const ClipperLib::Path& lhs,
+                                      const ClipperLib::Path& rhs) noexcept;
+  static ClipperLib::Paths   clip(const ClipperLib::Paths& subject,
+                                  const ClipperLib::Paths& clip,
+                                  ClipperLib::ClipType     type);
 
 private:  // Data
-  BI_Plane&         mPlane;
-  ClipperLib::Paths mConnectedNetSignalAreas;
-  ClipperLib::Paths mResult;
+  const Snapshot&               mSnapshot;
+  const Snapshot::Plane&        mPlane;
+  int                           mPlaneIndex;
+  const PlaneCache*             mCache;
+  const std::atomic_bool*       mAbort;
+  bool                          mTilingEnabled;
+  BoardPlaneCutOutCache*        mCutOutCache;
+  int                           mDirtyTileCount;
+  ClipperLib::Paths             mConnectedNetSignalAreas;
+  std::vector<ClipperLib::Path> mObstacles;
+  std::vector<ClipperLib::Path> mSortedObstacles;
+  ClipperLib::Paths             mArea;
+  ClipperLib::Paths             mRaw;
+  ClipperLib::Paths             mResult;
+  std::shared_ptr<PlaneCache>   mNewCache;
+
+  /// Edge length of the tiles which are rebuilt on local changes [nm]
+  static constexpr ClipperLib::cInt sTileSize = 5000000;
+
+  /// Overlap of adjacent tiles to avoid gaps due to rounding [nm]
+  static constexpr ClipperLib::cInt sTileOverlap = 10000;
+
+  /// Edge length of the tiles which are built in parallel [nm]
+  static constexpr ClipperLib::cInt sParallelTileSize = 4 * sTileSize;
 };
 
 /*******************************************************************************
@@ -0,0 +1,133 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boardplanesrebuilder.h"
+
+#include "board.h"
+#include "items/bi_plane.h"
+
+#include <QtConcurrent/QtConcurrent>
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BoardPlanesRebuilder::BoardPlanesRebuilder(Board& board) noexcept
+  : QObject(nullptr),
+    mBoard(board),
+    mCutOutCache(std::make_shared<BoardPlaneCutOutCache>()) {
+}
+
+BoardPlanesRebuilder::~BoardPlanesRebuilder() noexcept {
+  // the jobs only work on their own snapshot, but don't leave them running
+  cancel();
+  foreach (const Job& job, mJobs) { job.watcher->waitForFinished(); }
+  mJobs.clear();
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void BoardPlanesRebuilder::rebuild() noexcept {
+  // Always do a full build without tiling and without cached cutouts (which
+  // may differ by a nanometer due to rounding) to get reproducible fragments,
+  // e.g. for the fabrication output.
+  cancel();
+  Snapshot snapshot = BoardPlaneFragmentsBuilder::takeSnapshot(mBoard);
+  Cache    cache;
+  BoardPlaneFragmentsBuilder::buildAllFragments(snapshot, &cache);
+  mCache = cache;
+  applyFragments(snapshot);
+}
+
+void BoardPlanesRebuilder::startRebuild() noexcept {
+  cancel();
+  Result input{BoardPlaneFragmentsBuilder::takeSnapshot(mBoard), mCache};
+  std::shared_ptr<std::atomic_bool> abort =
+      std::make_shared<std::atomic_bool>(false);
+  QFutureWatcher<Result>* watcher = new QFutureWatcher<Result>(this);
+  connect(watcher, &QFutureWatcher<Result>::finished, this,
+          [this, watcher]() { jobFinished(watcher); });
+  std::shared_ptr<BoardPlaneCutOutCache> cutOutCache = mCutOutCache;
+  watcher->setFuture(QtConcurrent::run([input, abort, cutOutCache]() {
+    Result result = input;
+    BoardPlaneFragmentsBuilder::buildAllFragments(result.snapshot,
+                                                  &result.cache, abort.get(),
+                                                  true, cutOutCache.get());
+    return result;
+  }));
+  mJobs.append(Job{abort, watcher});
+}
+
+void BoardPlanesRebuilder::cancel() noexcept {
+  foreach (const Job& job, mJobs) { job.abort->store(true); }
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void BoardPlanesRebuilder::jobFinished(
+    QFutureWatcher<Result>* watcher) noexcept {
+  for (int i = 0; i < mJobs.count(); ++i) {
+    if (mJobs.at(i).watcher == watcher) {
+      Job job = mJobs.takeAt(i);
+      if (!job.abort->load()) {
+        Result result = watcher->result();
+        mCache        = result.cache;
+        applyFragments(result.snapshot);
+        mBoard.triggerAirWiresRebuild();
+        emit rebuildFinished();
+      }
+      break;
+    }
+  }
+  watcher->deleteLater();
+}
+
+void BoardPlanesRebuilder::applyFragments(const Snapshot& snapshot) noexcept {
+  // planes added or removed in the meantime are not touched
+  QHash<Uuid, BI_Plane*> planes;
+  foreach (BI_Plane* plane, mBoard.getPlanes()) {
+    planes.insert(plane->getUuid(), plane);
+  }
+  for (const Snapshot::Plane& plane : snapshot.planes) {
+    if (BI_Plane* p = planes.value(plane.uuid, nullptr)) {
+      p->setFragments(plane.fragments);
+    }
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
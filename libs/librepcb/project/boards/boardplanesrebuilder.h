@@ -0,0 +1,121 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDPLANESREBUILDER_H
+#define LIBREPCB_PROJECT_BOARDPLANESREBUILDER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boardplanecutoutcache.h"
+#include "boardplanefragmentsbuilder.h"
+
+#include <QtCore>
+
+#include <atomic>
+#include <memory>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+
+/*******************************************************************************
+ *  Class BoardPlanesRebuilder
+ ******************************************************************************/
+
+/**
+ * @brief Rebuilds the fragments of all planes of a board, optionally in the
+ *        background
+ *
+ * A background rebuild takes a snapshot of the board geometry in the main
+ * thread and builds the fragments on the global thread pool, with large
+ * planes split into tiles which are built in parallel. Starting another
+ * rebuild (in background or not) cancels the running one, so only the result
+ * of the newest rebuild is ever applied to the board. The fragments of all
+ * planes are applied at once in the main thread, thus the board never shows
+ * a mix of old and new fragments.
+ *
+ * The intermediate results of the last applied rebuild are kept, so
+ * subsequent background rebuilds only need to update the regions of the
+ * planes which were affected by modifications of the board. Background
+ * rebuilds also share a cache of pad and via cutouts. Synchronous rebuilds
+ * always build all planes from scratch without tiling and cached cutouts to
+ * get reproducible results.
+ */
+class BoardPlanesRebuilder final : public QObject {
+  Q_OBJECT
+
+public:
+  // Constructors / Destructor
+  BoardPlanesRebuilder()                                  = delete;
+  BoardPlanesRebuilder(const BoardPlanesRebuilder& other) = delete;
+  explicit BoardPlanesRebuilder(Board& board) noexcept;
+  ~BoardPlanesRebuilder() noexcept;
+
+  // Getters
+  bool isBusy() const noexcept { return !mJobs.isEmpty(); }
+
+  // General Methods
+  void rebuild() noexcept;
+  void startRebuild() noexcept;
+  void cancel() noexcept;
+
+  // Operator Overloadings
+  BoardPlanesRebuilder& operator=(const BoardPlanesRebuilder& rhs) = delete;
+
+signals:
+  void rebuildFinished();
+
+private:  // Types
+  typedef BoardPlaneFragmentsBuilder::Snapshot Snapshot;
+  typedef BoardPlaneFragmentsBuilder::Cache    Cache;
+
+  struct Result {
+    Snapshot snapshot;
+    Cache    cache;
+  };
+
+  struct Job {
+    std::shared_ptr<std::atomic_bool> abort;
+    QFutureWatcher<Result>*           watcher;
+  };
+
+private:  // Methods
+  void jobFinished(QFutureWatcher<Result>* watcher) noexcept;
+  void applyFragments(const Snapshot& snapshot) noexcept;
+
+private:  // Data
+  Board& mBoard;
+  Cache  mCache;  ///< Cache of the last applied rebuild
+  std::shared_ptr<BoardPlaneCutOutCache> mCutOutCache;  ///< Shared by all jobs
+  QList<Job> mJobs;  ///< Running jobs, only the last one is not aborted
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
+
+#endif  // LIBREPCB_PROJECT_BOARDPLANESREBUILDER_H
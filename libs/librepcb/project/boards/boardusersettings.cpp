@@ -28,6 +28,7 @@
 
 #include <librepcb/common/fileio/sexpression.h>
 #include <librepcb/common/fileio/smartsexprfile.h>
+#include <librepcb/common/fileio/smartsexprfilebatch.h>
 #include <librepcb/common/utils/graphicslayerstackappearancesettings.h>
 
 #include <QtCore>
@@ -86,12 +87,12 @@ BoardUserSettings::~BoardUserSettings() noexcept {
  *  General Methods
  ******************************************************************************/
 
-bool BoardUserSettings::save(bool toOriginal, QStringList& errors) noexcept {
+bool BoardUserSettings::save(bool toOriginal, SmartSExprFileBatch& batch,
+                             QStringList& errors) noexcept {
   bool success = true;
 
   try {
-    SExpression doc(serializeToDomElement("librepcb_board_user_settings"));
-    mFile->save(doc, toOriginal);
+    batch.add(*mFile, serializeToDomElement("librepcb_board_user_settings"));
   } catch (Exception& e) {
     success = false;
     errors.append(e.getMsg());
@@ -34,6 +34,7 @@
 namespace librepcb {
 
 class SmartSExprFile;
+class SmartSExprFileBatch;
 class GraphicsLayerStackAppearanceSettings;
 
 namespace project {
@@ -60,7 +61,8 @@ public:
   ~BoardUserSettings() noexcept;
 
   // General Methods
-  bool save(bool toOriginal, QStringList& errors) noexcept;
+  bool save(bool toOriginal, SmartSExprFileBatch& batch,
+            QStringList& errors) noexcept;
 
   // Operator Overloadings
   BoardUserSettings& operator=(const BoardUserSettings& rhs) = delete;
@@ -65,7 +65,12 @@ Circuit& BI_Base::getCircuit() const noexcept {
  ******************************************************************************/
 
 void BI_Base::setSelected(bool selected) noexcept {
-  mIsSelected = selected;
+  if (selected != mIsSelected) {
+    mIsSelected = selected;
+    if (mIsAddedToBoard) {
+      mBoard.updateItemSelection(*this);
+    }
+  }
 }
 
 /*******************************************************************************
@@ -78,6 +83,7 @@ void BI_Base::addToBoard(QGraphicsItem* item) noexcept {
     mBoard.getGraphicsScene().addItem(*item);
   }
   mIsAddedToBoard = true;
+  mBoard.registerItem(*this);
 }
 
 void BI_Base::removeFromBoard(QGraphicsItem* item) noexcept {
@@ -85,9 +91,16 @@ void BI_Base::removeFromBoard(QGraphicsItem* item) noexcept {
   if (item) {
     mBoard.getGraphicsScene().removeItem(*item);
   }
+  mBoard.unregisterItem(*this);
   mIsAddedToBoard = false;
 }
 
+void BI_Base::invalidateGrabArea() noexcept {
+  if (mIsAddedToBoard) {
+    mBoard.updateItemGrabArea(*this);
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
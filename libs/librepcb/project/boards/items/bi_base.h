@@ -101,6 +101,7 @@ protected:
   // General Methods
   void addToBoard(QGraphicsItem* item) noexcept;
   void removeFromBoard(QGraphicsItem* item) noexcept;
+  void invalidateGrabArea() noexcept;
 
 protected:
   Board& mBoard;
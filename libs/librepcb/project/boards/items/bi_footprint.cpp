@@ -279,12 +279,14 @@ void BI_Footprint::setSelected(bool selected) noexcept {
 
 void BI_Footprint::deviceInstanceAttributesChanged() {
   mGraphicsItem->updateCacheAndRepaint();
+  invalidateGrabArea();
   emit attributesChanged();
 }
 
 void BI_Footprint::deviceInstanceMoved(const Point& pos) {
   mGraphicsItem->setPos(pos.toPxQPointF());
   mGraphicsItem->updateCacheAndRepaint();
+  invalidateGrabArea();
   foreach (BI_FootprintPad* pad, mPads) {
     pad->updatePosition();
     mBoard.scheduleAirWiresRebuild(pad->getCompSigInstNetSignal());
@@ -296,6 +298,7 @@ void BI_Footprint::deviceInstanceRotated(const Angle& rot) {
   Q_UNUSED(rot);
   updateGraphicsItemTransform();
   mGraphicsItem->updateCacheAndRepaint();
+  invalidateGrabArea();
   foreach (BI_FootprintPad* pad, mPads) {
     pad->updatePosition();
     mBoard.scheduleAirWiresRebuild(pad->getCompSigInstNetSignal());
@@ -306,6 +309,7 @@ void BI_Footprint::deviceInstanceMirrored(bool mirrored) {
   Q_UNUSED(mirrored);
   updateGraphicsItemTransform();
   mGraphicsItem->updateCacheAndRepaint();
+  invalidateGrabArea();
   foreach (BI_FootprintPad* pad, mPads) {
     pad->updatePosition();
     mBoard.scheduleAirWiresRebuild(pad->getCompSigInstNetSignal());
@@ -217,6 +217,7 @@ void BI_NetLine::setLayer(GraphicsLayer& layer) {
   if (&layer != mLayer) {
     mLayer = &layer;
     mGraphicsItem->updateCacheAndRepaint();
+    invalidateGrabArea();
   }
 }
 
@@ -224,6 +225,7 @@ void BI_NetLine::setWidth(const PositiveLength& width) noexcept {
   if (width != mWidth) {
     mWidth = width;
     mGraphicsItem->updateCacheAndRepaint();
+    invalidateGrabArea();
   }
 }
 
@@ -264,6 +266,7 @@ void BI_NetLine::removeFromBoard() {
 void BI_NetLine::updateLine() noexcept {
   mPosition = (mStartPoint->getPosition() + mEndPoint->getPosition()) / 2;
   mGraphicsItem->updateCacheAndRepaint();
+  invalidateGrabArea();
 }
 
 void BI_NetLine::serialize(SExpression& root) const {
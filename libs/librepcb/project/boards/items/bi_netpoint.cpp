@@ -109,6 +109,7 @@ void BI_NetPoint::setPosition(const Point& position) noexcept {
   if (position != mPosition) {
     mPosition = position;
     mGraphicsItem->setPos(mPosition.toPxQPointF());
+    invalidateGrabArea();
     foreach (BI_NetLine* line, mRegisteredNetLines) { line->updateLine(); }
     mBoard.scheduleAirWiresRebuild(&getNetSignalOfNetSegment());
   }
@@ -150,6 +151,7 @@ void BI_NetPoint::registerNetLine(BI_NetLine& netline) {
   mRegisteredNetLines.insert(&netline);
   netline.updateLine();
   mGraphicsItem->updateCacheAndRepaint();
+  invalidateGrabArea();
   mErcMsgDeadNetPoint->setVisible(mRegisteredNetLines.isEmpty());
 }
 
@@ -160,6 +162,7 @@ void BI_NetPoint::unregisterNetLine(BI_NetLine& netline) {
   mRegisteredNetLines.remove(&netline);
   netline.updateLine();
   mGraphicsItem->updateCacheAndRepaint();
+  invalidateGrabArea();
   mErcMsgDeadNetPoint->setVisible(mRegisteredNetLines.isEmpty());
 }
 
@@ -29,6 +29,7 @@
 #include "../graphicsitems/bgi_plane.h"
 
 #include <librepcb/common/scopeguard.h>
+#include <librepcb/common/utils/clipperhelpers.h>
 
 #include <QtCore>
 
@@ -55,9 +56,9 @@ BI_Plane::BI_Plane(Board& board, const BI_Plane& other)
     mConnectStyle(other.mConnectStyle),
     // mThermalGapWidth(other.mThermalGapWidth),
     // mThermalSpokeWidth(other.mThermalSpokeWidth),
-    mFragments(other.mFragments)  // also copy fragments to avoid the need for
-                                  // a rebuild
-{
+    mFragments(other.mFragments),  // also copy fragments to avoid the need
+                                   // for a rebuild
+    mPreparedFragmentsValid(false) {
   init();
 }
 
@@ -71,10 +72,11 @@ BI_Plane::BI_Plane(Board& board, const SExpression& node)
     mMinClearance(node.getValueByPath<UnsignedLength>("min_clearance")),
     mKeepOrphans(node.getValueByPath<bool>("keep_orphans")),
     mPriority(node.getValueByPath<int>("priority")),
-    mConnectStyle(node.getValueByPath<ConnectStyle>("connect_style"))
-// mThermalGapWidth(node.getValueByPath<Length>("thermal_gap_width", true)),
-// mThermalSpokeWidth(node.getValueByPath<Length>("thermal_spoke_width", true))
-{
+    mConnectStyle(node.getValueByPath<ConnectStyle>("connect_style")),
+    // mThermalGapWidth(node.getValueByPath<Length>("thermal_gap_width", true)),
+    // mThermalSpokeWidth(node.getValueByPath<Length>("thermal_spoke_width",
+    // true)),
+    mPreparedFragmentsValid(false) {
   Uuid netSignalUuid = node.getValueByPath<Uuid>("net");
   mNetSignal =
       mBoard.getProject().getCircuit().getNetSignalByUuid(netSignalUuid);
@@ -101,7 +103,8 @@ BI_Plane::BI_Plane(Board& board, const Uuid& uuid,
     mPriority(0),
     mConnectStyle(ConnectStyle::Solid),
     // mThermalGapWidth(100000), mThermalSpokeWidth(100000),
-    mFragments() {
+    mFragments(),
+    mPreparedFragmentsValid(false) {
   init();
 }
 
@@ -119,6 +122,33 @@ BI_Plane::~BI_Plane() noexcept {
   mGraphicsItem.reset();
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+const QVector<BI_Plane::PreparedFragment>& BI_Plane::getPreparedFragments()
+    const noexcept {
+  if (!mPreparedFragmentsValid) {
+    mPreparedFragments.clear();
+    foreach (const Path& fragment, mFragments) {
+      PreparedFragment prepared;
+      prepared.path = ClipperHelpers::convert(
+          fragment, BoardPlaneFragmentsBuilder::maxArcTolerance());
+      if (prepared.path.empty()) continue;
+      prepared.min = prepared.max = prepared.path.front();
+      for (const ClipperLib::IntPoint& p : prepared.path) {
+        prepared.min.X = qMin(prepared.min.X, p.X);
+        prepared.min.Y = qMin(prepared.min.Y, p.Y);
+        prepared.max.X = qMax(prepared.max.X, p.X);
+        prepared.max.Y = qMax(prepared.max.Y, p.Y);
+      }
+      mPreparedFragments.append(prepared);
+    }
+    mPreparedFragmentsValid = true;
+  }
+  return mPreparedFragments;
+}
+
 /*******************************************************************************
  *  Setters
  ******************************************************************************/
@@ -127,6 +157,7 @@ void BI_Plane::setOutline(const Path& outline) noexcept {
   if (outline != mOutline) {
     mOutline = outline;
     mGraphicsItem->updateCacheAndRepaint();
+    invalidateGrabArea();
   }
 }
 
@@ -134,6 +165,7 @@ void BI_Plane::setLayerName(const GraphicsLayerName& layerName) noexcept {
   if (layerName != mLayerName) {
     mLayerName = layerName;
     mGraphicsItem->updateCacheAndRepaint();
+    invalidateGrabArea();
   }
 }
 
@@ -207,13 +239,16 @@ void BI_Plane::removeFromBoard() {
 
 void BI_Plane::clear() noexcept {
   mFragments.clear();
+  mPreparedFragmentsValid = false;
   mGraphicsItem->updateCacheAndRepaint();
+  invalidateGrabArea();
 }
 
-void BI_Plane::rebuild() noexcept {
-  BoardPlaneFragmentsBuilder builder(*this);
-  mFragments = builder.buildFragments();
+void BI_Plane::setFragments(const QVector<Path>& fragments) noexcept {
+  mFragments              = fragments;
+  mPreparedFragmentsValid = false;
   mGraphicsItem->updateCacheAndRepaint();
+  invalidateGrabArea();
   mBoard.scheduleAirWiresRebuild(mNetSignal);
 }
 
@@ -264,12 +299,26 @@ bool BI_Plane::operator<(const BI_Plane& rhs) const noexcept {
   }
 }
 
+/*******************************************************************************
+ *  Struct BI_Plane::PreparedFragment
+ ******************************************************************************/
+
+bool BI_Plane::PreparedFragment::contains(const Point& point) const noexcept {
+  ClipperLib::IntPoint p = ClipperHelpers::convert(point);
+  if ((p.X < min.X) || (p.X > max.X) || (p.Y < min.Y) || (p.Y > max.Y)) {
+    return false;
+  }
+  // 1 = inside, -1 = on the boundary (which is connected as well)
+  return ClipperLib::PointInPolygon(p, path) != 0;
+}
+
 /*******************************************************************************
  *  Private Slots
  ******************************************************************************/
 
 void BI_Plane::boardAttributesChanged() {
   mGraphicsItem->updateCacheAndRepaint();
+  invalidateGrabArea();
 }
 
 /*******************************************************************************
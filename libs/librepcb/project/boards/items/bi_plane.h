@@ -25,6 +25,7 @@
  ******************************************************************************/
 #include "bi_base.h"
 
+#include <clipper/clipper.hpp>
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/geometry/path.h>
 #include <librepcb/common/graphics/graphicslayername.h>
@@ -64,6 +65,20 @@ public:
     Solid,  ///< completely connect pads/vias to plane
   };
 
+  /**
+   * @brief A fragment prepared for fast and exact point-in-polygon tests
+   *
+   * Contains the vertices of a fragment in integer nanometers and its bounding
+   * box, so no floating point conversion is needed for hit tests.
+   */
+  struct PreparedFragment {
+    ClipperLib::Path     path;
+    ClipperLib::IntPoint min;  ///< Bottom left corner of the bounding box
+    ClipperLib::IntPoint max;  ///< Top right corner of the bounding box
+
+    bool contains(const Point& point) const noexcept;
+  };
+
   // Constructors / Destructor
   BI_Plane()                      = delete;
   BI_Plane(const BI_Plane& other) = delete;
@@ -89,6 +104,7 @@ public:
   // {return mThermalSpokeWidth;}
   const Path&          getOutline() const noexcept { return mOutline; }
   const QVector<Path>& getFragments() const noexcept { return mFragments; }
+  const QVector<PreparedFragment>& getPreparedFragments() const noexcept;
   bool                 isSelectable() const noexcept override;
 
   // Setters
@@ -105,7 +121,7 @@ public:
   void addToBoard() override;
   void removeFromBoard() override;
   void clear() noexcept;
-  void rebuild() noexcept;
+  void setFragments(const QVector<Path>& fragments) noexcept;
 
   /// @copydoc librepcb::SerializableObject::serialize()
   void serialize(SExpression& root) const override;
@@ -147,6 +163,10 @@ private:  // Data
   QScopedPointer<BGI_Plane> mGraphicsItem;
 
   QVector<Path> mFragments;
+
+  /// Cache for #getPreparedFragments(), invalidated when fragments change
+  mutable QVector<PreparedFragment> mPreparedFragments;
+  mutable bool                      mPreparedFragmentsValid;
 };
 
 /*******************************************************************************
@@ -115,6 +115,7 @@ void BI_StrokeText::updateGraphicsItems() noexcept {
   } else {
     mAnchorGraphicsItem->setLayer(nullptr);
   }
+  invalidateGrabArea();
 }
 
 void BI_StrokeText::addToBoard() {
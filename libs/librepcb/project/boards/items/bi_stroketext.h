@@ -116,6 +116,7 @@ private:  // Methods
   }
   void strokeTextRotationChanged(const Angle& newRot) noexcept override {
     Q_UNUSED(newRot);
+    invalidateGrabArea();
   }
   void strokeTextHeightChanged(
       const PositiveLength& newHeight) noexcept override {
@@ -138,12 +139,14 @@ private:  // Methods
   }
   void strokeTextMirroredChanged(bool mirrored) noexcept override {
     Q_UNUSED(mirrored);
+    invalidateGrabArea();
   }
   void strokeTextAutoRotateChanged(bool newAutoRotate) noexcept override {
     Q_UNUSED(newAutoRotate);
   }
   void strokeTextPathsChanged(const QVector<Path>& paths) noexcept override {
     Q_UNUSED(paths);
+    invalidateGrabArea();
   }
 
 private:  // Data
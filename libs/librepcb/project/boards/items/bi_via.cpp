@@ -106,22 +106,7 @@ bool BI_Via::isOnLayer(const QString& layerName) const noexcept {
 }
 
 Path BI_Via::getOutline(const Length& expansion) const noexcept {
-  Length size = mSize + (expansion * 2);
-  if (size > 0) {
-    PositiveLength pSize(size);
-    switch (mShape) {
-      case Shape::Round:
-        return Path::circle(pSize);
-      case Shape::Square:
-        return Path::centeredRect(pSize, pSize);
-      case Shape::Octagon:
-        return Path::octagon(pSize, pSize);
-      default:
-        Q_ASSERT(false);
-        break;
-    }
-  }
-  return Path();
+  return getOutline(mShape, mSize, expansion);
 }
 
 Path BI_Via::getSceneOutline(const Length& expansion) const noexcept {
@@ -144,6 +129,7 @@ void BI_Via::setPosition(const Point& position) noexcept {
   if (position != mPosition) {
     mPosition = position;
     mGraphicsItem->setPos(mPosition.toPxQPointF());
+    invalidateGrabArea();
     foreach (BI_NetLine* netline, mRegisteredNetLines) {
       netline->updateLine();
     }
@@ -155,6 +141,7 @@ void BI_Via::setShape(Shape shape) noexcept {
   if (shape != mShape) {
     mShape = shape;
     mGraphicsItem->updateCacheAndRepaint();
+    invalidateGrabArea();
   }
 }
 
@@ -162,6 +149,7 @@ void BI_Via::setSize(const PositiveLength& size) noexcept {
   if (size != mSize) {
     mSize = size;
     mGraphicsItem->updateCacheAndRepaint();
+    invalidateGrabArea();
   }
 }
 
@@ -169,6 +157,7 @@ void BI_Via::setDrillDiameter(const PositiveLength& diameter) noexcept {
   if (diameter != mDrillDiameter) {
     mDrillDiameter = diameter;
     mGraphicsItem->updateCacheAndRepaint();
+    invalidateGrabArea();
   }
 }
 
@@ -204,6 +193,7 @@ void BI_Via::registerNetLine(BI_NetLine& netline) {
   mRegisteredNetLines.insert(&netline);
   netline.updateLine();
   mGraphicsItem->updateCacheAndRepaint();
+  invalidateGrabArea();
 }
 
 void BI_Via::unregisterNetLine(BI_NetLine& netline) {
@@ -213,6 +203,7 @@ void BI_Via::unregisterNetLine(BI_NetLine& netline) {
   mRegisteredNetLines.remove(&netline);
   netline.updateLine();
   mGraphicsItem->updateCacheAndRepaint();
+  invalidateGrabArea();
 }
 
 void BI_Via::serialize(SExpression& root) const {
@@ -246,6 +237,31 @@ void BI_Via::setSelected(bool selected) noexcept {
 
 void BI_Via::boardAttributesChanged() {
   mGraphicsItem->updateCacheAndRepaint();
+  invalidateGrabArea();
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+Path BI_Via::getOutline(Shape shape, const PositiveLength& size,
+                        const Length& expansion) noexcept {
+  Length totalSize = size + (expansion * 2);
+  if (totalSize > 0) {
+    PositiveLength pSize(totalSize);
+    switch (shape) {
+      case Shape::Round:
+        return Path::circle(pSize);
+      case Shape::Square:
+        return Path::centeredRect(pSize, pSize);
+      case Shape::Octagon:
+        return Path::octagon(pSize, pSize);
+      default:
+        Q_ASSERT(false);
+        break;
+    }
+  }
+  return Path();
 }
 
 /*******************************************************************************
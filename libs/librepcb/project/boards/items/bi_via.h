@@ -108,6 +108,10 @@ public:
     return mRegisteredNetLines;
   }
 
+  // Static Methods
+  static Path getOutline(Shape shape, const PositiveLength& size,
+                         const Length& expansion) noexcept;
+
   // Operator Overloadings
   BI_Via& operator=(const BI_Via& rhs) = delete;
   bool    operator==(const BI_Via& rhs) noexcept { return (this == &rhs); }
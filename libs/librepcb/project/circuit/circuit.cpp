@@ -31,6 +31,7 @@
 #include <librepcb/common/exceptions.h>
 #include <librepcb/common/fileio/sexpression.h>
 #include <librepcb/common/fileio/smartsexprfile.h>
+#include <librepcb/common/fileio/smartsexprfilebatch.h>
 #include <librepcb/library/cmp/component.h>
 
 #include <QtCore>
@@ -389,13 +390,13 @@ void Circuit::setComponentInstanceName(ComponentInstance&       cmp,
  *  General Methods
  ******************************************************************************/
 
-bool Circuit::save(bool toOriginal, QStringList& errors) noexcept {
+bool Circuit::save(bool toOriginal, SmartSExprFileBatch& batch,
+                   QStringList& errors) noexcept {
   bool success = true;
 
   // Save "circuit/circuit.lp"
   try {
-    SExpression doc(serializeToDomElement("librepcb_circuit"));
-    mFile->save(doc, toOriginal);
+    batch.add(*mFile, serializeToDomElement("librepcb_circuit"));
   } catch (Exception& e) {
     success = false;
     errors.append(e.getMsg());
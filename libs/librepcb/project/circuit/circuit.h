@@ -39,6 +39,7 @@
 namespace librepcb {
 
 class SmartSExprFile;
+class SmartSExprFileBatch;
 
 namespace library {
 class Component;
@@ -125,7 +126,8 @@ public:
                                 const CircuitIdentifier& newName);
 
   // General Methods
-  bool save(bool toOriginal, QStringList& errors) noexcept;
+  bool save(bool toOriginal, SmartSExprFileBatch& batch,
+            QStringList& errors) noexcept;
 
   // Operator Overloadings
   Circuit& operator=(const Circuit& rhs) = delete;
@@ -24,6 +24,7 @@
 
 #include "../boards/items/bi_device.h"
 #include "../erc/ercmsg.h"
+#include "../erc/ercmsglist.h"
 #include "../library/projectlibrary.h"
 #include "../project.h"
 #include "../schematics/items/si_symbol.h"
@@ -407,6 +408,11 @@ bool ComponentInstance::checkAttributesValidity() const noexcept {
 }
 
 void ComponentInstance::updateErcMessages() noexcept {
+  mCircuit.getProject().getErcMsgList().getScheduler().schedule(
+      *this, [this]() { evaluateErcMessages(); });
+}
+
+void ComponentInstance::evaluateErcMessages() noexcept {
   int required = getUnplacedRequiredSymbolsCount();
   int optional = getUnplacedOptionalSymbolsCount();
   mErcMsgUnplacedRequiredSymbols->setMsg(
@@ -169,6 +169,7 @@ private:
   void               init();
   bool               checkAttributesValidity() const noexcept;
   void               updateErcMessages() noexcept;
+  void               evaluateErcMessages() noexcept;
   const QStringList& getLocaleOrder() const noexcept;
 
   // General
@@ -24,6 +24,7 @@
 
 #include "../boards/items/bi_footprintpad.h"
 #include "../erc/ercmsg.h"
+#include "../erc/ercmsglist.h"
 #include "../project.h"
 #include "../schematics/items/si_symbolpin.h"
 #include "../settings/projectsettings.h"
@@ -298,6 +299,11 @@ void ComponentSignalInstance::netSignalNameChanged(
 }
 
 void ComponentSignalInstance::updateErcMessages() noexcept {
+  mCircuit.getProject().getErcMsgList().getScheduler().schedule(
+      *this, [this]() { evaluateErcMessages(); });
+}
+
+void ComponentSignalInstance::evaluateErcMessages() noexcept {
   mErcMsgUnconnectedRequiredSignal->setMsg(
       QString(tr("Unconnected component signal: \"%1\" from \"%2\""))
           .arg(*mComponentSignal->getName())
@@ -136,6 +136,7 @@ private slots:
 private:
   void init();
   bool checkAttributesValidity() const noexcept;
+  void evaluateErcMessages() noexcept;
 
   // General
   Circuit&                        mCircuit;
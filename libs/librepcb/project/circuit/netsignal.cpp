@@ -25,6 +25,8 @@
 #include "../boards/items/bi_netsegment.h"
 #include "../boards/items/bi_plane.h"
 #include "../erc/ercmsg.h"
+#include "../erc/ercmsglist.h"
+#include "../project.h"
 #include "../schematics/items/si_netsegment.h"
 #include "circuit.h"
 #include "componentsignalinstance.h"
@@ -250,6 +252,11 @@ bool NetSignal::checkAttributesValidity() const noexcept {
 }
 
 void NetSignal::updateErcMessages() noexcept {
+  mCircuit.getProject().getErcMsgList().getScheduler().schedule(
+      *this, [this]() { evaluateErcMessages(); });
+}
+
+void NetSignal::evaluateErcMessages() noexcept {
   if (mIsAddedToCircuit && (!isUsed())) {
     if (!mErcMsgUnusedNetSignal) {
       mErcMsgUnusedNetSignal.reset(
@@ -126,6 +126,7 @@ signals:
 private:
   bool checkAttributesValidity() const noexcept;
   void updateErcMessages() noexcept;
+  void evaluateErcMessages() noexcept;
 
   // General
   Circuit& mCircuit;
@@ -28,6 +28,7 @@
 
 #include <librepcb/common/fileio/sexpression.h>
 #include <librepcb/common/fileio/smartsexprfile.h>
+#include <librepcb/common/fileio/smartsexprfilebatch.h>
 
 #include <QtCore>
 
@@ -87,6 +88,9 @@ void ErcMsgList::update(ErcMsg* ercMsg) noexcept {
 }
 
 void ErcMsgList::restoreIgnoreState() {
+  // make sure all ERC messages are up to date
+  mScheduler.flush();
+
   if (mFile->isCreated()) return;  // the file does not yet exist
 
   SExpression root = mFile->parseFileAndBuildDomTree();
@@ -108,13 +112,16 @@ void ErcMsgList::restoreIgnoreState() {
   }
 }
 
-bool ErcMsgList::save(bool toOriginal, QStringList& errors) noexcept {
+bool ErcMsgList::save(bool toOriginal, SmartSExprFileBatch& batch,
+                      QStringList& errors) noexcept {
   bool success = true;
 
+  // make sure all ERC messages are up to date
+  mScheduler.flush();
+
   // Save "circuit/erc.lp"
   try {
-    SExpression doc(serializeToDomElement("librepcb_erc"));
-    mFile->save(doc, toOriginal);
+    batch.add(*mFile, serializeToDomElement("librepcb_erc"));
   } catch (Exception& e) {
     success = false;
     errors.append(e.getMsg());
@@ -23,6 +23,8 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include "ercscheduler.h"
+
 #include <librepcb/common/exceptions.h>
 #include <librepcb/common/fileio/filepath.h>
 #include <librepcb/common/fileio/serializableobject.h>
@@ -35,6 +37,7 @@
 namespace librepcb {
 
 class SmartSExprFile;
+class SmartSExprFileBatch;
 
 namespace project {
 
@@ -62,13 +65,15 @@ public:
 
   // Getters
   const QList<ErcMsg*>& getItems() const noexcept { return mItems; }
+  ErcScheduler&         getScheduler() noexcept { return mScheduler; }
 
   // General Methods
   void add(ErcMsg* ercMsg) noexcept;
   void remove(ErcMsg* ercMsg) noexcept;
   void update(ErcMsg* ercMsg) noexcept;
   void restoreIgnoreState();
-  bool save(bool toOriginal, QStringList& errors) noexcept;
+  bool save(bool toOriginal, SmartSExprFileBatch& batch,
+            QStringList& errors) noexcept;
 
   // Operator Overloadings
   ErcMsgList& operator=(const ErcMsgList& rhs) = delete;
@@ -91,7 +96,8 @@ private:  // Methods
   QScopedPointer<SmartSExprFile> mFile;
 
   // Misc
-  QList<ErcMsg*> mItems;  ///< contains all visible ERC messages
+  QList<ErcMsg*> mItems;      ///< contains all visible ERC messages
+  ErcScheduler   mScheduler;  ///< deferred evaluation of ERC messages
 };
 
 /*******************************************************************************
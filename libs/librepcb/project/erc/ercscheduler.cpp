@@ -0,0 +1,100 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "ercscheduler.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+ErcScheduler::ErcScheduler(QObject* parent) noexcept
+  : QObject(parent),
+    mFlushQueued(false),
+    mScheduledCount(0),
+    mEvaluatedCount(0),
+    mCoalescedCount(0) {
+}
+
+ErcScheduler::~ErcScheduler() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void ErcScheduler::schedule(QObject&              object,
+                            std::function<void()> evaluate) noexcept {
+  ++mScheduledCount;
+  if (mPending.contains(&object)) {
+    ++mCoalescedCount;
+    return;
+  }
+  mQueue.append(&object);
+  mPending.insert(&object, evaluate);
+  connect(&object, &QObject::destroyed, this, &ErcScheduler::objectDestroyed,
+          Qt::UniqueConnection);
+  if (!mFlushQueued) {
+    mFlushQueued = true;
+    QTimer::singleShot(0, this, &ErcScheduler::flush);
+  }
+}
+
+void ErcScheduler::flush() noexcept {
+  // note: evaluating an object may schedule or destroy other objects, newly
+  // scheduled objects are appended to the queue and thus processed too
+  mFlushQueued = true;
+  for (int i = 0; i < mQueue.count(); ++i) {
+    QObject*              object   = mQueue.at(i);
+    std::function<void()> evaluate = mPending.take(object);
+    if (evaluate) {
+      disconnect(object, &QObject::destroyed, this,
+                 &ErcScheduler::objectDestroyed);
+      evaluate();
+      ++mEvaluatedCount;
+    }
+  }
+  mQueue.clear();
+  mFlushQueued = false;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void ErcScheduler::objectDestroyed(QObject* object) noexcept {
+  mPending.remove(object);  // its queue entry is skipped by flush()
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
@@ -0,0 +1,114 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_ERCSCHEDULER_H
+#define LIBREPCB_PROJECT_ERCSCHEDULER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+
+#include <functional>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*******************************************************************************
+ *  Class ErcScheduler
+ ******************************************************************************/
+
+/**
+ * @brief Defers and coalesces the evaluation of ERC messages
+ *
+ * ERC message providers (e.g. net signals or component instances) need to
+ * re-evaluate their messages whenever something relevant changed. Doing that
+ * synchronously causes a lot of redundant work (and model signals) during
+ * bulk operations like loading a project or pasting hundreds of parts, since
+ * the same object is evaluated again and again.
+ *
+ * Instead, providers call #schedule() which only marks them as dirty. All
+ * dirty objects are then evaluated exactly once by #flush(), which is called
+ * automatically in the next event loop iteration, but can also be called
+ * explicitly (e.g. when an undo command group was committed, or before the
+ * ERC messages are accessed without an event loop).
+ *
+ * Objects which get destroyed while being scheduled are dropped silently.
+ */
+class ErcScheduler final : public QObject {
+  Q_OBJECT
+
+public:
+  // Constructors / Destructor
+  ErcScheduler(const ErcScheduler& other) = delete;
+  explicit ErcScheduler(QObject* parent = nullptr) noexcept;
+  ~ErcScheduler() noexcept;
+
+  // Getters
+  bool isPending() const noexcept { return !mPending.isEmpty(); }
+  int  getScheduledCount() const noexcept { return mScheduledCount; }
+  int  getEvaluatedCount() const noexcept { return mEvaluatedCount; }
+  int  getCoalescedCount() const noexcept { return mCoalescedCount; }
+
+  // General Methods
+
+  /**
+   * @brief Mark an object as dirty
+   *
+   * @param object      The object whose ERC messages need to be updated.
+   * @param evaluate    The function which updates the ERC messages. If the
+   *                    object is already scheduled, the previously passed
+   *                    function is kept and this call is counted as coalesced.
+   */
+  void schedule(QObject& object, std::function<void()> evaluate) noexcept;
+
+  /**
+   * @brief Evaluate all scheduled objects now
+   *
+   * Objects scheduled during the evaluation are evaluated as well, in the
+   * order they were scheduled.
+   */
+  void flush() noexcept;
+
+  // Operator Overloadings
+  ErcScheduler& operator=(const ErcScheduler& rhs) = delete;
+
+private:  // Methods
+  void objectDestroyed(QObject* object) noexcept;
+
+private:  // Data
+  QVector<QObject*>                      mQueue;
+  QHash<QObject*, std::function<void()>> mPending;
+  bool                                   mFlushQueued;
+  int                                    mScheduledCount;
+  int                                    mEvaluatedCount;
+  int                                    mCoalescedCount;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
+
+#endif  // LIBREPCB_PROJECT_ERCSCHEDULER_H
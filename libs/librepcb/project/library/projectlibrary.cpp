@@ -183,7 +183,12 @@ bool ProjectLibrary::save(bool toOriginal, QStringList& errors) noexcept {
         // Avoid copy failure caused by already existing directory.
         FileUtils::removeDirRecursively(dir);
       }
-      FileUtils::copyDirRecursively(element->getFilePath(), dir);  // can throw
+      // Don't create hardlinks here since the element may be located in the
+      // workspace library, and files of the user's project directory must not
+      // change if workspace files are modified in place by other tools.
+      FileUtils::copyDirRecursively(
+          element->getFilePath(), dir,
+          FileUtils::CopyStrategy::Clone);  // can throw
       savedElements.insert(element);
     } catch (const Exception& e) {
       success = false;
@@ -234,10 +239,12 @@ void ProjectLibrary::loadElements(const FilePath&            directory,
     }
 
     // Copy element to temporary directory to decouple it from the project
-    // library.
+    // library. Hardlinks are enough for that since files are never modified
+    // in place, and they avoid copying hundreds of files.
     FilePath elementDir =
-        mTmpDir.getPathTo(QString::number(qrand())).getPathTo(dirname);
-    FileUtils::copyDirRecursively(subdirPath, elementDir);  // can throw
+        mTmpDir.getPathTo(Uuid::createRandom().toStr()).getPathTo(dirname);
+    FileUtils::copyDirRecursively(subdirPath, elementDir,
+                                  FileUtils::CopyStrategy::Link);  // can throw
 
     // load the library element
     ElementType* element = new ElementType(elementDir, false);  // can throw
@@ -270,7 +277,7 @@ void ProjectLibrary::addElement(ElementType&               element,
   if (!mAllElements.contains(&element)) {
     // copy from workspace *immediately* to freeze/backup their state
     element.saveIntoParentDirectory(
-        mTmpDir.getPathTo(QString::number(qrand())));  // can throw
+        mTmpDir.getPathTo(Uuid::createRandom().toStr()));  // can throw
     mAllElements.insert(&element);
   }
   elementList.insert(element.getUuid(), &element);
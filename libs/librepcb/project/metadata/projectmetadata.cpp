@@ -26,6 +26,7 @@
 
 #include <librepcb/common/fileio/sexpression.h>
 #include <librepcb/common/fileio/smartsexprfile.h>
+#include <librepcb/common/fileio/smartsexprfilebatch.h>
 
 #include <QtCore>
 
@@ -125,12 +126,12 @@ void ProjectMetadata::updateLastModified() noexcept {
  *  General Methods
  ******************************************************************************/
 
-bool ProjectMetadata::save(bool toOriginal, QStringList& errors) noexcept {
+bool ProjectMetadata::save(bool toOriginal, SmartSExprFileBatch& batch,
+                           QStringList& errors) noexcept {
   bool success = true;
 
   try {
-    SExpression doc(serializeToDomElement("librepcb_project_metadata"));
-    mFile->save(doc, toOriginal);
+    batch.add(*mFile, serializeToDomElement("librepcb_project_metadata"));
   } catch (const Exception& e) {
     success = false;
     errors.append(e.getMsg());
@@ -36,6 +36,7 @@
 namespace librepcb {
 
 class SmartSExprFile;
+class SmartSExprFileBatch;
 
 namespace project {
 
@@ -154,7 +155,8 @@ public:
   void updateLastModified() noexcept;
 
   // General Methods
-  bool save(bool toOriginal, QStringList& errors) noexcept;
+  bool save(bool toOriginal, SmartSExprFileBatch& batch,
+            QStringList& errors) noexcept;
 
   // Operator Overloadings
   ProjectMetadata& operator=(const ProjectMetadata& rhs) = delete;
@@ -37,6 +37,7 @@
 #include <librepcb/common/fileio/fileutils.h>
 #include <librepcb/common/fileio/sexpression.h>
 #include <librepcb/common/fileio/smartsexprfile.h>
+#include <librepcb/common/fileio/smartsexprfilebatch.h>
 #include <librepcb/common/fileio/smarttextfile.h>
 #include <librepcb/common/fileio/smartversionfile.h>
 #include <librepcb/common/font/strokefontpool.h>
@@ -804,6 +805,10 @@ bool Project::save(bool toOriginal, QStringList& errors) noexcept {
     errors.append(e.getMsg());
   }
 
+  // All S-Expression documents are only collected here (i.e. their DOM trees
+  // are built), but serialized concurrently and written afterwards.
+  SmartSExprFileBatch batch;
+
   // Save schematics/schematics.lp
   try {
     SExpression root = SExpression::createList("librepcb_schematics");
@@ -811,7 +816,7 @@ bool Project::save(bool toOriginal, QStringList& errors) noexcept {
       root.appendChild("schematic", schematic->getFilePath().toRelative(mPath),
                        true);
     }
-    mSchematicsFile->save(root, toOriginal);  // can throw
+    batch.add(*mSchematicsFile, root);
   } catch (const Exception& e) {
     success = false;
     errors.append(e.getMsg());
@@ -823,44 +828,47 @@ bool Project::save(bool toOriginal, QStringList& errors) noexcept {
     foreach (Board* board, mBoards) {
       root.appendChild("board", board->getFilePath().toRelative(mPath), true);
     }
-    mBoardsFile->save(root, toOriginal);  // can throw
+    batch.add(*mBoardsFile, root);
   } catch (const Exception& e) {
     success = false;
     errors.append(e.getMsg());
   }
 
   // Save metadata
-  if (!mProjectMetadata->save(toOriginal, errors)) success = false;
+  if (!mProjectMetadata->save(toOriginal, batch, errors)) success = false;
 
   // Save circuit
-  if (!mCircuit->save(toOriginal, errors)) success = false;
+  if (!mCircuit->save(toOriginal, batch, errors)) success = false;
 
   // Save all removed schematics (*.lp files)
   foreach (Schematic* schematic, mRemovedSchematics) {
-    if (!schematic->save(toOriginal, errors)) success = false;
+    if (!schematic->save(toOriginal, batch, errors)) success = false;
   }
   // Save all added schematics (*.lp files)
   foreach (Schematic* schematic, mSchematics) {
-    if (!schematic->save(toOriginal, errors)) success = false;
+    if (!schematic->save(toOriginal, batch, errors)) success = false;
   }
 
   // Save all removed boards (*.lp files)
   foreach (Board* board, mRemovedBoards) {
-    if (!board->save(toOriginal, errors)) success = false;
+    if (!board->save(toOriginal, batch, errors)) success = false;
   }
   // Save all added boards (*.lp files)
   foreach (Board* board, mBoards) {
-    if (!board->save(toOriginal, errors)) success = false;
+    if (!board->save(toOriginal, batch, errors)) success = false;
   }
 
   // Save library
   if (!mProjectLibrary->save(toOriginal, errors)) success = false;
 
   // Save settings
-  if (!mProjectSettings->save(toOriginal, errors)) success = false;
+  if (!mProjectSettings->save(toOriginal, batch, errors)) success = false;
 
   // Save ERC messages list
-  if (!mErcMsgList->save(toOriginal, errors)) success = false;
+  if (!mErcMsgList->save(toOriginal, batch, errors)) success = false;
+
+  // Serialize and write all collected documents
+  if (!batch.save(toOriginal, errors)) success = false;
 
   // if the project was restored from a backup, reset the mIsRestored flag as
   // the current state of the project is no longer a restored backup but a
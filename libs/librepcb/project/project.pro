@@ -10,7 +10,7 @@ TARGET = librepcbproject
 # Use common project definitions
 include(../../../common.pri)
 
-QT += core widgets xml sql printsupport
+QT += core widgets xml sql printsupport concurrent
 
 CONFIG += staticlib
 
@@ -22,10 +22,14 @@ INCLUDEPATH += \
 SOURCES += \
     boards/board.cpp \
     boards/boardairwiresbuilder.cpp \
+    boards/boardairwiresgraph.cpp \
+    boards/boardcamsnapshot.cpp \
     boards/boardfabricationoutputsettings.cpp \
     boards/boardgerberexport.cpp \
     boards/boardlayerstack.cpp \
+    boards/boardplanecutoutcache.cpp \
     boards/boardplanefragmentsbuilder.cpp \
+    boards/boardplanesrebuilder.cpp \
     boards/boardselectionquery.cpp \
     boards/boardusersettings.cpp \
     boards/cmd/cmdboardadd.cpp \
@@ -94,6 +98,7 @@ SOURCES += \
     circuit/netsignal.cpp \
     erc/ercmsg.cpp \
     erc/ercmsglist.cpp \
+    erc/ercscheduler.cpp \
     library/cmd/cmdprojectlibraryaddelement.cpp \
     library/cmd/cmdprojectlibraryremoveelement.cpp \
     library/projectlibrary.cpp \
@@ -137,10 +142,14 @@ SOURCES += \
 HEADERS += \
     boards/board.h \
     boards/boardairwiresbuilder.h \
+    boards/boardairwiresgraph.h \
+    boards/boardcamsnapshot.h \
     boards/boardfabricationoutputsettings.h \
     boards/boardgerberexport.h \
     boards/boardlayerstack.h \
+    boards/boardplanecutoutcache.h \
     boards/boardplanefragmentsbuilder.h \
+    boards/boardplanesrebuilder.h \
     boards/boardselectionquery.h \
     boards/boardusersettings.h \
     boards/cmd/cmdboardadd.h \
@@ -209,6 +218,7 @@ HEADERS += \
     circuit/netsignal.h \
     erc/ercmsg.h \
     erc/ercmsglist.h \
+    erc/ercscheduler.h \
     erc/if_ercmsgprovider.h \
     library/cmd/cmdprojectlibraryaddelement.h \
     library/cmd/cmdprojectlibraryremoveelement.h \
@@ -68,7 +68,12 @@ Circuit& SI_Base::getCircuit() const noexcept {
  ******************************************************************************/
 
 void SI_Base::setSelected(bool selected) noexcept {
-  mIsSelected = selected;
+  if (selected != mIsSelected) {
+    mIsSelected = selected;
+    if (mIsAddedToSchematic) {
+      mSchematic.updateItemSelection(*this);
+    }
+  }
 }
 
 /*******************************************************************************
@@ -81,6 +86,7 @@ void SI_Base::addToSchematic(SGI_Base* item) noexcept {
     mSchematic.getGraphicsScene().addItem(*item);
   }
   mIsAddedToSchematic = true;
+  mSchematic.registerItem(*this);
 }
 
 void SI_Base::removeFromSchematic(SGI_Base* item) noexcept {
@@ -88,9 +94,16 @@ void SI_Base::removeFromSchematic(SGI_Base* item) noexcept {
   if (item) {
     mSchematic.getGraphicsScene().removeItem(*item);
   }
+  mSchematic.unregisterItem(*this);
   mIsAddedToSchematic = false;
 }
 
+void SI_Base::invalidateGrabArea() noexcept {
+  if (mIsAddedToSchematic) {
+    mSchematic.updateItemGrabArea(*this);
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -95,6 +95,7 @@ protected:
   // General Methods
   void addToSchematic(SGI_Base* item) noexcept;
   void removeFromSchematic(SGI_Base* item) noexcept;
+  void invalidateGrabArea() noexcept;
 
 protected:
   Schematic& mSchematic;
@@ -103,6 +103,7 @@ void SI_NetLabel::setPosition(const Point& position) noexcept {
     mPosition = position;
     mGraphicsItem->setPos(mPosition.toPxQPointF());
     updateAnchor();
+    invalidateGrabArea();
   }
 }
 
@@ -112,6 +113,7 @@ void SI_NetLabel::setRotation(const Angle& rotation) noexcept {
     mGraphicsItem->setRotation(-mRotation.toDeg());
     mGraphicsItem->updateCacheAndRepaint();
     updateAnchor();
+    invalidateGrabArea();
   }
 }
 
@@ -129,7 +131,10 @@ void SI_NetLabel::addToSchematic() {
   }
   mNameChangedConnection =
       connect(&getNetSignalOfNetSegment(), &NetSignal::nameChanged,
-              [this]() { mGraphicsItem->updateCacheAndRepaint(); });
+              [this]() {
+                mGraphicsItem->updateCacheAndRepaint();
+                invalidateGrabArea();
+              });
   mHighlightChangedConnection =
       connect(&getNetSignalOfNetSegment(), &NetSignal::highlightedChanged,
               [this]() { mGraphicsItem->update(); });
@@ -117,6 +117,7 @@ void SI_NetLine::setWidth(const UnsignedLength& width) noexcept {
   if (width != mWidth) {
     mWidth = width;
     mGraphicsItem->updateCacheAndRepaint();
+    invalidateGrabArea();
   }
 }
 
@@ -157,6 +158,7 @@ void SI_NetLine::removeFromSchematic() {
 void SI_NetLine::updateLine() noexcept {
   mPosition = (mStartPoint->getPosition() + mEndPoint->getPosition()) / 2;
   mGraphicsItem->updateCacheAndRepaint();
+  invalidateGrabArea();
 }
 
 void SI_NetLine::serialize(SExpression& root) const {
@@ -103,6 +103,7 @@ void SI_NetPoint::setPosition(const Point& position) noexcept {
   if (position != mPosition) {
     mPosition = position;
     mGraphicsItem->setPos(mPosition.toPxQPointF());
+    invalidateGrabArea();
     foreach (SI_NetLine* line, mRegisteredNetLines) { line->updateLine(); }
   }
 }
@@ -139,6 +140,7 @@ void SI_NetPoint::registerNetLine(SI_NetLine& netline) {
   mRegisteredNetLines.insert(&netline);
   netline.updateLine();
   mGraphicsItem->updateCacheAndRepaint();
+  invalidateGrabArea();
   mErcMsgDeadNetPoint->setVisible(mRegisteredNetLines.isEmpty());
 }
 
@@ -149,6 +151,7 @@ void SI_NetPoint::unregisterNetLine(SI_NetLine& netline) {
   mRegisteredNetLines.remove(&netline);
   netline.updateLine();
   mGraphicsItem->updateCacheAndRepaint();
+  invalidateGrabArea();
   mErcMsgDeadNetPoint->setVisible(mRegisteredNetLines.isEmpty());
 }
 
@@ -179,6 +179,7 @@ void SI_Symbol::setPosition(const Point& newPos) noexcept {
     mPosition = newPos;
     mGraphicsItem->setPos(newPos.toPxQPointF());
     mGraphicsItem->updateCacheAndRepaint();
+    invalidateGrabArea();
     foreach (SI_SymbolPin* pin, mPins) { pin->updatePosition(); }
   }
 }
@@ -188,6 +189,7 @@ void SI_Symbol::setRotation(const Angle& newRotation) noexcept {
     mRotation = newRotation;
     updateGraphicsItemTransform();
     mGraphicsItem->updateCacheAndRepaint();
+    invalidateGrabArea();
     foreach (SI_SymbolPin* pin, mPins) { pin->updatePosition(); }
   }
 }
@@ -197,6 +199,7 @@ void SI_Symbol::setMirrored(bool newMirrored) noexcept {
     mMirrored = newMirrored;
     updateGraphicsItemTransform();
     mGraphicsItem->updateCacheAndRepaint();
+    invalidateGrabArea();
     foreach (SI_SymbolPin* pin, mPins) { pin->updatePosition(); }
   }
 }
@@ -297,6 +300,7 @@ void SI_Symbol::setSelected(bool selected) noexcept {
 
 void SI_Symbol::schematicOrComponentAttributesChanged() {
   mGraphicsItem->updateCacheAndRepaint();
+  invalidateGrabArea();
 }
 
 /*******************************************************************************
@@ -191,6 +191,7 @@ void SI_SymbolPin::registerNetLine(SI_NetLine& netline) {
   updateErcMessages();
   mGraphicsItem
       ->updateCacheAndRepaint();  // re-check whether to fill the circle or not
+  invalidateGrabArea();
 }
 
 void SI_SymbolPin::unregisterNetLine(SI_NetLine& netline) {
@@ -202,6 +203,7 @@ void SI_SymbolPin::unregisterNetLine(SI_NetLine& netline) {
   updateErcMessages();
   mGraphicsItem
       ->updateCacheAndRepaint();  // re-check whether to fill the circle or not
+  invalidateGrabArea();
 }
 
 void SI_SymbolPin::updatePosition() noexcept {
@@ -210,6 +212,7 @@ void SI_SymbolPin::updatePosition() noexcept {
   mGraphicsItem->setPos(mPosition.toPxQPointF());
   updateGraphicsItemTransform();
   mGraphicsItem->updateCacheAndRepaint();
+  invalidateGrabArea();
   foreach (SI_NetLine* netline, mRegisteredNetLines) { netline->updateLine(); }
 }
 
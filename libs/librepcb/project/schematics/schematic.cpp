@@ -34,6 +34,7 @@
 #include <librepcb/common/application.h>
 #include <librepcb/common/fileio/sexpression.h>
 #include <librepcb/common/fileio/smartsexprfile.h>
+#include <librepcb/common/fileio/smartsexprfilebatch.h>
 #include <librepcb/common/graphics/graphicsscene.h>
 #include <librepcb/common/graphics/graphicsview.h>
 #include <librepcb/common/gridproperties.h>
@@ -42,6 +43,8 @@
 
 #include <QtCore>
 
+#include <algorithm>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -155,38 +158,39 @@ bool Schematic::isEmpty() const noexcept {
 }
 
 QList<SI_Base*> Schematic::getItemsAtScenePos(const Point& pos) const noexcept {
-  QPointF scenePosPx = pos.toPxQPointF();
+  QVector<SI_Base*> items = getItemsAtScenePosPx(pos.toPxQPointF());
   QList<SI_Base*>
       list;  // Note: The order of adding the items is very important (the
              // top most item must appear as the first item in the list)!
 
   // visible netpoints
-  const QList<SI_NetPoint*> netpoints(getNetPointsAtScenePos(pos));
-  foreach (SI_NetPoint* netpoint, netpoints) {
-    if (netpoint->isVisibleJunction()) {
-      list.append(netpoint);
+  foreach (SI_Base* item, items) {
+    if ((item->getType() == SI_Base::Type_t::NetPoint) &&
+        static_cast<SI_NetPoint*>(item)->isVisibleJunction()) {
+      list.append(item);
     }
   }
   // hidden netpoints
-  foreach (SI_NetPoint* netpoint, netpoints) {
-    if (!netpoint->isVisibleJunction()) {
-      list.append(netpoint);
+  foreach (SI_Base* item, items) {
+    if ((item->getType() == SI_Base::Type_t::NetPoint) &&
+        (!static_cast<SI_NetPoint*>(item)->isVisibleJunction())) {
+      list.append(item);
     }
   }
   // netlines
-  foreach (SI_NetLine* netline, getNetLinesAtScenePos(pos)) {
-    list.append(netline);
+  foreach (SI_Base* item, items) {
+    if (item->getType() == SI_Base::Type_t::NetLine) list.append(item);
   }
   // netlabels
-  foreach (SI_NetLabel* netlabel, getNetLabelsAtScenePos(pos)) {
-    list.append(netlabel);
+  foreach (SI_Base* item, items) {
+    if (item->getType() == SI_Base::Type_t::NetLabel) list.append(item);
   }
-  // symbols & pins
-  foreach (SI_Symbol* symbol, mSymbols) {
-    foreach (SI_SymbolPin* pin, symbol->getPins()) {
-      if (pin->getGrabAreaScenePx().contains(scenePosPx)) list.append(pin);
+  // symbols & pins (each symbol follows its pins in the model order)
+  foreach (SI_Base* item, items) {
+    if ((item->getType() == SI_Base::Type_t::Symbol) ||
+        (item->getType() == SI_Base::Type_t::SymbolPin)) {
+      list.append(item);
     }
-    if (symbol->getGrabAreaScenePx().contains(scenePosPx)) list.append(symbol);
   }
   return list;
 }
@@ -194,8 +198,10 @@ QList<SI_Base*> Schematic::getItemsAtScenePos(const Point& pos) const noexcept {
 QList<SI_NetPoint*> Schematic::getNetPointsAtScenePos(const Point& pos) const
     noexcept {
   QList<SI_NetPoint*> list;
-  foreach (SI_NetSegment* segment, mNetSegments) {
-    segment->getNetPointsAtScenePos(pos, list);
+  foreach (SI_Base* item, getItemsAtScenePosPx(pos.toPxQPointF())) {
+    if (item->getType() == SI_Base::Type_t::NetPoint) {
+      list.append(static_cast<SI_NetPoint*>(item));
+    }
   }
   return list;
 }
@@ -203,8 +209,10 @@ QList<SI_NetPoint*> Schematic::getNetPointsAtScenePos(const Point& pos) const
 QList<SI_NetLine*> Schematic::getNetLinesAtScenePos(const Point& pos) const
     noexcept {
   QList<SI_NetLine*> list;
-  foreach (SI_NetSegment* segment, mNetSegments) {
-    segment->getNetLinesAtScenePos(pos, list);
+  foreach (SI_Base* item, getItemsAtScenePosPx(pos.toPxQPointF())) {
+    if (item->getType() == SI_Base::Type_t::NetLine) {
+      list.append(static_cast<SI_NetLine*>(item));
+    }
   }
   return list;
 }
@@ -212,8 +220,10 @@ QList<SI_NetLine*> Schematic::getNetLinesAtScenePos(const Point& pos) const
 QList<SI_NetLabel*> Schematic::getNetLabelsAtScenePos(const Point& pos) const
     noexcept {
   QList<SI_NetLabel*> list;
-  foreach (SI_NetSegment* segment, mNetSegments) {
-    segment->getNetLabelsAtScenePos(pos, list);
+  foreach (SI_Base* item, getItemsAtScenePosPx(pos.toPxQPointF())) {
+    if (item->getType() == SI_Base::Type_t::NetLabel) {
+      list.append(static_cast<SI_NetLabel*>(item));
+    }
   }
   return list;
 }
@@ -221,10 +231,9 @@ QList<SI_NetLabel*> Schematic::getNetLabelsAtScenePos(const Point& pos) const
 QList<SI_SymbolPin*> Schematic::getPinsAtScenePos(const Point& pos) const
     noexcept {
   QList<SI_SymbolPin*> list;
-  foreach (SI_Symbol* symbol, mSymbols) {
-    foreach (SI_SymbolPin* pin, symbol->getPins()) {
-      if (pin->getGrabAreaScenePx().contains(pos.toPxQPointF()))
-        list.append(pin);
+  foreach (SI_Base* item, getItemsAtScenePosPx(pos.toPxQPointF())) {
+    if (item->getType() == SI_Base::Type_t::SymbolPin) {
+      list.append(static_cast<SI_SymbolPin*>(item));
     }
   }
   return list;
@@ -355,14 +364,14 @@ void Schematic::removeFromProject() {
   sgl.dismiss();
 }
 
-bool Schematic::save(bool toOriginal, QStringList& errors) noexcept {
+bool Schematic::save(bool toOriginal, SmartSExprFileBatch& batch,
+                     QStringList& errors) noexcept {
   bool success = true;
 
   // save schematic file
   try {
     if (mIsAddedToProject) {
-      SExpression doc(serializeToDomElement("librepcb_schematic"));
-      mFile->save(doc, toOriginal);
+      batch.add(*mFile, serializeToDomElement("librepcb_schematic"));
     } else {
       mFile->removeFile(toOriginal);
     }
@@ -383,23 +392,34 @@ void Schematic::setSelectionRect(const Point& p1, const Point& p2,
   mGraphicsScene->setSelectionRect(p1, p2);
   if (updateItems) {
     QRectF rectPx = QRectF(p1.toPxQPointF(), p2.toPxQPointF()).normalized();
-    foreach (SI_Symbol* symbol, mSymbols) {
-      bool selectSymbol = symbol->getGrabAreaScenePx().intersects(rectPx);
-      symbol->setSelected(selectSymbol);
-      foreach (SI_SymbolPin* pin, symbol->getPins()) {
-        bool selectPin = pin->getGrabAreaScenePx().intersects(rectPx);
-        pin->setSelected(selectSymbol || selectPin);
+    QSet<SI_Base*> selectedItems;
+    foreach (SI_Base* item, mItemIndex.find(rectPx)) {
+      if (item->getGrabAreaScenePx().intersects(rectPx)) {
+        selectedItems.insert(item);
+        if (item->getType() == SI_Base::Type_t::Symbol) {
+          // selecting a symbol also selects all its pins
+          SI_Symbol* symbol = static_cast<SI_Symbol*>(item);
+          foreach (SI_SymbolPin* pin, symbol->getPins()) {
+            selectedItems.insert(pin);
+          }
+        }
       }
     }
-    foreach (SI_NetSegment* segment, mNetSegments) {
-      segment->setSelectionRect(rectPx);
+    foreach (SI_Base* item, mSelectedItems.values()) {
+      if (mItemIndex.contains(*item) && (!selectedItems.contains(item))) {
+        item->setSelected(false);
+      }
     }
+    foreach (SI_Base* item, selectedItems) { item->setSelected(true); }
   }
 }
 
 void Schematic::clearSelection() const noexcept {
-  foreach (SI_Symbol* symbol, mSymbols) { symbol->setSelected(false); }
-  foreach (SI_NetSegment* segment, mNetSegments) { segment->clearSelection(); }
+  foreach (SI_Base* item, mSelectedItems.values()) {
+    if (mItemIndex.contains(*item)) {
+      item->setSelected(false);
+    }
+  }
 }
 
 void Schematic::updateAllNetLabelAnchors() noexcept {
@@ -417,7 +437,39 @@ void Schematic::renderToQPainter(QPainter& painter) const noexcept {
 std::unique_ptr<SchematicSelectionQuery> Schematic::createSelectionQuery() const
     noexcept {
   return std::unique_ptr<SchematicSelectionQuery>(new SchematicSelectionQuery(
-      mSymbols, mNetSegments, const_cast<Schematic*>(this)));
+      mSelectedItems, const_cast<Schematic*>(this)));
+}
+
+/*******************************************************************************
+ *  Item Index Methods
+ ******************************************************************************/
+
+void Schematic::registerItem(SI_Base& item) noexcept {
+  if (item.getType() != SI_Base::Type_t::NetSegment) {
+    mItemIndex.insert(item);
+    mItemOrder.clear();
+  }
+  if (item.isSelected()) {
+    mSelectedItems.insert(&item);
+  }
+}
+
+void Schematic::unregisterItem(SI_Base& item) noexcept {
+  mItemIndex.remove(item);
+  mItemOrder.remove(&item);
+  mSelectedItems.remove(&item);
+}
+
+void Schematic::updateItemGrabArea(SI_Base& item) noexcept {
+  mItemIndex.update(item);
+}
+
+void Schematic::updateItemSelection(SI_Base& item) noexcept {
+  if (item.isSelected()) {
+    mSelectedItems.insert(&item);
+  } else {
+    mSelectedItems.remove(&item);
+  }
 }
 
 /*******************************************************************************
@@ -466,6 +518,47 @@ void Schematic::serialize(SExpression& root) const {
   root.appendLineBreak();
 }
 
+QVector<SI_Base*> Schematic::getItemsAtScenePosPx(const QPointF& posPx) const
+    noexcept {
+  QVector<SI_Base*> items;
+  foreach (SI_Base* item, mItemIndex.find(posPx)) {
+    if (item->getGrabAreaScenePx().contains(posPx)) {
+      items.append(item);
+    }
+  }
+  sortByModelOrder(items);
+  return items;
+}
+
+void Schematic::sortByModelOrder(QVector<SI_Base*>& items) const noexcept {
+  // same as Board::sortByModelOrder()
+  if (mItemOrder.isEmpty()) {
+    mItemOrder.reserve(mItemIndex.getCount());
+    foreach (const SI_NetSegment* segment, mNetSegments) {
+      foreach (const SI_NetPoint* netpoint, segment->getNetPoints()) {
+        mItemOrder.insert(netpoint, mItemOrder.count());
+      }
+      foreach (const SI_NetLine* netline, segment->getNetLines()) {
+        mItemOrder.insert(netline, mItemOrder.count());
+      }
+      foreach (const SI_NetLabel* netlabel, segment->getNetLabels()) {
+        mItemOrder.insert(netlabel, mItemOrder.count());
+      }
+    }
+    foreach (const SI_Symbol* symbol, mSymbols) {
+      foreach (const SI_SymbolPin* pin, symbol->getPins()) {
+        mItemOrder.insert(pin, mItemOrder.count());
+      }
+      mItemOrder.insert(symbol, mItemOrder.count());
+    }
+  }
+  std::stable_sort(items.begin(), items.end(),
+                   [this](const SI_Base* a, const SI_Base* b) {
+                     return mItemOrder.value(a, INT_MAX) <
+                            mItemOrder.value(b, INT_MAX);
+                   });
+}
+
 /*******************************************************************************
  *  Static Methods
  ******************************************************************************/
@@ -29,6 +29,7 @@
 #include <librepcb/common/fileio/filepath.h>
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/units/all_length_units.h>
+#include <librepcb/common/utils/spatialindex.h>
 #include <librepcb/common/uuid.h>
 
 #include <QtCore>
@@ -45,6 +46,7 @@ class GridProperties;
 class GraphicsView;
 class GraphicsScene;
 class SmartSExprFile;
+class SmartSExprFileBatch;
 
 namespace project {
 
@@ -152,7 +154,8 @@ public:
   // General Methods
   void addToProject();
   void removeFromProject();
-  bool save(bool toOriginal, QStringList& errors) noexcept;
+  bool save(bool toOriginal, SmartSExprFileBatch& batch,
+            QStringList& errors) noexcept;
   void showInView(GraphicsView& view) noexcept;
   void saveViewSceneRect(const QRectF& rect) noexcept { mViewRect = rect; }
   const QRectF& restoreViewSceneRect() const noexcept { return mViewRect; }
@@ -164,6 +167,12 @@ public:
   std::unique_ptr<SchematicSelectionQuery> createSelectionQuery() const
       noexcept;
 
+  // Item Index Methods (called by SI_Base when adding/modifying/removing items)
+  void registerItem(SI_Base& item) noexcept;
+  void unregisterItem(SI_Base& item) noexcept;
+  void updateItemGrabArea(SI_Base& item) noexcept;
+  void updateItemSelection(SI_Base& item) noexcept;
+
   // Inherited from AttributeProvider
   /// @copydoc librepcb::AttributeProvider::getBuiltInAttributeValue()
   QString getBuiltInAttributeValue(const QString& key) const noexcept override;
@@ -189,6 +198,8 @@ private:
   Schematic(Project& project, const FilePath& filepath, bool restore,
             bool readOnly, bool create, const QString& newName);
   void updateIcon() noexcept;
+  QVector<SI_Base*> getItemsAtScenePosPx(const QPointF& posPx) const noexcept;
+  void sortByModelOrder(QVector<SI_Base*>& items) const noexcept;
 
   /// @copydoc librepcb::SerializableObject::serialize()
   void serialize(SExpression& root) const override;
@@ -211,6 +222,15 @@ private:
 
   QList<SI_Symbol*>     mSymbols;
   QList<SI_NetSegment*> mNetSegments;
+
+  /// Bounding rectangles of all items except net segments
+  mutable SpatialIndex<SI_Base> mItemIndex;
+
+  /// Position of each indexed item in the model (empty if outdated)
+  mutable QHash<const SI_Base*, int> mItemOrder;
+
+  /// All currently selected items which are added to the schematic
+  QSet<SI_Base*> mSelectedItems;
 };
 
 /*******************************************************************************
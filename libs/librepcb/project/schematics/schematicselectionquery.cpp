@@ -43,9 +43,8 @@ namespace project {
  ******************************************************************************/
 
 SchematicSelectionQuery::SchematicSelectionQuery(
-    const QList<SI_Symbol*>& symbols, const QList<SI_NetSegment*>& netsegments,
-    QObject* parent)
-  : QObject(parent), mSymbols(symbols), mNetSegments(netsegments) {
+    const QSet<SI_Base*>& selectedItems, QObject* parent)
+  : QObject(parent), mSelectedItems(selectedItems) {
 }
 
 SchematicSelectionQuery::~SchematicSelectionQuery() noexcept {
@@ -65,39 +64,33 @@ int SchematicSelectionQuery::getResultCount() const noexcept {
  ******************************************************************************/
 
 void SchematicSelectionQuery::addSelectedSymbols() noexcept {
-  foreach (SI_Symbol* symbol, mSymbols) {
-    if (symbol->isSelected()) {
-      mResultSymbols.insert(symbol);
+  foreach (SI_Base* item, mSelectedItems) {
+    if (item->getType() == SI_Base::Type_t::Symbol) {
+      mResultSymbols.insert(static_cast<SI_Symbol*>(item));
     }
   }
 }
 
 void SchematicSelectionQuery::addSelectedNetPoints() noexcept {
-  foreach (SI_NetSegment* netsegment, mNetSegments) {
-    foreach (SI_NetPoint* netpoint, netsegment->getNetPoints()) {
-      if (netpoint->isSelected()) {
-        mResultNetPoints.insert(netpoint);
-      }
+  foreach (SI_Base* item, mSelectedItems) {
+    if (item->getType() == SI_Base::Type_t::NetPoint) {
+      mResultNetPoints.insert(static_cast<SI_NetPoint*>(item));
     }
   }
 }
 
 void SchematicSelectionQuery::addSelectedNetLines() noexcept {
-  foreach (SI_NetSegment* netsegment, mNetSegments) {
-    foreach (SI_NetLine* netline, netsegment->getNetLines()) {
-      if (netline->isSelected()) {
-        mResultNetLines.insert(netline);
-      }
+  foreach (SI_Base* item, mSelectedItems) {
+    if (item->getType() == SI_Base::Type_t::NetLine) {
+      mResultNetLines.insert(static_cast<SI_NetLine*>(item));
     }
   }
 }
 
 void SchematicSelectionQuery::addSelectedNetLabels() noexcept {
-  foreach (SI_NetSegment* netsegment, mNetSegments) {
-    foreach (SI_NetLabel* netlabel, netsegment->getNetLabels()) {
-      if (netlabel->isSelected()) {
-        mResultNetLabels.insert(netlabel);
-      }
+  foreach (SI_Base* item, mSelectedItems) {
+    if (item->getType() == SI_Base::Type_t::NetLabel) {
+      mResultNetLabels.insert(static_cast<SI_NetLabel*>(item));
     }
   }
 }
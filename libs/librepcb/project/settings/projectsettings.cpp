@@ -26,6 +26,7 @@
 
 #include <librepcb/common/fileio/sexpression.h>
 #include <librepcb/common/fileio/smartsexprfile.h>
+#include <librepcb/common/fileio/smartsexprfilebatch.h>
 
 #include <QtCore>
 
@@ -103,13 +104,13 @@ void ProjectSettings::triggerSettingsChanged() noexcept {
   emit settingsChanged();
 }
 
-bool ProjectSettings::save(bool toOriginal, QStringList& errors) noexcept {
+bool ProjectSettings::save(bool toOriginal, SmartSExprFileBatch& batch,
+                           QStringList& errors) noexcept {
   bool success = true;
 
   // Save "project/settings.lp"
   try {
-    SExpression doc(serializeToDomElement("librepcb_project_settings"));
-    mFile->save(doc, toOriginal);
+    batch.add(*mFile, serializeToDomElement("librepcb_project_settings"));
   } catch (Exception& e) {
     success = false;
     errors.append(e.getMsg());
@@ -34,6 +34,7 @@
 namespace librepcb {
 
 class SmartSExprFile;
+class SmartSExprFileBatch;
 
 namespace project {
 
@@ -74,7 +75,8 @@ public:
   // General Methods
   void restoreDefaults() noexcept;
   void triggerSettingsChanged() noexcept;
-  bool save(bool toOriginal, QStringList& errors) noexcept;
+  bool save(bool toOriginal, SmartSExprFileBatch& batch,
+            QStringList& errors) noexcept;
 
 signals:
 
@@ -535,8 +535,7 @@ void BoardEditor::on_actionModifyDesignRules_triggered() {
 void BoardEditor::on_actionRebuildPlanes_triggered() {
   Board* board = getActiveBoard();
   if (board) {
-    board->rebuildAllPlanes();
-    board->forceAirWiresRebuild();
+    board->rebuildAllPlanesInBackground();  // rebuilds airwires when done
   }
 }
 
@@ -172,7 +172,7 @@ void FabricationOutputDialog::on_btnGenerate_clicked() {
 
     // generate files
     BoardGerberExport grbExport(mBoard);
-    grbExport.exportAllLayers();
+    grbExport.exportAllLayersConcurrently();
   } catch (Exception& e) {
     QMessageBox::warning(this, tr("Error"), e.getMsg());
   }
@@ -28,6 +28,7 @@
 #include "schematiceditor/schematiceditor.h"
 
 #include <librepcb/common/undostack.h>
+#include <librepcb/project/erc/ercmsglist.h>
 #include <librepcb/project/project.h>
 #include <librepcb/workspace/settings/workspacesettings.h>
 #include <librepcb/workspace/workspace.h>
@@ -69,6 +70,13 @@ ProjectEditor::ProjectEditor(workspace::Workspace& workspace, Project& project)
     throw;  // ...and rethrow the exception
   }
 
+  // evaluate deferred ERC messages as soon as a transaction is finished
+  ErcScheduler& ercScheduler = mProject.getErcMsgList().getScheduler();
+  connect(mUndoStack, &UndoStack::commandGroupEnded, &ercScheduler,
+          &ErcScheduler::flush);
+  connect(mUndoStack, &UndoStack::commandGroupAborted, &ercScheduler,
+          &ErcScheduler::flush);
+
   // setup the timer for automatic backups, if enabled in the settings
   int intervalSecs =
       mWorkspace.getSettings().getProjectAutosaveInterval().getInterval();
@@ -583,7 +583,10 @@ void WorkspaceLibraryDb::createAllTables() {
       "`filepath` TEXT UNIQUE NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
-      "`parent_uuid` TEXT"
+      "`parent_uuid` TEXT, "
+      "`dir_modified` INTEGER NOT NULL, "
+      "`dir_size` INTEGER NOT NULL, "
+      "`dir_hash` BLOB"
       ")");
   queries << QString(
       "CREATE TABLE IF NOT EXISTS component_categories_tr ("
@@ -604,7 +607,10 @@ void WorkspaceLibraryDb::createAllTables() {
       "`filepath` TEXT UNIQUE NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
-      "`parent_uuid` TEXT"
+      "`parent_uuid` TEXT, "
+      "`dir_modified` INTEGER NOT NULL, "
+      "`dir_size` INTEGER NOT NULL, "
+      "`dir_hash` BLOB"
       ")");
   queries << QString(
       "CREATE TABLE IF NOT EXISTS package_categories_tr ("
@@ -624,7 +630,10 @@ void WorkspaceLibraryDb::createAllTables() {
       "`lib_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
       "`uuid` TEXT NOT NULL, "
-      "`version` TEXT NOT NULL"
+      "`version` TEXT NOT NULL, "
+      "`dir_modified` INTEGER NOT NULL, "
+      "`dir_size` INTEGER NOT NULL, "
+      "`dir_hash` BLOB"
       ")");
   queries << QString(
       "CREATE TABLE IF NOT EXISTS symbols_tr ("
@@ -651,7 +660,10 @@ void WorkspaceLibraryDb::createAllTables() {
       "`lib_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
       "`uuid` TEXT NOT NULL, "
-      "`version` TEXT NOT NULL "
+      "`version` TEXT NOT NULL, "
+      "`dir_modified` INTEGER NOT NULL, "
+      "`dir_size` INTEGER NOT NULL, "
+      "`dir_hash` BLOB"
       ")");
   queries << QString(
       "CREATE TABLE IF NOT EXISTS packages_tr ("
@@ -678,7 +690,10 @@ void WorkspaceLibraryDb::createAllTables() {
       "`lib_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
       "`uuid` TEXT NOT NULL, "
-      "`version` TEXT NOT NULL"
+      "`version` TEXT NOT NULL, "
+      "`dir_modified` INTEGER NOT NULL, "
+      "`dir_size` INTEGER NOT NULL, "
+      "`dir_hash` BLOB"
       ")");
   queries << QString(
       "CREATE TABLE IF NOT EXISTS components_tr ("
@@ -707,7 +722,10 @@ void WorkspaceLibraryDb::createAllTables() {
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
       "`component_uuid` TEXT NOT NULL, "
-      "`package_uuid` TEXT NOT NULL"
+      "`package_uuid` TEXT NOT NULL, "
+      "`dir_modified` INTEGER NOT NULL, "
+      "`dir_size` INTEGER NOT NULL, "
+      "`dir_hash` BLOB"
       ")");
   queries << QString(
       "CREATE TABLE IF NOT EXISTS devices_tr ("
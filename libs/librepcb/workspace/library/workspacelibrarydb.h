@@ -112,6 +112,8 @@ public:
 
   /**
    * @brief Rescan the whole library directory and update the SQLite database
+   *
+   * Only added, modified or removed elements are updated in the database.
    */
   void startLibraryRescan() noexcept;
 
@@ -157,7 +159,7 @@ private:
   QScopedPointer<WorkspaceLibraryScanner> mLibraryScanner;
 
   // Constants
-  static const int sCurrentDbVersion = 1;
+  static const int sCurrentDbVersion = 2;
 };
 
 /*******************************************************************************
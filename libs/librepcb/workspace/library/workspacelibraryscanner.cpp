@@ -27,8 +27,11 @@
 #include <librepcb/common/sqlitedatabase.h>
 #include <librepcb/library/elements.h>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 
+#include <type_traits>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -72,6 +75,13 @@ QVariant WorkspaceLibraryScanner::optionalToVariant(
   return opt ? **opt : QVariant();
 }
 
+template <>
+WorkspaceLibraryScanner::ElementMetadata
+    WorkspaceLibraryScanner::readElementMetadata<Device>(const FilePath& dir) {
+  Device element(dir, true, true);  // can throw
+  return getElementMetadata(element);
+}
+
 void WorkspaceLibraryScanner::run() noexcept {
   try {
     mAbort = false;
@@ -90,43 +100,66 @@ void WorkspaceLibraryScanner::run() noexcept {
     // begin database transaction
     SQLiteDatabase::TransactionScopeGuard transactionGuard(db);  // can throw
 
-    // clear all tables
-    clearAllTables(db);
+    // get the current content of the database
+    QHash<QString, int> libIds  = getLibraryIds(db);  // can throw
+    CachedElements      cmpCats = getCachedElements(db, "component_categories");
+    CachedElements      pkgCats = getCachedElements(db, "package_categories");
+    CachedElements      symbols = getCachedElements(db, "symbols");
+    CachedElements      packages   = getCachedElements(db, "packages");
+    CachedElements      components = getCachedElements(db, "components");
+    CachedElements      devices    = getCachedElements(db, "devices");
 
     // scan all libraries
     int   count   = 0;
     qreal percent = 0;
     foreach (const QSharedPointer<Library>& lib, libraries) {
-      int libId = addLibraryToDb(db, lib);
+      int libId = updateLibraryInDb(db, lib, libIds);
       if (mAbort) break;
-      count += addCategoriesToDb<ComponentCategory>(
+      count += updateElementsInDb<ComponentCategory>(
           db, lib->searchForElements<ComponentCategory>(),
-          "component_categories", "cat_id", libId);
+          "component_categories", "cat_id", libId, cmpCats);
       emit progressUpdate(percent += qreal(100) / (libraries.count() * 6));
       if (mAbort) break;
-      count += addCategoriesToDb<PackageCategory>(
+      count += updateElementsInDb<PackageCategory>(
           db, lib->searchForElements<PackageCategory>(), "package_categories",
-          "cat_id", libId);
+          "cat_id", libId, pkgCats);
       emit progressUpdate(percent += qreal(100) / (libraries.count() * 6));
       if (mAbort) break;
-      count += addElementsToDb<Symbol>(db, lib->searchForElements<Symbol>(),
-                                       "symbols", "symbol_id", libId);
+      count += updateElementsInDb<Symbol>(db, lib->searchForElements<Symbol>(),
+                                          "symbols", "symbol_id", libId,
+                                          symbols);
       emit progressUpdate(percent += qreal(100) / (libraries.count() * 6));
       if (mAbort) break;
-      count += addElementsToDb<Package>(db, lib->searchForElements<Package>(),
-                                        "packages", "package_id", libId);
+      count += updateElementsInDb<Package>(
+          db, lib->searchForElements<Package>(), "packages", "package_id",
+          libId, packages);
       emit progressUpdate(percent += qreal(100) / (libraries.count() * 6));
       if (mAbort) break;
-      count +=
-          addElementsToDb<Component>(db, lib->searchForElements<Component>(),
-                                     "components", "component_id", libId);
+      count += updateElementsInDb<Component>(
+          db, lib->searchForElements<Component>(), "components",
+          "component_id", libId, components);
       emit progressUpdate(percent += qreal(100) / (libraries.count() * 6));
       if (mAbort) break;
-      count += addDevicesToDb(db, lib->searchForElements<Device>(), "devices",
-                              "device_id", libId);
+      count += updateElementsInDb<Device>(db, lib->searchForElements<Device>(),
+                                          "devices", "device_id", libId,
+                                          devices);
       emit progressUpdate(percent += qreal(100) / (libraries.count() * 6));
     }
 
+    // remove all elements and libraries which no longer exist
+    if (!mAbort) {
+      removeElementsFromDb<ComponentCategory>(db, "component_categories",
+                                              "cat_id", cmpCats);
+      removeElementsFromDb<PackageCategory>(db, "package_categories",
+                                            "cat_id", pkgCats);
+      removeElementsFromDb<Symbol>(db, "symbols", "symbol_id", symbols);
+      removeElementsFromDb<Package>(db, "packages", "package_id", packages);
+      removeElementsFromDb<Component>(db, "components", "component_id",
+                                      components);
+      removeElementsFromDb<Device>(db, "devices", "device_id", devices);
+      removeLibrariesFromDb(db, libIds);
+    }
+
     // commit transaction
     if (!mAbort) {
       transactionGuard.commit();  // can throw
@@ -137,51 +170,36 @@ void WorkspaceLibraryScanner::run() noexcept {
   }
 }
 
-void WorkspaceLibraryScanner::clearAllTables(SQLiteDatabase& db) {
-  // libraries
-  db.clearTable("libraries_tr");
-  db.clearTable("libraries");
-
-  // component categories
-  db.clearTable("component_categories_tr");
-  db.clearTable("component_categories");
-
-  // package categories
-  db.clearTable("package_categories_tr");
-  db.clearTable("package_categories");
-
-  // symbols
-  db.clearTable("symbols_tr");
-  db.clearTable("symbols_cat");
-  db.clearTable("symbols");
-
-  // packages
-  db.clearTable("packages_tr");
-  db.clearTable("packages_cat");
-  db.clearTable("packages");
-
-  // components
-  db.clearTable("components_tr");
-  db.clearTable("components_cat");
-  db.clearTable("components");
-
-  // devices
-  db.clearTable("devices_tr");
-  db.clearTable("devices_cat");
-  db.clearTable("devices");
-}
-
-int WorkspaceLibraryScanner::addLibraryToDb(
-    SQLiteDatabase& db, const QSharedPointer<library::Library>& lib) {
-  QSqlQuery query = db.prepareQuery(
-      "INSERT INTO libraries "
-      "(filepath, uuid, version) VALUES "
-      "(:filepath, :uuid, :version)");
-  query.bindValue(":filepath",
-                  lib->getFilePath().toRelative(mWorkspace.getLibrariesPath()));
-  query.bindValue(":uuid", lib->getUuid().toStr());
-  query.bindValue(":version", lib->getVersion().toStr());
-  int id = db.insert(query);
+int WorkspaceLibraryScanner::updateLibraryInDb(
+    SQLiteDatabase& db, const QSharedPointer<library::Library>& lib,
+    QHash<QString, int>& libIds) {
+  // Libraries are already loaded by the workspace, so there's no need to check
+  // their file state. Just update the existing row to keep its ID stable.
+  QString filepath =
+      lib->getFilePath().toRelative(mWorkspace.getLibrariesPath());
+  int id = libIds.take(filepath);
+  if (id > 0) {
+    QSqlQuery query = db.prepareQuery(
+        "UPDATE libraries SET uuid = :uuid, version = :version "
+        "WHERE id = :id");
+    query.bindValue(":uuid", lib->getUuid().toStr());
+    query.bindValue(":version", lib->getVersion().toStr());
+    query.bindValue(":id", id);
+    db.exec(query);
+    QSqlQuery deleteQuery =
+        db.prepareQuery("DELETE FROM libraries_tr WHERE lib_id = :id");
+    deleteQuery.bindValue(":id", id);
+    db.exec(deleteQuery);
+  } else {
+    QSqlQuery query = db.prepareQuery(
+        "INSERT INTO libraries "
+        "(filepath, uuid, version) VALUES "
+        "(:filepath, :uuid, :version)");
+    query.bindValue(":filepath", filepath);
+    query.bindValue(":uuid", lib->getUuid().toStr());
+    query.bindValue(":version", lib->getVersion().toStr());
+    id = db.insert(query);
+  }
   foreach (const QString& locale, lib->getAllAvailableLocales()) {
     QSqlQuery query = db.prepareQuery(
         "INSERT INTO libraries_tr "
@@ -199,178 +217,358 @@ int WorkspaceLibraryScanner::addLibraryToDb(
   return id;
 }
 
+void WorkspaceLibraryScanner::removeLibrariesFromDb(
+    SQLiteDatabase& db, const QHash<QString, int>& libIds) {
+  foreach (int id, libIds) {
+    QSqlQuery trQuery =
+        db.prepareQuery("DELETE FROM libraries_tr WHERE lib_id = :id");
+    trQuery.bindValue(":id", id);
+    db.exec(trQuery);
+    QSqlQuery query = db.prepareQuery("DELETE FROM libraries WHERE id = :id");
+    query.bindValue(":id", id);
+    db.exec(query);
+  }
+}
+
 template <typename ElementType>
-int WorkspaceLibraryScanner::addCategoriesToDb(SQLiteDatabase&        db,
-                                               const QList<FilePath>& dirs,
-                                               const QString&         table,
-                                               const QString&         idColumn,
-                                               int                    libId) {
-  int count = 0;
-  foreach (const FilePath& filepath, dirs) {
-    if (mAbort) break;
-    try {
-      ElementType element(filepath, true);  // can throw
-      QSqlQuery   query = db.prepareQuery(
-          "INSERT INTO " % table %
-          " "
-          "(lib_id, filepath, uuid, version, parent_uuid) VALUES "
-          "(:lib_id, :filepath, :uuid, :version, :parent_uuid)");
-      query.bindValue(":lib_id", libId);
-      query.bindValue(":filepath",
-                      filepath.toRelative(mWorkspace.getLibrariesPath()));
-      query.bindValue(":uuid", element.getUuid().toStr());
-      query.bindValue(":version", element.getVersion().toStr());
-      query.bindValue(":parent_uuid", element.getParentUuid()
-                                          ? element.getParentUuid()->toStr()
-                                          : QVariant(QVariant::String));
-      int id = db.insert(query);
-      foreach (const QString& locale, element.getAllAvailableLocales()) {
-        QSqlQuery query = db.prepareQuery(
-            "INSERT INTO " % table %
-            "_tr "
-            "(" %
-            idColumn %
-            ", locale, name, description, keywords) VALUES "
-            "(:element_id, :locale, :name, :description, :keywords)");
-        query.bindValue(":element_id", id);
-        query.bindValue(":locale", locale);
-        query.bindValue(":name",
-                        optionalToVariant(element.getNames().tryGet(locale)));
-        query.bindValue(
-            ":description",
-            optionalToVariant(element.getDescriptions().tryGet(locale)));
-        query.bindValue(":keywords", optionalToVariant(
-                                         element.getKeywords().tryGet(locale)));
-        db.insert(query);
+int WorkspaceLibraryScanner::updateElementsInDb(SQLiteDatabase&        db,
+                                                const QList<FilePath>& dirs,
+                                                const QString&         table,
+                                                const QString&         idColumn,
+                                                int                    libId,
+                                                CachedElements&        cache) {
+  // Determine which elements need to be updated. This only checks the file
+  // system state, so it is cheap compared to parsing the elements.
+  int                 count = 0;
+  QVector<ElementJob> jobs;
+  foreach (const FilePath& dir, dirs) {
+    if (mAbort) return count;
+    ElementJob job;
+    job.dir            = dir;
+    job.filepath       = dir.toRelative(mWorkspace.getLibrariesPath());
+    job.state          = getFileState(dir);
+    job.contentChanged = true;
+    CachedElements::iterator it = cache.find(job.filepath);
+    if (it != cache.end()) {
+      CachedElement cached = it.value();
+      cache.erase(it);  // all remaining elements will be removed afterwards
+      job.id = cached.id;
+      if (cached.libId == libId) {
+        if ((cached.state.modified == job.state.modified) &&
+            (cached.state.size == job.state.size)) {
+          count++;  // element is up to date
+          continue;
+        }
+        job.cachedHash = cached.state.hash;
       }
-      count++;
-    } catch (const Exception& e) {
-      qWarning() << "Failed to open library element:" << filepath.toNative();
     }
+    jobs.append(job);
   }
-  return count;
-}
 
-template <typename ElementType>
-int WorkspaceLibraryScanner::addElementsToDb(SQLiteDatabase&        db,
-                                             const QList<FilePath>& dirs,
-                                             const QString&         table,
-                                             const QString&         idColumn,
-                                             int                    libId) {
-  int count = 0;
-  foreach (const FilePath& filepath, dirs) {
+  // Parse the elements on the global thread pool and write them in batches
+  // to the database. Only this thread accesses the database.
+  QueryCache queries;
+  for (int i = 0; (i < jobs.count()) && (!mAbort); i += sBatchSize) {
+    QVector<ElementJob> batch = jobs.mid(i, sBatchSize);
+    QtConcurrent::blockingMap(
+        batch, [](ElementJob& job) { processElementJob<ElementType>(job); });
     if (mAbort) break;
-    try {
-      ElementType element(filepath, true);  // can throw
-      QSqlQuery   query =
-          db.prepareQuery("INSERT INTO " % table %
-                          " "
-                          "(lib_id, filepath, uuid, version) VALUES "
-                          "(:lib_id, :filepath, :uuid, :version)");
-      query.bindValue(":lib_id", libId);
-      query.bindValue(":filepath",
-                      filepath.toRelative(mWorkspace.getLibrariesPath()));
-      query.bindValue(":uuid", element.getUuid().toStr());
-      query.bindValue(":version", element.getVersion().toStr());
-      int id = db.insert(query);
-      foreach (const QString& locale, element.getAllAvailableLocales()) {
-        QSqlQuery query = db.prepareQuery(
-            "INSERT INTO " % table %
-            "_tr "
-            "(" %
-            idColumn %
-            ", locale, name, description, keywords) VALUES "
-            "(:element_id, :locale, :name, :description, :keywords)");
-        query.bindValue(":element_id", id);
-        query.bindValue(":locale", locale);
-        query.bindValue(":name",
-                        optionalToVariant(element.getNames().tryGet(locale)));
-        query.bindValue(
-            ":description",
-            optionalToVariant(element.getDescriptions().tryGet(locale)));
-        query.bindValue(":keywords", optionalToVariant(
-                                         element.getKeywords().tryGet(locale)));
-        db.insert(query);
-      }
-      foreach (const Uuid& categoryUuid, element.getCategories()) {
-        QSqlQuery query = db.prepareQuery("INSERT INTO " % table %
-                                          "_cat "
-                                          "(" %
-                                          idColumn %
-                                          ", category_uuid) VALUES "
-                                          "(:element_id, :category_uuid)");
-        query.bindValue(":element_id", id);
-        query.bindValue(":category_uuid", categoryUuid.toStr());
-        db.insert(query);
+    foreach (const ElementJob& job, batch) {
+      if (!job.contentChanged) {
+        updateFileStateInDb(db, queries, table, *job.id, job.state);
+        count++;
+      } else if (job.metadata) {
+        writeElementToDb(db, queries, table, idColumn, job.id, libId,
+                         job.filepath, job.state, *job.metadata,
+                         hasCategoryTable<ElementType>());
+        count++;
+      } else {
+        qWarning() << "Failed to open library element:" << job.dir.toNative();
+        if (job.id) {
+          removeElementFromDb(db, queries, table, idColumn, *job.id,
+                              hasCategoryTable<ElementType>());
+        }
       }
-      count++;
-    } catch (const Exception& e) {
-      qWarning() << "Failed to open library element:" << filepath.toNative();
     }
   }
   return count;
 }
 
-int WorkspaceLibraryScanner::addDevicesToDb(SQLiteDatabase&        db,
-                                            const QList<FilePath>& dirs,
-                                            const QString&         table,
-                                            const QString&         idColumn,
-                                            int                    libId) {
-  int count = 0;
-  foreach (const FilePath& filepath, dirs) {
-    if (mAbort) break;
-    try {
-      Device    element(filepath, true);  // can throw
-      QSqlQuery query = db.prepareQuery("INSERT INTO " % table %
-                                        " "
-                                        "(lib_id, filepath, uuid, version, "
-                                        "component_uuid, package_uuid) VALUES "
-                                        "(:lib_id, :filepath, :uuid, :version, "
-                                        ":component_uuid, :package_uuid)");
-      query.bindValue(":lib_id", libId);
-      query.bindValue(":filepath",
-                      filepath.toRelative(mWorkspace.getLibrariesPath()));
-      query.bindValue(":uuid", element.getUuid().toStr());
-      query.bindValue(":version", element.getVersion().toStr());
-      query.bindValue(":component_uuid", element.getComponentUuid().toStr());
-      query.bindValue(":package_uuid", element.getPackageUuid().toStr());
-      int id = db.insert(query);
-      foreach (const QString& locale, element.getAllAvailableLocales()) {
-        QSqlQuery query = db.prepareQuery(
-            "INSERT INTO " % table %
-            "_tr "
-            "(" %
-            idColumn %
+template <typename ElementType>
+void WorkspaceLibraryScanner::removeElementsFromDb(
+    SQLiteDatabase& db, const QString& table, const QString& idColumn,
+    const CachedElements& cache) {
+  QueryCache queries;
+  foreach (const CachedElement& cached, cache) {
+    removeElementFromDb(db, queries, table, idColumn, cached.id,
+                        hasCategoryTable<ElementType>());
+  }
+}
+
+int WorkspaceLibraryScanner::writeElementToDb(
+    SQLiteDatabase& db, QueryCache& queries, const QString& table,
+    const QString& idColumn, const tl::optional<int>& id, int libId,
+    const QString& filepath, const FileState& state,
+    const ElementMetadata& metadata, bool hasCategories) {
+  QList<QPair<QString, QVariant>> columns;
+  columns.append(qMakePair(QString("lib_id"), QVariant(libId)));
+  columns.append(qMakePair(QString("filepath"), QVariant(filepath)));
+  columns.append(qMakePair(QString("uuid"), QVariant(metadata.uuid)));
+  columns.append(qMakePair(QString("version"), QVariant(metadata.version)));
+  columns.append(qMakePair(QString("dir_modified"), QVariant(state.modified)));
+  columns.append(qMakePair(QString("dir_size"), QVariant(state.size)));
+  columns.append(qMakePair(QString("dir_hash"), QVariant(state.hash)));
+  columns.append(metadata.columns);
+
+  // insert or update the element itself
+  QStringList names;
+  QStringList assignments;
+  for (const auto& column : columns) {
+    names.append(column.first);
+    assignments.append(column.first % " = :" % column.first);
+  }
+  int elementId;
+  if (id) {
+    QSqlQuery& query = prepareQuery(db, queries,
+                                    "UPDATE " % table % " SET " %
+                                        assignments.join(", ") %
+                                        " WHERE id = :id");
+    for (const auto& column : columns) {
+      query.bindValue(":" % column.first, column.second);
+    }
+    query.bindValue(":id", *id);
+    db.exec(query);
+    elementId = *id;
+
+    // remove old translations and categories, they are added again below
+    removeElementFromDb(db, queries, table, idColumn, elementId, hasCategories,
+                        false);
+  } else {
+    QSqlQuery& query =
+        prepareQuery(db, queries,
+                     "INSERT INTO " % table % " (" % names.join(", ") %
+                         ") VALUES (:" % names.join(", :") % ")");
+    for (const auto& column : columns) {
+      query.bindValue(":" % column.first, column.second);
+    }
+    elementId = db.insert(query);
+  }
+
+  // add translations and categories
+  foreach (const Translation& translation, metadata.translations) {
+    QSqlQuery& query = prepareQuery(
+        db, queries,
+        "INSERT INTO " % table % "_tr (" % idColumn %
             ", locale, name, description, keywords) VALUES "
             "(:element_id, :locale, :name, :description, :keywords)");
-        query.bindValue(":element_id", id);
-        query.bindValue(":locale", locale);
-        query.bindValue(":name",
-                        optionalToVariant(element.getNames().tryGet(locale)));
-        query.bindValue(
-            ":description",
-            optionalToVariant(element.getDescriptions().tryGet(locale)));
-        query.bindValue(":keywords", optionalToVariant(
-                                         element.getKeywords().tryGet(locale)));
-        db.insert(query);
-      }
-      foreach (const Uuid& categoryUuid, element.getCategories()) {
-        QSqlQuery query = db.prepareQuery("INSERT INTO " % table %
-                                          "_cat "
-                                          "(" %
-                                          idColumn %
-                                          ", category_uuid) VALUES "
-                                          "(:element_id, :category_uuid)");
-        query.bindValue(":element_id", id);
-        query.bindValue(":category_uuid", categoryUuid.toStr());
-        db.insert(query);
-      }
-      count++;
-    } catch (const Exception& e) {
-      qWarning() << "Failed to open library element:" << filepath.toNative();
+    query.bindValue(":element_id", elementId);
+    query.bindValue(":locale", translation.locale);
+    query.bindValue(":name", translation.name);
+    query.bindValue(":description", translation.description);
+    query.bindValue(":keywords", translation.keywords);
+    db.insert(query);
+  }
+  foreach (const Uuid& categoryUuid, metadata.categories) {
+    Q_ASSERT(hasCategories);
+    QSqlQuery& query =
+        prepareQuery(db, queries,
+                     "INSERT INTO " % table % "_cat (" % idColumn %
+                         ", category_uuid) VALUES "
+                         "(:element_id, :category_uuid)");
+    query.bindValue(":element_id", elementId);
+    query.bindValue(":category_uuid", categoryUuid.toStr());
+    db.insert(query);
+  }
+  return elementId;
+}
+
+void WorkspaceLibraryScanner::removeElementFromDb(
+    SQLiteDatabase& db, QueryCache& queries, const QString& table,
+    const QString& idColumn, int id, bool hasCategories, bool removeElement) {
+  QSqlQuery& trQuery = prepareQuery(
+      db, queries, "DELETE FROM " % table % "_tr WHERE " % idColumn % " = :id");
+  trQuery.bindValue(":id", id);
+  db.exec(trQuery);
+  if (hasCategories) {
+    QSqlQuery& catQuery =
+        prepareQuery(db, queries,
+                     "DELETE FROM " % table % "_cat WHERE " % idColumn %
+                         " = :id");
+    catQuery.bindValue(":id", id);
+    db.exec(catQuery);
+  }
+  if (removeElement) {
+    QSqlQuery& query = prepareQuery(
+        db, queries, "DELETE FROM " % table % " WHERE id = :id");
+    query.bindValue(":id", id);
+    db.exec(query);
+  }
+}
+
+void WorkspaceLibraryScanner::updateFileStateInDb(SQLiteDatabase&  db,
+                                                  QueryCache&      queries,
+                                                  const QString&   table,
+                                                  int              id,
+                                                  const FileState& state) {
+  QSqlQuery& query = prepareQuery(
+      db, queries,
+      "UPDATE " % table %
+          " SET dir_modified = :modified, dir_size = :size, dir_hash = :hash "
+          "WHERE id = :id");
+  query.bindValue(":modified", state.modified);
+  query.bindValue(":size", state.size);
+  query.bindValue(":hash", state.hash);
+  query.bindValue(":id", id);
+  db.exec(query);
+}
+
+QSqlQuery& WorkspaceLibraryScanner::prepareQuery(SQLiteDatabase& db,
+                                                 QueryCache&     queries,
+                                                 const QString&  sql) {
+  // Reusing prepared statements avoids compiling the same SQL statement again
+  // for every inserted row.
+  QueryCache::iterator it = queries.find(sql);
+  if (it == queries.end()) {
+    it = queries.insert(sql, db.prepareQuery(sql));  // can throw
+  }
+  return it.value();
+}
+
+QHash<QString, int> WorkspaceLibraryScanner::getLibraryIds(
+    SQLiteDatabase& db) {
+  QSqlQuery query = db.prepareQuery("SELECT id, filepath FROM libraries");
+  db.exec(query);
+  QHash<QString, int> ids;
+  while (query.next()) {
+    ids.insert(query.value(1).toString(), query.value(0).toInt());
+  }
+  return ids;
+}
+
+WorkspaceLibraryScanner::CachedElements
+    WorkspaceLibraryScanner::getCachedElements(SQLiteDatabase& db,
+                                               const QString&  table) {
+  QSqlQuery query = db.prepareQuery(
+      "SELECT id, lib_id, filepath, dir_modified, dir_size, dir_hash FROM " %
+      table);
+  db.exec(query);
+  CachedElements elements;
+  while (query.next()) {
+    CachedElement element;
+    element.id             = query.value(0).toInt();
+    element.libId          = query.value(1).toInt();
+    element.state.modified = query.value(3).toLongLong();
+    element.state.size     = query.value(4).toLongLong();
+    element.state.hash     = query.value(5).toByteArray();
+    elements.insert(query.value(2).toString(), element);
+  }
+  return elements;
+}
+
+WorkspaceLibraryScanner::FileState WorkspaceLibraryScanner::getFileState(
+    const FilePath& dir) noexcept {
+  // The modification time of the directory itself changes when files are
+  // added or removed, so it is taken into account as well.
+  QFileInfo dirInfo(dir.toStr());
+  FileState state{dirInfo.lastModified().toMSecsSinceEpoch(), 0, QByteArray()};
+  foreach (const QFileInfo& info,
+           QDir(dir.toStr())
+               .entryInfoList(QDir::Files | QDir::Hidden | QDir::System)) {
+    state.modified =
+        qMax(state.modified, info.lastModified().toMSecsSinceEpoch());
+    state.size += info.size();
+  }
+  return state;
+}
+
+QByteArray WorkspaceLibraryScanner::calcContentHash(
+    const FilePath& dir) noexcept {
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  foreach (const QFileInfo& info,
+           QDir(dir.toStr())
+               .entryInfoList(QDir::Files | QDir::Hidden | QDir::System,
+                              QDir::Name)) {
+    QFile file(info.absoluteFilePath());
+    if (!file.open(QIODevice::ReadOnly)) {
+      return QByteArray();  // force reparsing the element
     }
+    hash.addData(info.fileName().toUtf8());
+    hash.addData(QByteArray(1, '\0'));
+    hash.addData(&file);
   }
-  return count;
+  return hash.result();
+}
+
+template <typename ElementType>
+void WorkspaceLibraryScanner::processElementJob(ElementJob& job) noexcept {
+  job.state.hash = calcContentHash(job.dir);
+  if ((!job.state.hash.isEmpty()) && (job.state.hash == job.cachedHash)) {
+    job.contentChanged = false;  // only the file state needs to be updated
+    return;
+  }
+  try {
+    job.metadata = readElementMetadata<ElementType>(job.dir);  // can throw
+  } catch (const Exception& e) {
+    job.metadata = tl::nullopt;
+  }
+}
+
+template <typename ElementType>
+WorkspaceLibraryScanner::ElementMetadata
+    WorkspaceLibraryScanner::readElementMetadata(const FilePath& dir) {
+  // Only the metadata is needed, so the element is not loaded completely.
+  // Except for devices, all metadata is provided by the base classes.
+  typedef typename std::conditional<
+      std::is_base_of<LibraryCategory, ElementType>::value, LibraryCategory,
+      LibraryElement>::type BaseType;
+  BaseType element(dir, ElementType::getShortElementName(),
+                   ElementType::getLongElementName(), true,
+                   true);  // can throw
+  return getElementMetadata(element);
+}
+
+template <typename T>
+WorkspaceLibraryScanner::ElementMetadata
+    WorkspaceLibraryScanner::getElementMetadata(const T& element) {
+  ElementMetadata metadata;
+  metadata.uuid    = element.getUuid().toStr();
+  metadata.version = element.getVersion().toStr();
+  foreach (const QString& locale, element.getAllAvailableLocales()) {
+    metadata.translations.append(Translation{
+        locale, optionalToVariant(element.getNames().tryGet(locale)),
+        optionalToVariant(element.getDescriptions().tryGet(locale)),
+        optionalToVariant(element.getKeywords().tryGet(locale))});
+  }
+  addTypeSpecificMetadata(metadata, element);
+  return metadata;
+}
+
+void WorkspaceLibraryScanner::addTypeSpecificMetadata(
+    ElementMetadata& metadata, const LibraryCategory& element) {
+  const tl::optional<Uuid>& parent = element.getParentUuid();
+  metadata.columns.append(qMakePair(
+      QString("parent_uuid"),
+      parent ? QVariant(parent->toStr()) : QVariant(QVariant::String)));
+}
+
+void WorkspaceLibraryScanner::addTypeSpecificMetadata(
+    ElementMetadata& metadata, const LibraryElement& element) {
+  metadata.categories = element.getCategories();
+}
+
+void WorkspaceLibraryScanner::addTypeSpecificMetadata(
+    ElementMetadata& metadata, const Device& element) {
+  addTypeSpecificMetadata(metadata,
+                          static_cast<const LibraryElement&>(element));
+  metadata.columns.append(qMakePair(
+      QString("component_uuid"), QVariant(element.getComponentUuid().toStr())));
+  metadata.columns.append(qMakePair(
+      QString("package_uuid"), QVariant(element.getPackageUuid().toStr())));
+}
+
+template <typename ElementType>
+bool WorkspaceLibraryScanner::hasCategoryTable() noexcept {
+  return std::is_base_of<LibraryElement, ElementType>::value;
 }
 
 /*******************************************************************************
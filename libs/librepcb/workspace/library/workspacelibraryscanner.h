@@ -24,8 +24,10 @@
  *  Includes
  ******************************************************************************/
 #include <librepcb/common/exceptions.h>
+#include <librepcb/common/uuid.h>
 
 #include <QtCore>
+#include <QtSql>
 
 /*******************************************************************************
  *  Namespace / Forward Declarations
@@ -37,6 +39,9 @@ class SQLiteDatabase;
 
 namespace library {
 class Library;
+class LibraryCategory;
+class LibraryElement;
+class Device;
 }
 
 namespace workspace {
@@ -50,6 +55,21 @@ class Workspace;
 /**
  * @brief The WorkspaceLibraryScanner class
  *
+ * The scanner updates the library database incrementally: For every element
+ * directory, the modification time, the total file size and a hash of the
+ * content are stored in the database. On a rescan, only added or modified
+ * elements are parsed again, while the rows of unchanged elements are kept.
+ * Rows of elements which no longer exist are removed. If only the modification
+ * time or size changed but the content hash is still the same (e.g. after a
+ * "git checkout"), just the stored file state is updated.
+ *
+ * Elements which need to be parsed are processed in batches on the global
+ * thread pool, which only produces lightweight #ElementMetadata records. The
+ * database is exclusively accessed by the scanner thread, which writes these
+ * records within a single transaction, using prepared statements.
+ * Elements are opened in the metadata-only mode (see
+ * library::LibraryBaseElement), so their geometry is not parsed at all.
+ *
  * @warning Be very careful with dependencies to other objects as the #run()
  * method is executed in a separate thread! Keep the number of dependencies as
  * small as possible and consider thread synchronization and object lifetimes.
@@ -82,26 +102,108 @@ signals:
   void succeeded(int elementCount);
   void failed(QString errorMsg);
 
+private:  // Types
+  struct FileState {
+    qint64     modified;  ///< Latest modification time [ms since epoch]
+    qint64     size;      ///< Total size of all files [bytes]
+    QByteArray hash;      ///< Hash over all files (only calculated on demand)
+  };
+
+  struct CachedElement {
+    int       id;
+    int       libId;
+    FileState state;
+  };
+
+  /// Cached elements of a table, indexed by their relative filepath
+  typedef QHash<QString, CachedElement> CachedElements;
+
+  struct Translation {
+    QString  locale;
+    QVariant name;
+    QVariant description;
+    QVariant keywords;
+  };
+
+  struct ElementMetadata {
+    QString                         uuid;
+    QString                         version;
+    QList<QPair<QString, QVariant>> columns;  ///< Type specific columns
+    QList<Translation>              translations;
+    QSet<Uuid>                      categories;
+  };
+
+  /// An element to be processed on the thread pool
+  struct ElementJob {
+    FilePath          dir;
+    QString           filepath;    ///< Relative to the libraries directory
+    tl::optional<int> id;          ///< Row ID if already in the database
+    QByteArray        cachedHash;  ///< Hash stored in the database, if valid
+    FileState         state;
+    bool              contentChanged;
+    tl::optional<ElementMetadata> metadata;  ///< Not set if parsing failed
+  };
+
+  /// Prepared queries, indexed by their SQL statement
+  typedef QHash<QString, QSqlQuery> QueryCache;
+
 private:  // Methods
   void run() noexcept override;
-  void clearAllTables(SQLiteDatabase& db);
-  int  addLibraryToDb(SQLiteDatabase&                         db,
-                      const QSharedPointer<library::Library>& lib);
+  int  updateLibraryInDb(SQLiteDatabase&                         db,
+                         const QSharedPointer<library::Library>& lib,
+                         QHash<QString, int>&                    libIds);
+  void removeLibrariesFromDb(SQLiteDatabase&            db,
+                             const QHash<QString, int>& libIds);
+  template <typename ElementType>
+  int updateElementsInDb(SQLiteDatabase& db, const QList<FilePath>& dirs,
+                         const QString& table, const QString& idColumn,
+                         int libId, CachedElements& cache);
   template <typename ElementType>
-  int addCategoriesToDb(SQLiteDatabase& db, const QList<FilePath>& dirs,
+  void removeElementsFromDb(SQLiteDatabase& db, const QString& table,
+                            const QString&        idColumn,
+                            const CachedElements& cache);
+  int  writeElementToDb(SQLiteDatabase& db, QueryCache& queries,
                         const QString& table, const QString& idColumn,
-                        int libId);
+                        const tl::optional<int>& id, int libId,
+                        const QString& filepath, const FileState& state,
+                        const ElementMetadata& metadata, bool hasCategories);
+  void removeElementFromDb(SQLiteDatabase& db, QueryCache& queries,
+                           const QString& table, const QString& idColumn,
+                           int id, bool hasCategories,
+                           bool removeElement = true);
+  void updateFileStateInDb(SQLiteDatabase& db, QueryCache& queries,
+                           const QString& table, int id,
+                           const FileState& state);
+  static QSqlQuery&     prepareQuery(SQLiteDatabase& db, QueryCache& queries,
+                                     const QString& sql);
+  static QHash<QString, int> getLibraryIds(SQLiteDatabase& db);
+  static CachedElements      getCachedElements(SQLiteDatabase& db,
+                                               const QString&  table);
+  static FileState           getFileState(const FilePath& dir) noexcept;
+  static QByteArray          calcContentHash(const FilePath& dir) noexcept;
   template <typename ElementType>
-  int addElementsToDb(SQLiteDatabase& db, const QList<FilePath>& dirs,
-                      const QString& table, const QString& idColumn, int libId);
-  int addDevicesToDb(SQLiteDatabase& db, const QList<FilePath>& dirs,
-                     const QString& table, const QString& idColumn, int libId);
+  static void processElementJob(ElementJob& job) noexcept;
+  template <typename ElementType>
+  static ElementMetadata readElementMetadata(const FilePath& dir);
+  template <typename T>
+  static ElementMetadata getElementMetadata(const T& element);
+  static void addTypeSpecificMetadata(ElementMetadata&                 metadata,
+                                      const library::LibraryCategory& element);
+  static void addTypeSpecificMetadata(ElementMetadata&                metadata,
+                                      const library::LibraryElement& element);
+  static void addTypeSpecificMetadata(ElementMetadata&        metadata,
+                                      const library::Device& element);
+  template <typename ElementType>
+  static bool hasCategoryTable() noexcept;
   template <typename T>
   static QVariant optionalToVariant(const T& opt) noexcept;
 
 private:  // Data
   Workspace&    mWorkspace;
   volatile bool mAbort;
+
+  /// Number of elements parsed concurrently before writing them to the db
+  static constexpr int sBatchSize = 256;
 };
 
 /*******************************************************************************
@@ -47,9 +47,8 @@ RecentProjectsModel::RecentProjectsModel(const Workspace& workspace) noexcept
         mWorkspace.getMetadataPath().getPathTo("recent_projects.lp");
     if (filepath.isExistingFile()) {
       mFile.reset(new SmartSExprFile(filepath, false, false));
-      SExpression               root   = mFile->parseFileAndBuildDomTree();
-      const QList<SExpression>& childs = root.getChildren("project");
-      foreach (const SExpression& child, childs) {
+      SExpression root = mFile->parseFileAndBuildDomTree();
+      foreach (const SExpression& child, root.getChildren("project")) {
         QString  path    = child.getValueOfFirstChild<QString>(true);
         FilePath absPath = FilePath::fromRelative(mWorkspace.getPath(), path);
         mAllProjects.append(absPath);
@@ -9,8 +9,7 @@ SUBDIRS = \
     librepcb \
     optional \
     parseagle \
-    quazip \
-    sexpresso
+    quazip
 
 librepcb.depends = \
     clipper \
@@ -19,6 +18,5 @@ librepcb.depends = \
     optional \
     parseagle \
     hoedown \
-    quazip \
-    sexpresso \
+    quazip
 
@@ -0,0 +1,69 @@
+#-------------------------------------------------
+#
+# Project created 2026-10-17
+#
+#-------------------------------------------------
+
+TEMPLATE = app
+TARGET = librepcb-benchmarks
+
+# Use common project definitions
+include(../../common.pri)
+
+QT += core widgets network printsupport xml opengl sql concurrent
+
+CONFIG += console
+CONFIG -= app_bundle
+
+LIBS += \
+    -L$${DESTDIR} \
+    -lgoogletest \
+    -llibrepcbeagleimport \
+    -llibrepcbworkspace \
+    -llibrepcbproject \
+    -llibrepcblibrary \    # Note: The order of the libraries is very important for the linker!
+    -llibrepcbcommon \     # Another order could end up in "undefined reference" errors!
+    -lclipper \
+    -lparseagle -lquazip -lz
+
+INCLUDEPATH += \
+    ../../libs \
+    ../../libs/googletest/googletest/include \
+    ../../libs/googletest/googlemock/include \
+    ../../libs/parseagle \
+    ../../libs/quazip \
+    ../../libs/type_safe/include \
+    ../../libs/type_safe/external/debug_assert \
+
+DEPENDPATH += \
+    ../../libs/librepcb/eagleimport \
+    ../../libs/librepcb/workspace \
+    ../../libs/librepcb/project \
+    ../../libs/librepcb/library \
+    ../../libs/librepcb/common \
+    ../../libs/parseagle \
+    ../../libs/quazip \
+    ../../libs/clipper \
+
+PRE_TARGETDEPS += \
+    $${DESTDIR}/libgoogletest.a \
+    $${DESTDIR}/liblibrepcbeagleimport.a \
+    $${DESTDIR}/liblibrepcbworkspace.a \
+    $${DESTDIR}/liblibrepcbproject.a \
+    $${DESTDIR}/liblibrepcblibrary.a \
+    $${DESTDIR}/liblibrepcbcommon.a \
+    $${DESTDIR}/libquazip.a \
+    $${DESTDIR}/libclipper.a \
+
+SOURCES += \
+    common/fileio/sexpressionbenchmark.cpp \
+    common/fileio/smartsexprfilebatchbenchmark.cpp \
+    main.cpp \
+    project/boards/boardairwiresgraphbenchmark.cpp \
+    project/boards/boardcamsnapshotbenchmark.cpp \
+    project/boards/boardplanefragmentsbuilderbenchmark.cpp \
+    workspace/library/workspacelibraryscannerbenchmark.cpp \
+
+HEADERS += \
+
+FORMS += \
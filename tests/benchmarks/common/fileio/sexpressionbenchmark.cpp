@@ -0,0 +1,98 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/sexpression.h>
+#include <librepcb/common/uuid.h>
+
+#include <QtCore>
+
+#include <iostream>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+/*******************************************************************************
+ *  Benchmark Class
+ ******************************************************************************/
+
+class SExpressionBenchmark : public ::testing::Test {
+protected:
+  static QByteArray createLargeBoard(int netSegments) noexcept {
+    QByteArray board = "(librepcb_board " +
+                       Uuid::createRandom().toStr().toUtf8() +
+                       "\n (name \"Large Board\")\n";
+    for (int i = 0; i < netSegments; ++i) {
+      QByteArray n = QByteArray::number(i);
+      board += " (netsegment " + Uuid::createRandom().toStr().toUtf8() +
+               " (net " + Uuid::createRandom().toStr().toUtf8() + ")\n";
+      board += "  (via " + Uuid::createRandom().toStr().toUtf8() +
+               " (from top_cu) (to bot_cu) (position " + n +
+               ".0 2.54) (size 0.7) (drill 0.3) (shape round))\n";
+      for (int k = 0; k < 2; ++k) {
+        board += "  (netpoint " + Uuid::createRandom().toStr().toUtf8() +
+                 " (layer top_cu) (position " + n + ".5 " +
+                 QByteArray::number(k) + ".27))\n";
+      }
+      board += "  (netline " + Uuid::createRandom().toStr().toUtf8() +
+               " (layer top_cu) (width 0.25)\n"
+               "   (from (netpoint a)) (to (netpoint b))\n"
+               "  )\n"
+               " )\n";
+    }
+    return board + ")\n";
+  }
+};
+
+/*******************************************************************************
+ *  Benchmark Methods
+ ******************************************************************************/
+
+/**
+ * Measures the parser throughput on a large synthetic board.
+ *
+ * @note The comparison with the previously used sexpresso based parser is
+ *       not possible anymore since sexpresso was removed.
+ */
+TEST_F(SExpressionBenchmark, testParse) {
+  QByteArray content = createLargeBoard(50000);
+
+  QElapsedTimer timer;
+  timer.start();
+  SExpression root = SExpression::parse(content, FilePath());
+  qint64      ms   = qMax(timer.elapsed(), qint64(1));
+  EXPECT_EQ(50001, root.getChildren().count());
+
+  std::cout << content.size() / 1000000 << " MB: " << ms << " ms ("
+            << (content.size() / 1000 / ms) << " MB/s)" << std::endl;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace benchmarks
+}  // namespace librepcb
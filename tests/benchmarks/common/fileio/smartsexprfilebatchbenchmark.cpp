@@ -0,0 +1,133 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/fileio/sexpression.h>
+#include <librepcb/common/fileio/smartsexprfile.h>
+#include <librepcb/common/fileio/smartsexprfilebatch.h>
+
+#include <QtCore>
+
+#include <iostream>
+#include <memory>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+/*******************************************************************************
+ *  Benchmark Class
+ ******************************************************************************/
+
+class SmartSExprFileBatchBenchmark : public ::testing::Test {
+protected:
+  FilePath mTempDir;
+
+  SmartSExprFileBatchBenchmark() {
+    mTempDir = FilePath::getRandomTempPath();
+    FileUtils::makePath(mTempDir);
+  }
+
+  virtual ~SmartSExprFileBatchBenchmark() {
+    QDir(mTempDir.toStr()).removeRecursively();
+  }
+
+  std::vector<std::unique_ptr<SmartSExprFile>> createFiles(int count) {
+    std::vector<std::unique_ptr<SmartSExprFile>> files;
+    for (int i = 0; i < count; ++i) {
+      FilePath fp = mTempDir.getPathTo(QString("file%1.lp").arg(i));
+      files.emplace_back(SmartSExprFile::create(fp));
+    }
+    return files;
+  }
+
+  static SExpression createDocument(int index, int items) {
+    SExpression root = SExpression::createList("document");
+    root.appendChild(SExpression::createToken(QString::number(index)), false);
+    for (int i = 0; i < items; ++i) {
+      SExpression& item = root.appendList("item", true);
+      item.appendChild(SExpression::createToken(QString::number(i)), false);
+      item.appendChild("name", QString("Item \"%1\"").arg(i), false);
+      SExpression& pos = item.appendList("position", false);
+      pos.appendChild(SExpression::createToken("1.27"), false);
+      pos.appendChild(SExpression::createToken("-2.54"), false);
+    }
+    return root;
+  }
+
+  static qint64 saveBatch(
+      const std::vector<std::unique_ptr<SmartSExprFile>>& files,
+      const QVector<SExpression>&                         documents) {
+    QElapsedTimer timer;
+    timer.start();
+    SmartSExprFileBatch batch;
+    for (int i = 0; i < documents.count(); ++i) {
+      batch.add(*files[i], documents.at(i));
+    }
+    QStringList errors;
+    EXPECT_TRUE(batch.save(true, errors));
+    return timer.elapsed();
+  }
+};
+
+/*******************************************************************************
+ *  Benchmark Methods
+ ******************************************************************************/
+
+/**
+ * Compares saving documents one after another with saving them as a batch,
+ * similar to a project with 30 schematics and 4 boards. In addition, the time
+ * to save the same (unchanged) documents again is measured.
+ */
+TEST_F(SmartSExprFileBatchBenchmark, testSave) {
+  QVector<SExpression> documents;
+  for (int i = 0; i < 34; ++i) {
+    documents.append(createDocument(i, (i < 30) ? 5000 : 50000));
+  }
+
+  auto          files = createFiles(documents.count());
+  QElapsedTimer timer;
+  timer.start();
+  for (int i = 0; i < documents.count(); ++i) {
+    files[i]->save(documents.at(i), true);
+  }
+  qint64 serialMs = timer.elapsed();
+
+  files = createFiles(documents.count());  // force writing all files again
+  qint64 batchMs     = saveBatch(files, documents);
+  qint64 unchangedMs = saveBatch(files, documents);
+
+  std::cout << documents.count() << " documents: serial " << serialMs
+            << " ms, batch " << batchMs << " ms, unchanged " << unchangedMs
+            << " ms" << std::endl;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace benchmarks
+}  // namespace librepcb
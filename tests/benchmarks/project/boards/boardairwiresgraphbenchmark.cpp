@@ -0,0 +1,111 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/project/boards/boardairwiresgraph.h>
+
+#include <QtCore>
+
+#include <iostream>
+#include <random>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace benchmarks {
+
+/*******************************************************************************
+ *  Benchmark Class
+ ******************************************************************************/
+
+class BoardAirWiresGraphBenchmark : public ::testing::Test {
+protected:
+  static const void* key(int i) noexcept {
+    return reinterpret_cast<const void*>(static_cast<quintptr>(i + 1));
+  }
+
+  static BoardAirWiresGraph::Snapshot createRandomSnapshot(
+      int anchors, int connections, std::mt19937& rng) noexcept {
+    std::uniform_int_distribution<LengthBase_t> coord(0, 100000000);
+    std::uniform_int_distribution<int>          index(0, anchors - 1);
+    BoardAirWiresGraph::Snapshot                snapshot;
+    for (int i = 0; i < anchors; ++i) {
+      snapshot.anchors.append({key(i), Point(coord(rng), coord(rng))});
+    }
+    for (int i = 0; i < connections; ++i) {
+      snapshot.connections.append(qMakePair(index(rng), index(rng)));
+    }
+    return snapshot;
+  }
+
+  static void moveRandomAnchors(BoardAirWiresGraph::Snapshot& snapshot,
+                                int count, std::mt19937& rng) noexcept {
+    std::uniform_int_distribution<LengthBase_t> offset(-1000000, 1000000);
+    std::uniform_int_distribution<int> index(0, snapshot.anchors.count() - 1);
+    for (int i = 0; i < count; ++i) {
+      snapshot.anchors[index(rng)].position += Point(offset(rng), offset(rng));
+    }
+  }
+};
+
+/*******************************************************************************
+ *  Benchmark Methods
+ ******************************************************************************/
+
+/**
+ * Compares a full rebuild with incremental updates on large synthetic nets.
+ */
+TEST_F(BoardAirWiresGraphBenchmark, testIncrementalUpdate) {
+  foreach (int count, QVector<int>({10000, 20000, 50000, 100000})) {
+    std::mt19937                 rng(count);
+    BoardAirWiresGraph::Snapshot snapshot =
+        createRandomSnapshot(count, count / 2, rng);
+    BoardAirWiresGraph graph;
+
+    QElapsedTimer timer;
+    timer.start();
+    graph.update(snapshot);
+    qint64 fullMs = timer.elapsed();
+
+    timer.restart();
+    for (int i = 0; i < 10; ++i) {
+      moveRandomAnchors(snapshot, 1, rng);
+      graph.update(snapshot);
+    }
+    qint64 incrementalMs = timer.elapsed() / 10;
+
+    std::cout << count << " anchors: full rebuild " << fullMs
+              << " ms, incremental update " << incrementalMs << " ms"
+              << std::endl;
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace benchmarks
+}  // namespace project
+}  // namespace librepcb
@@ -0,0 +1,171 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/cam/gerbergenerator.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardcamsnapshot.h>
+#include <librepcb/project/boards/boardgerberexport.h>
+#include <librepcb/project/boards/boardlayerstack.h>
+#include <librepcb/project/boards/items/bi_netline.h>
+#include <librepcb/project/boards/items/bi_netpoint.h>
+#include <librepcb/project/boards/items/bi_netsegment.h>
+#include <librepcb/project/boards/items/bi_via.h>
+#include <librepcb/project/circuit/circuit.h>
+#include <librepcb/project/circuit/netclass.h>
+#include <librepcb/project/circuit/netsignal.h>
+#include <librepcb/project/project.h>
+
+#include <QtCore>
+
+#include <iostream>
+#include <random>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace benchmarks {
+
+/*******************************************************************************
+ *  Benchmark Class
+ ******************************************************************************/
+
+class BoardCamSnapshotBenchmark : public ::testing::Test {
+protected:
+  FilePath                mProjectDir;
+  QScopedPointer<Project> mProject;
+  Board*                  mBoard;
+  BI_NetSegment*          mNetSegment;
+
+  BoardCamSnapshotBenchmark() {
+    mProjectDir = FilePath::getRandomTempPath();
+    mProject.reset(Project::create(mProjectDir.getPathTo("project.lpp")));
+    mBoard = mProject->createBoard(ElementName("board"));
+    mProject->addBoard(*mBoard);
+    mBoard->getLayerStack().setInnerLayerCount(6);
+    Circuit&   circuit = mProject->getCircuit();
+    NetSignal* signal  = new NetSignal(
+        circuit, *circuit.getNetClasses().first(), CircuitIdentifier("GND"),
+        false);
+    circuit.addNetSignal(*signal);
+    mNetSegment = new BI_NetSegment(*mBoard, *signal);
+    mBoard->addNetSegment(*mNetSegment);
+  }
+
+  virtual ~BoardCamSnapshotBenchmark() {
+    mProject.reset();
+    QDir(mProjectDir.toStr()).removeRecursively();
+  }
+
+  void addTraces(const QVector<QPair<Point, Point>>& traces,
+                 const QString&                      layerName) {
+    GraphicsLayer* layer = mBoard->getLayerStack().getLayer(layerName);
+    ASSERT_TRUE(layer);
+    QList<BI_NetPoint*> netpoints;
+    QList<BI_NetLine*>  netlines;
+    foreach (const auto& trace, traces) {
+      BI_NetPoint* start = new BI_NetPoint(*mNetSegment, trace.first);
+      BI_NetPoint* end   = new BI_NetPoint(*mNetSegment, trace.second);
+      netpoints << start << end;
+      netlines << new BI_NetLine(*mNetSegment, *start, *end, *layer,
+                                 PositiveLength(200000));
+    }
+    mNetSegment->addElements({}, netpoints, netlines);
+  }
+
+  void addVia(const Point& pos) {
+    BI_Via* via = new BI_Via(*mNetSegment, pos, BI_Via::Shape::Round,
+                             PositiveLength(800000), PositiveLength(300000));
+    mNetSegment->addElements({via}, {}, {});
+  }
+
+  QStringList getCopperLayerNames() const noexcept {
+    QStringList names = {GraphicsLayer::sTopCopper};
+    for (int i = 1; i <= mBoard->getLayerStack().getInnerLayerCount(); ++i) {
+      names.append(GraphicsLayer::getInnerLayerName(i));
+    }
+    names.append(GraphicsLayer::sBotCopper);
+    return names;
+  }
+};
+
+/*******************************************************************************
+ *  Benchmark Methods
+ ******************************************************************************/
+
+/**
+ * Measures the time to draw each layer of a board with 20k traces.
+ */
+TEST_F(BoardCamSnapshotBenchmark, testDrawLayers) {
+  std::mt19937                                rng(20000);
+  std::uniform_int_distribution<LengthBase_t> coord(0, 200000000);
+  QStringList copperLayers = getCopperLayerNames();
+  for (int i = 0; i < copperLayers.count(); ++i) {
+    QVector<QPair<Point, Point>> traces;
+    for (int k = i; k < 20000; k += copperLayers.count()) {
+      traces.append(qMakePair(Point(coord(rng), coord(rng)),
+                              Point(coord(rng), coord(rng))));
+    }
+    addTraces(traces, copperLayers.at(i));
+  }
+  for (int i = 0; i < 2000; ++i) {
+    addVia(Point(coord(rng), coord(rng)));
+  }
+
+  QStringList layers = copperLayers;
+  layers << GraphicsLayer::sBoardOutlines << GraphicsLayer::sTopStopMask
+         << GraphicsLayer::sBotStopMask;
+  QElapsedTimer timer;
+  timer.start();
+  BoardCamSnapshot snapshot(*mBoard, layers);
+  std::cout << "snapshot: " << timer.elapsed() << " ms" << std::endl;
+
+  foreach (const QString& layerName, layers) {
+    timer.restart();
+    GerberGenerator gen("test", Uuid::createRandom(), "1");
+    snapshot.drawLayer(gen, layerName);
+    gen.saveToFile(mProjectDir.getPathTo(layerName % ".gbr"));
+    std::cout << qPrintable(layerName) << ": "
+              << snapshot.getPrimitiveCount(layerName) << " primitives, "
+              << timer.elapsed() << " ms" << std::endl;
+  }
+
+  BoardGerberExport grbExport(*mBoard);
+  timer.restart();
+  grbExport.exportAllLayers();
+  std::cout << "serial export: " << timer.elapsed() << " ms" << std::endl;
+  timer.restart();
+  grbExport.exportAllLayersConcurrently();
+  std::cout << "concurrent export: " << timer.elapsed() << " ms" << std::endl;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace benchmarks
+}  // namespace project
+}  // namespace librepcb
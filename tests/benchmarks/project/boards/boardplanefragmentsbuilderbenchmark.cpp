@@ -0,0 +1,121 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/project/boards/boardplanefragmentsbuilder.h>
+
+#include <QtCore>
+
+#include <iostream>
+#include <random>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace benchmarks {
+
+/*******************************************************************************
+ *  Benchmark Class
+ ******************************************************************************/
+
+class BoardPlaneFragmentsBuilderBenchmark : public ::testing::Test {
+protected:
+  static const NetSignal* net(int i) noexcept {
+    return reinterpret_cast<const NetSignal*>(static_cast<quintptr>(i + 1));
+  }
+
+  static BoardPlaneFragmentsBuilder::Snapshot createFourLayerSnapshot(
+      int vias) {
+    PositiveLength size(200000000);
+    QStringList    layers;
+    layers << GraphicsLayer::sTopCopper << GraphicsLayer::getInnerLayerName(1)
+           << GraphicsLayer::getInnerLayerName(2) << GraphicsLayer::sBotCopper;
+    BoardPlaneFragmentsBuilder::Snapshot snapshot;
+    for (int i = 0; i < layers.count(); ++i) {
+      snapshot.planes.push_back(BoardPlaneFragmentsBuilder::Snapshot::Plane{
+          Uuid::createRandom(), net(i % 2), layers.at(i),
+          Path::centeredRect(size, size), UnsignedLength(200000),
+          UnsignedLength(300000), false, BI_Plane::ConnectStyle::Solid,
+          QVector<Path>()});
+    }
+    snapshot.boardOutlines.append(Path::centeredRect(size, size));
+    std::mt19937                       rng(vias);
+    std::uniform_int_distribution<int> coord(-95000, 95000);  // [um]
+    std::uniform_int_distribution<int> netIndex(0, 20);
+    for (int i = 0; i < vias; ++i) {
+      const NetSignal* netsignal = net(netIndex(rng));
+      Point pos(Length(coord(rng) * 1000), Length(coord(rng) * 1000));
+      snapshot.vias.push_back(BoardPlaneFragmentsBuilder::Snapshot::Via{
+          netsignal, pos, BI_Via::Shape::Round, PositiveLength(600000)});
+      if (i % 2) {  // add a short trace on top or bottom to every second via
+        snapshot.netLines.push_back(
+            BoardPlaneFragmentsBuilder::Snapshot::NetLine{
+                netsignal, layers.at((i % 4 == 1) ? 0 : 3), pos,
+                pos + Point(2000000, 1000000), PositiveLength(250000)});
+      }
+    }
+    return snapshot;
+  }
+};
+
+/*******************************************************************************
+ *  Benchmark Methods
+ ******************************************************************************/
+
+/**
+ * Measures the speedup of tiled builds on a 4-layer board with thousands of
+ * vias.
+ */
+TEST_F(BoardPlaneFragmentsBuilderBenchmark, testTiledBuild) {
+  foreach (int vias, QVector<int>({1000, 5000, 10000})) {
+    BoardPlaneFragmentsBuilder::Snapshot snapshot =
+        createFourLayerSnapshot(vias);
+
+    QElapsedTimer timer;
+    timer.start();
+    BoardPlaneFragmentsBuilder::Snapshot full = snapshot;
+    BoardPlaneFragmentsBuilder::buildAllFragments(full);
+    qint64 fullMs = timer.elapsed();
+
+    timer.restart();
+    BoardPlaneFragmentsBuilder::Snapshot tiled = snapshot;
+    BoardPlaneFragmentsBuilder::buildAllFragments(tiled, nullptr, nullptr,
+                                                  true);
+    qint64 tiledMs = timer.elapsed();
+
+    std::cout << vias << " vias: " << fullMs << " ms, tiled " << tiledMs
+              << " ms (" << QThread::idealThreadCount() << " threads)"
+              << std::endl;
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace benchmarks
+}  // namespace project
+}  // namespace librepcb
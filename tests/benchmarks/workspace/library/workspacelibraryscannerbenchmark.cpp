@@ -0,0 +1,125 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/application.h>
+#include <librepcb/library/library.h>
+#include <librepcb/library/sym/symbol.h>
+#include <librepcb/workspace/library/workspacelibrarydb.h>
+#include <librepcb/workspace/workspace.h>
+
+#include <QtCore>
+
+#include <iostream>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace workspace {
+namespace benchmarks {
+
+using namespace library;
+
+/*******************************************************************************
+ *  Benchmark Class
+ ******************************************************************************/
+
+class WorkspaceLibraryScannerBenchmark : public ::testing::Test {
+protected:
+  FilePath mWsDir;
+  FilePath mLibDir;
+
+  WorkspaceLibraryScannerBenchmark() {
+    mWsDir = FilePath::getRandomTempPath().getPathTo("test workspace dir");
+    mLibDir =
+        mWsDir.getPathTo("v" % qApp->getFileFormatVersion().toStr())
+            .getPathTo("libraries/local/Test.lplib");
+    Workspace::createNewWorkspace(mWsDir);
+    Library lib(Uuid::createRandom(), Version::fromString("0.1"), "test",
+                ElementName("Test"), "", "");
+    lib.saveTo(mLibDir);
+  }
+
+  virtual ~WorkspaceLibraryScannerBenchmark() {
+    QDir(mWsDir.getParentDir().toStr()).removeRecursively();
+  }
+
+  void createSymbols(int count) {
+    for (int i = 0; i < count; ++i) {
+      Symbol symbol(Uuid::createRandom(), Version::fromString("0.1"), "test",
+                    ElementName(QString("Symbol %1").arg(i)), "", "");
+      symbol.saveIntoParentDirectory(mLibDir.getPathTo("sym"));
+    }
+  }
+
+  static int scan(Workspace& ws) {
+    WorkspaceLibraryDb& db    = ws.getLibraryDb();
+    int                 count = -1;
+    QEventLoop          loop;
+    QObject::connect(&db, &WorkspaceLibraryDb::scanSucceeded, &loop,
+                     [&](int elementCount) {
+                       count = elementCount;
+                       loop.quit();
+                     });
+    QObject::connect(&db, &WorkspaceLibraryDb::scanFailed, &loop,
+                     &QEventLoop::quit);
+    db.startLibraryRescan();
+    loop.exec();
+    return count;
+  }
+};
+
+/*******************************************************************************
+ *  Benchmark Methods
+ ******************************************************************************/
+
+/**
+ * Measures the scan throughput with a generated library of 50k symbols.
+ */
+TEST_F(WorkspaceLibraryScannerBenchmark, testScan) {
+  createSymbols(50000);
+  Workspace ws(mWsDir);
+
+  QElapsedTimer timer;
+  timer.start();
+  int    count  = scan(ws);
+  qint64 fullMs = qMax(timer.elapsed(), qint64(1));
+
+  timer.restart();
+  scan(ws);
+  qint64 rescanMs = qMax(timer.elapsed(), qint64(1));
+
+  std::cout << count << " elements: full scan " << fullMs << " ms ("
+            << (count * 1000 / fullMs) << " elements/s), rescan " << rescanMs
+            << " ms (" << (count * 1000 / rescanMs) << " elements/s)"
+            << std::endl;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace benchmarks
+}  // namespace workspace
+}  // namespace librepcb
@@ -0,0 +1,90 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import os
+import json
+
+"""
+Test command "batch"
+"""
+
+PROJECT_DIR = 'data/Empty Project/'
+PROJECT_PATH = PROJECT_DIR + 'Empty Project.lpp'
+OUTPUT_DIR = PROJECT_DIR + 'output/v1/gerber'
+
+PROJECT_2_DIR = 'data/Project With Two Boards/'
+PROJECT_2_PATH = PROJECT_2_DIR + 'Project With Two Boards.lpp'
+OUTPUT_2_DIR = PROJECT_2_DIR + 'output/v1/gerber'
+
+
+def test_no_projects(cli):
+    code, stdout, stderr = cli.run('batch', '--export-pcb-fabrication-data')
+    assert code == 1
+    assert len(stderr) > 0
+    assert stdout[-1] == 'Finished with errors!'
+
+
+def test_invalid_job_count(cli):
+    code, stdout, stderr = cli.run('batch', '--jobs=0', PROJECT_PATH)
+    assert code == 1
+    assert stderr[0] == "Invalid job count '0'."
+
+
+def test_export_projects_with_summary(cli):
+    assert not os.path.exists(cli.abspath(OUTPUT_DIR))
+    assert not os.path.exists(cli.abspath(OUTPUT_2_DIR))
+    code, stdout, stderr = cli.run('batch',
+                                   '--export-pcb-fabrication-data',
+                                   '--board=default',
+                                   '--jobs=2',
+                                   '--summary=summary.json',
+                                   PROJECT_PATH,
+                                   PROJECT_2_PATH)
+    assert code == 0
+    assert len(stderr) == 0
+    assert stdout[-1] == 'SUCCESS'
+    assert len(os.listdir(cli.abspath(OUTPUT_DIR))) == 8
+    assert len(os.listdir(cli.abspath(OUTPUT_2_DIR))) == 8
+    with open(cli.abspath('summary.json')) as f:
+        summary = json.load(f)
+    assert summary['jobs'] == 2
+    assert summary['succeeded'] == 2
+    assert summary['failed'] == 0
+    assert [p['project'] for p in summary['projects']] == \
+        [PROJECT_PATH, PROJECT_2_PATH]
+    for project in summary['projects']:
+        assert project['success'] is True
+        assert len(project['files']) == 8
+        assert project['time_ms']['total'] >= project['time_ms']['export']
+
+
+def test_manifest_and_wildcard(cli):
+    with open(cli.abspath('data/projects.txt'), 'w') as f:
+        f.write('# comment\n\nEmpty Project/Empty Project.lpp\n')
+    code, stdout, stderr = cli.run('batch',
+                                   '--manifest=data/projects.txt',
+                                   '--export-pcb-fabrication-data',
+                                   '--board=default',
+                                   PROJECT_2_DIR + '*.lpp')
+    assert code == 0
+    assert len(stderr) == 0
+    assert stdout[-1] == 'SUCCESS'
+    assert os.path.exists(cli.abspath(OUTPUT_DIR))
+    assert os.path.exists(cli.abspath(OUTPUT_2_DIR))
+
+
+def test_failed_project_is_reported(cli):
+    code, stdout, stderr = cli.run('batch',
+                                   '--export-pcb-fabrication-data',
+                                   '--summary=summary.json',
+                                   PROJECT_PATH,
+                                   'nonexistent.lpp')
+    assert code == 1
+    assert len(stderr) > 0
+    assert stdout[-1] == 'Finished with errors!'
+    assert os.path.exists(cli.abspath(OUTPUT_DIR))
+    with open(cli.abspath('summary.json')) as f:
+        summary = json.load(f)
+    assert summary['succeeded'] == 1
+    assert summary['failed'] == 1
+    assert summary['projects'][1]['success'] is False
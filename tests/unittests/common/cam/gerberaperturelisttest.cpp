@@ -0,0 +1,102 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/cam/gerberaperturelist.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class GerberApertureListTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(GerberApertureListTest, testEmpty) {
+  GerberApertureList list;
+  EXPECT_EQ(
+      "G04 --- APERTURE LIST BEGIN --- *\n"
+      "G04 --- APERTURE LIST END --- *\n",
+      list.generateString().toStdString());
+}
+
+TEST_F(GerberApertureListTest, testIdenticalAperturesAreReused) {
+  GerberApertureList list;
+  UnsignedLength     w(1000000);
+  UnsignedLength     h(2000000);
+  UnsignedLength     noHole(0);
+  EXPECT_EQ(10, list.setCircle(UnsignedLength(100000), noHole));
+  EXPECT_EQ(11, list.setRect(w, h, Angle::deg0(), noHole));
+  EXPECT_EQ(12, list.setRect(w, h, Angle::deg90(), noHole));
+  EXPECT_EQ(10, list.setCircle(UnsignedLength(100000), noHole));
+  EXPECT_EQ(11, list.setRect(w, h, Angle::deg180(), noHole));
+  EXPECT_EQ(12, list.setRect(h, w, Angle::deg0(), noHole));
+  EXPECT_EQ(13, list.setRect(w, h, Angle::deg45(), noHole));
+  EXPECT_EQ(13, list.setRect(w, h, Angle::deg45(), noHole));
+  EXPECT_EQ(14, list.setRect(w, h, Angle::deg45(), UnsignedLength(100000)));
+  EXPECT_EQ(15, list.setCircle(UnsignedLength(100000), UnsignedLength(50000)));
+  EXPECT_EQ(
+      "G04 --- APERTURE LIST BEGIN --- *\n"
+      "%AMROTATEDRECT*21,1,$1,$2,0,0,$3*%\n"
+      "%AMROTATEDRECTWITHHOLE*21,1,$1,$2,0,0,$3*1,0,$4,0,0,$3*%\n"
+      "%ADD10C,0.1*%\n"
+      "%ADD11R,1.0X2.0*%\n"
+      "%ADD12R,2.0X1.0*%\n"
+      "%ADD13ROTATEDRECT,1.0X2.0X45.0*%\n"
+      "%ADD14ROTATEDRECTWITHHOLE,1.0X2.0X45.0X0.1*%\n"
+      "%ADD15C,0.1X0.05*%\n"
+      "G04 --- APERTURE LIST END --- *\n",
+      list.generateString().toStdString());
+}
+
+TEST_F(GerberApertureListTest, testReset) {
+  GerberApertureList list;
+  UnsignedLength     w(1000000);
+  UnsignedLength     noHole(0);
+  EXPECT_EQ(10, list.setObround(w, w, Angle::deg0(), noHole));
+  EXPECT_EQ(11, list.setRegularPolygon(w, 8, Angle::deg0(), noHole));
+  list.reset();
+  EXPECT_EQ(10, list.setRegularPolygon(w, 8, Angle::deg0(), noHole));
+  EXPECT_EQ(
+      "G04 --- APERTURE LIST BEGIN --- *\n"
+      "%ADD10P,1.0X8X22.5*%\n"
+      "G04 --- APERTURE LIST END --- *\n",
+      list.generateString().toStdString());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -0,0 +1,132 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/cam/gerbergenerator.h>
+#include <librepcb/common/fileio/fileutils.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class GerberGeneratorTest : public ::testing::Test {
+protected:
+  FilePath mOutputDir;
+
+  GerberGeneratorTest() { mOutputDir = FilePath::getRandomTempPath(); }
+
+  virtual ~GerberGeneratorTest() {
+    QDir(mOutputDir.toStr()).removeRecursively();
+  }
+
+  static void drawLines(GerberGenerator& gen, int count) noexcept {
+    for (int i = 0; i < count; ++i) {
+      gen.drawLine(Point(i * 1000, 0), Point(i * 1000, 123456789),
+                   UnsignedLength(100000 + (i % 3) * 1000));
+    }
+  }
+
+  static QByteArray calcMd5(const QList<QByteArray>& lines) noexcept {
+    QCryptographicHash md5(QCryptographicHash::Md5);
+    foreach (const QByteArray& line, lines) { md5.addData(line); }
+    return md5.result().toHex();
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(GerberGeneratorTest, testFileStructureAndChecksum) {
+  GerberGenerator gen("project", Uuid::createRandom(), "v1");
+  drawLines(gen, 10);
+  gen.flashCircle(Point(1000, 2000), UnsignedLength(500000), UnsignedLength(0));
+  FilePath fp = mOutputDir.getPathTo("test.gbr");
+  gen.saveToFile(fp);
+
+  QList<QByteArray> lines = FileUtils::readFile(fp).split('\n');
+  ASSERT_GE(lines.count(), 4);
+  EXPECT_EQ("", lines.takeLast());  // file ends with a linebreak
+  EXPECT_EQ("M02*", lines.takeLast());
+  QByteArray md5Line = lines.takeLast();
+  EXPECT_EQ("%TF.MD5," + calcMd5(lines) + "*%", md5Line);
+  EXPECT_EQ("G04 --- HEADER BEGIN --- *", lines.first());
+  EXPECT_LT(lines.indexOf("G04 --- APERTURE LIST END --- *"),
+            lines.indexOf("G04 --- BOARD BEGIN --- *"));
+  EXPECT_EQ("X1000Y2000D03*", lines.at(lines.count() - 2));
+  EXPECT_EQ("G04 --- BOARD END --- *", lines.last());
+}
+
+TEST_F(GerberGeneratorTest, testLargeContentIsSpilledToTemporaryFile) {
+  GerberGenerator gen("project", Uuid::createRandom(), "v1");
+  drawLines(gen, 200000);  // several MB of content
+  FilePath fp = mOutputDir.getPathTo("large.gbr");
+  gen.saveToFile(fp);
+
+  QList<QByteArray> lines = FileUtils::readFile(fp).split('\n');
+  lines.removeLast();  // empty line after last linebreak
+  lines.removeLast();  // "M02*"
+  QByteArray md5Line = lines.takeLast();
+  EXPECT_EQ("%TF.MD5," + calcMd5(lines) + "*%", md5Line);
+  int lineCount = 0;
+  foreach (const QByteArray& line, lines) {
+    if (line.endsWith("D01*")) ++lineCount;
+  }
+  EXPECT_EQ(200000, lineCount);
+  EXPECT_EQ("X199999000Y123456789D01*", lines.at(lines.count() - 2));
+}
+
+TEST_F(GerberGeneratorTest, testSaveTwiceWritesSameContent) {
+  GerberGenerator gen("project", Uuid::createRandom(), "v1");
+  drawLines(gen, 100000);
+  FilePath fp1 = mOutputDir.getPathTo("1.gbr");
+  FilePath fp2 = mOutputDir.getPathTo("2.gbr");
+  gen.saveToFile(fp1);
+  gen.saveToFile(fp2);
+
+  // skip the creation date (and thus the checksum) since they may differ
+  QList<QByteArray> lines1 = FileUtils::readFile(fp1).split('\n');
+  QList<QByteArray> lines2 = FileUtils::readFile(fp2).split('\n');
+  ASSERT_EQ(lines1.count(), lines2.count());
+  for (int i = 0; i < lines1.count(); ++i) {
+    if (!lines1.at(i).startsWith("%TF.CreationDate") &&
+        !lines1.at(i).startsWith("%TF.MD5")) {
+      EXPECT_EQ(lines1.at(i), lines2.at(i));
+    }
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
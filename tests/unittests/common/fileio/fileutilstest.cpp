@@ -0,0 +1,104 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/fileutils.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Data Type
+ ******************************************************************************/
+
+typedef FileUtils::CopyStrategy FileUtilsCopyTestData;
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class FileUtilsCopyTest
+  : public ::testing::TestWithParam<FileUtilsCopyTestData> {
+protected:
+  FilePath mTempDir;
+  FilePath mSrcDir;
+  FilePath mDstDir;
+
+  FileUtilsCopyTest() {
+    mTempDir = FilePath::getRandomTempPath();
+    mSrcDir  = mTempDir.getPathTo("src");
+    mDstDir  = mTempDir.getPathTo("dst");
+    FileUtils::writeFile(mSrcDir.getPathTo("a.lp"), "foo");
+    FileUtils::writeFile(mSrcDir.getPathTo("sub/b.lp"), "bar");
+  }
+
+  virtual ~FileUtilsCopyTest() { QDir(mTempDir.toStr()).removeRecursively(); }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_P(FileUtilsCopyTest, testCopyDirRecursively) {
+  FileUtils::copyDirRecursively(mSrcDir, mDstDir, GetParam());
+  EXPECT_EQ("foo", FileUtils::readFile(mDstDir.getPathTo("a.lp")));
+  EXPECT_EQ("bar", FileUtils::readFile(mDstDir.getPathTo("sub/b.lp")));
+}
+
+TEST_P(FileUtilsCopyTest, testCopyFileToExistingFileThrows) {
+  FileUtils::writeFile(mDstDir.getPathTo("a.lp"), "existing");
+  EXPECT_THROW(FileUtils::copyFile(mSrcDir.getPathTo("a.lp"),
+                                   mDstDir.getPathTo("a.lp"), GetParam()),
+               Exception);
+  EXPECT_EQ("existing", FileUtils::readFile(mDstDir.getPathTo("a.lp")));
+}
+
+TEST_P(FileUtilsCopyTest, testWriteFileDoesNotModifySource) {
+  FileUtils::copyDirRecursively(mSrcDir, mDstDir, GetParam());
+  FileUtils::writeFile(mDstDir.getPathTo("a.lp"), "modified");
+  EXPECT_EQ("modified", FileUtils::readFile(mDstDir.getPathTo("a.lp")));
+  EXPECT_EQ("foo", FileUtils::readFile(mSrcDir.getPathTo("a.lp")));
+}
+
+/*******************************************************************************
+ *  Test Data
+ ******************************************************************************/
+
+// clang-format off
+INSTANTIATE_TEST_CASE_P(FileUtilsCopyTest, FileUtilsCopyTest, ::testing::Values(
+    FileUtils::CopyStrategy::Copy,
+    FileUtils::CopyStrategy::Clone,
+    FileUtils::CopyStrategy::Link
+));
+// clang-format on
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -0,0 +1,250 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/sexpression.h>
+#include <librepcb/common/uuid.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class SExpressionTest : public ::testing::Test {
+protected:
+  static QByteArray createLargeBoard(int netSegments) noexcept {
+    QByteArray board = "(librepcb_board " +
+                       Uuid::createRandom().toStr().toUtf8() +
+                       "\n (name \"Large Board\")\n";
+    for (int i = 0; i < netSegments; ++i) {
+      QByteArray n = QByteArray::number(i);
+      board += " (netsegment " + Uuid::createRandom().toStr().toUtf8() +
+               " (net " + Uuid::createRandom().toStr().toUtf8() + ")\n";
+      board += "  (via " + Uuid::createRandom().toStr().toUtf8() +
+               " (from top_cu) (to bot_cu) (position " + n +
+               ".0 2.54) (size 0.7) (drill 0.3) (shape round))\n";
+      for (int k = 0; k < 2; ++k) {
+        board += "  (netpoint " + Uuid::createRandom().toStr().toUtf8() +
+                 " (layer top_cu) (position " + n + ".5 " +
+                 QByteArray::number(k) + ".27))\n";
+      }
+      board += "  (netline " + Uuid::createRandom().toStr().toUtf8() +
+               " (layer top_cu) (width 0.25)\n"
+               "   (from (netpoint a)) (to (netpoint b))\n"
+               "  )\n"
+               " )\n";
+    }
+    return board + ")\n";
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(SExpressionTest, testParse) {
+  SExpression root = SExpression::parse(
+      "(root \"uuid\"\n (name \"foo (bar)\")\n (list (value 42))\n)",
+      FilePath());
+  EXPECT_EQ("root", root.getName().toStdString());
+  EXPECT_EQ("uuid", root.getChildByIndex(0).getStringOrToken().toStdString());
+  EXPECT_EQ("foo (bar)", root.getValueByPath<QString>("name").toStdString());
+  EXPECT_EQ(42, root.getValueByPath<int>("list/value"));
+}
+
+TEST_F(SExpressionTest, testParseWithSkippedLists) {
+  QByteArray str =
+      "(root \"uuid\"\n"
+      " (name \"(pin \\\"escaped\\\")\")\n"
+      " (pin (name \"pin)\") (nested (pin 1)))\n"
+      " (polygon (vertex (position 0 0)))\n"
+      " (pins 2)\n"
+      ")";
+  SExpression root =
+      SExpression::parse(str, FilePath(), QSet<QString>{"pin", "polygon"});
+  EXPECT_EQ(3, root.getChildren().count());
+  EXPECT_EQ("(pin \"escaped\")",
+            root.getValueByPath<QString>("name").toStdString());
+  EXPECT_EQ(2, root.getValueByPath<int>("pins"));
+  EXPECT_EQ(0, root.getChildren("pin").count());
+  EXPECT_EQ(0, root.getChildren("polygon").count());
+}
+
+TEST_F(SExpressionTest, testParseWithSkippedUnterminatedList) {
+  EXPECT_THROW(SExpression::parse("(root (pin (name \"x\")", FilePath(),
+                                  QSet<QString>{"pin"}),
+               FileParseError);
+}
+
+TEST_F(SExpressionTest, testParseEscapesAndComments) {
+  SExpression root = SExpression::parse(
+      "; comment (not a list)\n"
+      "(root \"\\\"quoted\\\"\\n\\\\\" ; comment\n"
+      " (name \"\xc3\xa4\xc3\xb6\xc3\xbc\")\n"
+      " token-1.5)",
+      FilePath());
+  ASSERT_EQ(3, root.getChildren().count());
+  EXPECT_EQ("\"quoted\"\n\\",
+            root.getChildByIndex(0).getStringOrToken().toStdString());
+  EXPECT_EQ(QString::fromUtf8("\xc3\xa4\xc3\xb6\xc3\xbc"),
+            root.getValueByPath<QString>("name"));
+  EXPECT_EQ("token-1.5",
+            root.getChildByIndex(2).getStringOrToken().toStdString());
+}
+
+TEST_F(SExpressionTest, testParseInternsListNames) {
+  SExpression root = SExpression::parse(
+      "(root (pin 1) (pin 2) (pad (pin 3)))", FilePath());
+  const QString& name1 = root.getChildByIndex(0).getName();
+  const QString& name2 = root.getChildByIndex(1).getName();
+  const QString& name3 = root.getChildByPath("pad/pin").getName();
+  EXPECT_EQ(name1.constData(), name2.constData());
+  EXPECT_EQ(name1.constData(), name3.constData());
+}
+
+TEST_F(SExpressionTest, testParseInternsShortTokens) {
+  SExpression root = SExpression::parse(
+      "(root (layer top_cu) (layer top_cu) (name \"top_cu\"))", FilePath());
+  const QString& token1 = root.getChildByPath("layer")
+                              .getChildByIndex(0)
+                              .getStringOrToken();
+  const QString& token2 = root.getChildByIndex(0)
+                              .getChildByIndex(0)
+                              .getStringOrToken();
+  const QString& string = root.getChildByPath("name")
+                              .getChildByIndex(0)
+                              .getStringOrToken();
+  EXPECT_EQ(token1.constData(), token2.constData());
+  EXPECT_NE(token1.constData(), string.constData());
+}
+
+TEST_F(SExpressionTest, testGetChildrenByNameReferencesNodes) {
+  SExpression root = SExpression::parse("(root (pin 1) (pad 2) (pin 3))",
+                                        FilePath());
+  QVector<SExpression::Ref> pins = root.getChildren("pin");
+  ASSERT_EQ(2, pins.count());
+  EXPECT_EQ(&root.getChildByIndex(0), pins.at(0).operator->());
+  EXPECT_EQ(&root.getChildByIndex(2), pins.at(1).operator->());
+}
+
+TEST_F(SExpressionTest, testAppendedListStaysValid) {
+  SExpression  root  = SExpression::createList("root");
+  SExpression& first = root.appendList("first", true);
+  for (int i = 0; i < 1000; ++i) {
+    root.appendChild("item", i, true);
+  }
+  first.appendChild("value", QString("foo"), false);
+  EXPECT_EQ(&first, &root.getChildByPath("first"));
+  EXPECT_EQ("foo", root.getValueByPath<QString>("first/value"));
+}
+
+TEST_F(SExpressionTest, testParseInvalidDocuments) {
+  QList<QByteArray> invalid = {
+      "",
+      "(root) (root)",
+      "token",
+      "(root",
+      "(root))",
+      "(root ())",
+      "(root \"unterminated)",
+      "(root \"new\nline\")",
+      "(root \"invalid \\x escape\")",
+  };
+  foreach (const QByteArray& content, invalid) {
+    EXPECT_THROW(SExpression::parse(content, FilePath()), Exception)
+        << content.constData();
+  }
+}
+
+TEST_F(SExpressionTest, testSerialize) {
+  SExpression root = SExpression::createList("root");
+  root.appendChild(SExpression::createToken("1.5"), false);
+  root.appendChild("name", QString::fromUtf8("\"q\"?\n\xc3\xa4\\"), true);
+  root.appendList("empty", true);
+  QByteArray output;
+  root.serialize(output, 0);
+  EXPECT_EQ(
+      "(root 1.5\n"
+      " (name \"\\\"q\\\"\\?\\n\xc3\xa4\\\\\")\n"
+      " (empty)\n"
+      ")",
+      output.toStdString());
+  EXPECT_EQ(QString::fromUtf8(output), root.toString(0));
+}
+
+TEST_F(SExpressionTest, testSerializeRoundTrip) {
+  SExpression root = SExpression::parse(createLargeBoard(10), FilePath());
+  QByteArray  output;
+  root.serialize(output, 0);
+  QByteArray output2;
+  SExpression::parse(output, FilePath()).serialize(output2, 0);
+  EXPECT_EQ(output, output2);
+}
+
+TEST_F(SExpressionTest, testSerializeInvalidNodes) {
+  QByteArray output;
+  EXPECT_THROW(SExpression::createList("Root").serialize(output, 0),
+               LogicError);
+  EXPECT_THROW(SExpression::createToken("a b").serialize(output, 0),
+               LogicError);
+  EXPECT_THROW(SExpression::createToken("").serialize(output, 0), LogicError);
+}
+
+TEST_F(SExpressionTest, testCalculateHash) {
+  QByteArray  content = createLargeBoard(10);
+  SExpression root    = SExpression::parse(content, FilePath());
+  EXPECT_EQ(root.calculateHash(),
+            SExpression::parse(content, FilePath()).calculateHash());
+
+  // everything which affects the serialized output must affect the hash
+  SExpression list   = SExpression::createList("a");
+  SExpression token  = SExpression::createToken("a");
+  SExpression string = SExpression::createString("a");
+  EXPECT_NE(list.calculateHash(), token.calculateHash());
+  EXPECT_NE(token.calculateHash(), string.calculateHash());
+  SExpression modified = root;
+  modified.appendChild(token, false);
+  EXPECT_NE(root.calculateHash(), modified.calculateHash());
+  modified = root;
+  modified.appendLineBreak();
+  EXPECT_NE(root.calculateHash(), modified.calculateHash());
+  SExpression nested1 = SExpression::createList("a");
+  nested1.appendList("b", false).appendChild(token, false);
+  SExpression nested2 = SExpression::createList("a");
+  nested2.appendList("b", false);
+  nested2.appendChild(token, false);
+  EXPECT_NE(nested1.calculateHash(), nested2.calculateHash());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
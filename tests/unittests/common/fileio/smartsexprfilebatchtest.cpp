@@ -0,0 +1,122 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/fileio/sexpression.h>
+#include <librepcb/common/fileio/smartsexprfile.h>
+#include <librepcb/common/fileio/smartsexprfilebatch.h>
+
+#include <QtCore>
+
+#include <memory>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class SmartSExprFileBatchTest : public ::testing::Test {
+protected:
+  FilePath mTempDir;
+
+  SmartSExprFileBatchTest() {
+    mTempDir = FilePath::getRandomTempPath();
+    FileUtils::makePath(mTempDir);
+  }
+
+  virtual ~SmartSExprFileBatchTest() {
+    QDir(mTempDir.toStr()).removeRecursively();
+  }
+
+  std::vector<std::unique_ptr<SmartSExprFile>> createFiles(int count) {
+    std::vector<std::unique_ptr<SmartSExprFile>> files;
+    for (int i = 0; i < count; ++i) {
+      FilePath fp = mTempDir.getPathTo(QString("file%1.lp").arg(i));
+      files.emplace_back(SmartSExprFile::create(fp));
+    }
+    return files;
+  }
+
+  static SExpression createDocument(int index, int items) {
+    SExpression root = SExpression::createList("document");
+    root.appendChild(SExpression::createToken(QString::number(index)), false);
+    for (int i = 0; i < items; ++i) {
+      SExpression& item = root.appendList("item", true);
+      item.appendChild(SExpression::createToken(QString::number(i)), false);
+      item.appendChild("name", QString("Item \"%1\"").arg(i), false);
+      SExpression& pos = item.appendList("position", false);
+      pos.appendChild(SExpression::createToken("1.27"), false);
+      pos.appendChild(SExpression::createToken("-2.54"), false);
+    }
+    return root;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(SmartSExprFileBatchTest, testSave) {
+  auto                files = createFiles(10);
+  SmartSExprFileBatch batch;
+  for (int i = 0; i < 10; ++i) {
+    batch.add(*files[i], createDocument(i, 100));
+  }
+  EXPECT_EQ(10, batch.getCount());
+
+  QStringList errors;
+  EXPECT_TRUE(batch.save(true, errors));
+  EXPECT_TRUE(errors.isEmpty());
+  EXPECT_EQ(0, batch.getCount());
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(files[i]->serialize(createDocument(i, 100)),
+              FileUtils::readFile(files[i]->getFilepath()));
+  }
+}
+
+TEST_F(SmartSExprFileBatchTest, testSaveReportsErrors) {
+  auto                files = createFiles(3);
+  SmartSExprFileBatch batch;
+  batch.add(*files[0], createDocument(0, 10));
+  batch.add(*files[1], SExpression::createList("Invalid Name"));
+  batch.add(*files[2], createDocument(2, 10));
+
+  QStringList errors;
+  EXPECT_FALSE(batch.save(true, errors));
+  EXPECT_EQ(1, errors.count());
+  EXPECT_TRUE(files[0]->getFilepath().isExistingFile());
+  EXPECT_FALSE(files[1]->getFilepath().isExistingFile());
+  EXPECT_TRUE(files[2]->getFilepath().isExistingFile());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -0,0 +1,158 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/fileio/sexpression.h>
+#include <librepcb/common/fileio/smartsexprfile.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class SmartSExprFileTest : public ::testing::Test {
+protected:
+  FilePath mTempDir;
+  FilePath mFilePath;
+  FilePath mTmpFilePath;
+
+  SmartSExprFileTest() {
+    mTempDir     = FilePath::getRandomTempPath();
+    mFilePath    = mTempDir.getPathTo("file.lp");
+    mTmpFilePath = mTempDir.getPathTo("file.lp~");
+    FileUtils::makePath(mTempDir);
+  }
+
+  virtual ~SmartSExprFileTest() {
+    QDir(mTempDir.toStr()).removeRecursively();
+  }
+
+  static SExpression createDocument(const QString& name) {
+    SExpression root = SExpression::createList("test");
+    root.appendChild("name", name, true);
+    return root;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(SmartSExprFileTest, testSaveSkipsUnchangedContent) {
+  QScopedPointer<SmartSExprFile> file(SmartSExprFile::create(mFilePath));
+  EXPECT_TRUE(file->save(createDocument("foo"), true));
+  EXPECT_FALSE(file->save(createDocument("foo"), true));
+
+  // no backup needed as long as the content equals the original file
+  EXPECT_FALSE(file->save(createDocument("foo"), false));
+  EXPECT_FALSE(mTmpFilePath.isExistingFile());
+
+  // modified content must be written
+  EXPECT_TRUE(file->save(createDocument("bar"), false));
+  EXPECT_FALSE(file->save(createDocument("bar"), false));
+  EXPECT_TRUE(file->save(createDocument("bar"), true));
+  EXPECT_EQ(FileUtils::readFile(mFilePath), FileUtils::readFile(mTmpFilePath));
+
+  // an existing backup must be updated even if it equals the original file
+  EXPECT_TRUE(file->save(createDocument("foo"), true));
+  EXPECT_TRUE(file->save(createDocument("foo"), false));
+}
+
+TEST_F(SmartSExprFileTest, testSaveSkipsUnchangedOpenedFile) {
+  QScopedPointer<SmartSExprFile> newFile(SmartSExprFile::create(mFilePath));
+  newFile->save(createDocument("foo"), true);
+
+  SmartSExprFile file(mFilePath, false, false);
+  SExpression    root = file.parseFileAndBuildDomTree();
+  EXPECT_FALSE(file.save(root, true));
+}
+
+TEST_F(SmartSExprFileTest, testSaveRewritesRemovedFile) {
+  QScopedPointer<SmartSExprFile> file(SmartSExprFile::create(mFilePath));
+  EXPECT_TRUE(file->save(createDocument("foo"), true));
+  file->removeFile(true);
+  EXPECT_TRUE(file->save(createDocument("foo"), true));
+  EXPECT_TRUE(mFilePath.isExistingFile());
+}
+
+TEST_F(SmartSExprFileTest, testSaveRewritesExternallyModifiedFile) {
+  QScopedPointer<SmartSExprFile> newFile(SmartSExprFile::create(mFilePath));
+  newFile->save(createDocument("foo"), true);
+  QByteArray content = FileUtils::readFile(mFilePath);
+
+  SmartSExprFile file(mFilePath, false, false);
+  SExpression    root = file.parseFileAndBuildDomTree();
+  FileUtils::writeFile(mFilePath, "modified");
+  EXPECT_TRUE(file.save(root, true));
+  EXPECT_EQ(content, FileUtils::readFile(mFilePath));
+}
+
+TEST_F(SmartSExprFileTest, testIsUpToDate) {
+  SExpression foo = createDocument("foo");
+  SExpression bar = createDocument("bar");
+
+  QScopedPointer<SmartSExprFile> file(SmartSExprFile::create(mFilePath));
+  EXPECT_FALSE(file->isUpToDate(foo.calculateHash(), true));
+  EXPECT_TRUE(file->save(foo, true));
+  EXPECT_TRUE(file->isUpToDate(foo.calculateHash(), true));
+  EXPECT_TRUE(file->isUpToDate(foo.calculateHash(), false));
+  EXPECT_FALSE(file->isUpToDate(bar.calculateHash(), true));
+  EXPECT_FALSE(file->isUpToDate(bar.calculateHash(), false));
+
+  // modifications of the file must be detected without reading it
+  FileUtils::writeFile(mFilePath, "modified");
+  EXPECT_FALSE(file->isUpToDate(foo.calculateHash(), true));
+}
+
+TEST_F(SmartSExprFileTest, testSaveRewritesExternallyModifiedSavedFile) {
+  QScopedPointer<SmartSExprFile> file(SmartSExprFile::create(mFilePath));
+  EXPECT_TRUE(file->save(createDocument("foo"), true));
+  QByteArray content = FileUtils::readFile(mFilePath);
+  FileUtils::writeFile(mFilePath, "modified");
+  EXPECT_TRUE(file->save(createDocument("foo"), true));
+  EXPECT_EQ(content, FileUtils::readFile(mFilePath));
+}
+
+TEST_F(SmartSExprFileTest, testSaveSerializedUpToDateFileModifiedMeanwhile) {
+  SExpression                    foo = createDocument("foo");
+  QScopedPointer<SmartSExprFile> file(SmartSExprFile::create(mFilePath));
+  EXPECT_TRUE(file->save(foo, true));
+  EXPECT_FALSE(file->saveSerialized(QByteArray(), foo.calculateHash(), true));
+  FileUtils::writeFile(mFilePath, "modified");
+  EXPECT_THROW(file->saveSerialized(QByteArray(), foo.calculateHash(), true),
+               Exception);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
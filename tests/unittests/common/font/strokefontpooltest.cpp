@@ -0,0 +1,118 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/application.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/font/strokefontpool.h>
+
+#include <QtConcurrent/QtConcurrent>
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class StrokeFontPoolTest : public ::testing::Test {
+protected:
+  FilePath mFontsDir;
+
+  StrokeFontPoolTest() {
+    mFontsDir = FilePath::getRandomTempPath();
+    FileUtils::makePath(mFontsDir);
+    foreach (const FilePath& fp,
+             FileUtils::getFilesInDirectory(
+                 qApp->getResourcesFilePath("fontobene"), {"*.bene"})) {
+      FileUtils::copyFile(fp, mFontsDir.getPathTo(fp.getFilename()));
+    }
+  }
+
+  virtual ~StrokeFontPoolTest() { QDir(mFontsDir.toStr()).removeRecursively(); }
+
+  static QVector<Path> stroke(const StrokeFont& font,
+                              const QString&    text) noexcept {
+    Point     bottomLeft, topRight;
+    Alignment align(HAlign::center(), VAlign::center());
+    return font.stroke(text, PositiveLength(2500000), Length(250000),
+                       Length(4000000), align, bottomLeft, topRight);
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(StrokeFontPoolTest, testUnknownFontThrows) {
+  StrokeFontPool pool(mFontsDir);
+  EXPECT_THROW(pool.getFont("unknown.bene"), RuntimeError);
+}
+
+TEST_F(StrokeFontPoolTest, testFontsAreSharedByContent) {
+  // the copied fonts must be shared with the application fonts
+  QString        name = qApp->getDefaultStrokeFontName();
+  StrokeFontPool pool1(mFontsDir);
+  StrokeFontPool pool2(mFontsDir);
+  EXPECT_EQ(&qApp->getDefaultStrokeFont(), &pool1.getFont(name));
+  EXPECT_EQ(&pool1.getFont(name), &pool2.getFont(name));
+}
+
+TEST_F(StrokeFontPoolTest, testCachedGlyphsAreIdentical) {
+  // every glyph occurs only once, so a new font converts all of them
+  QString       text = "R1 C2U3\nµΩ~!?";
+  StrokeFont    newFont(mFontsDir.getPathTo(qApp->getDefaultStrokeFontName()));
+  QVector<Path> uncached = stroke(newFont, text);
+  EXPECT_FALSE(uncached.isEmpty());
+
+  const StrokeFont& font = qApp->getDefaultStrokeFont();
+  stroke(font, text);  // make sure all glyphs are cached
+  EXPECT_EQ(uncached, stroke(font, text));
+}
+
+TEST_F(StrokeFontPoolTest, testConcurrentStroke) {
+  StrokeFontPool    pool(mFontsDir);
+  const StrokeFont& font = pool.getFont(qApp->getDefaultStrokeFontName());
+  QStringList       texts;
+  for (int i = 0; i < 200; ++i) {
+    texts.append(QString("R%1 C%2").arg(i).arg(i * 7));
+  }
+  QList<QVector<Path>> concurrent = QtConcurrent::blockingMapped(
+      texts,
+      std::function<QVector<Path>(const QString&)>(
+          [&font](const QString& text) { return stroke(font, text); }));
+  for (int i = 0; i < texts.count(); ++i) {
+    EXPECT_EQ(stroke(font, texts.at(i)), concurrent.at(i));
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
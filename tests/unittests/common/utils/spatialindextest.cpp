@@ -0,0 +1,177 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/utils/spatialindex.h>
+
+#include <QtCore>
+
+#include <random>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class SpatialIndexTest : public ::testing::Test {
+protected:
+  struct Item {
+    QRectF rect;
+
+    QPainterPath getGrabAreaScenePx() const noexcept {
+      // Note: QPainterPath::addRect() ignores null rects, but points must be
+      // represented too.
+      QPainterPath p;
+      p.addPolygon(QPolygonF(rect));
+      return p;
+    }
+  };
+
+  static QRectF randomRect(std::mt19937& rng) noexcept {
+    std::uniform_real_distribution<qreal> pos(-1000, 1000);
+    std::uniform_real_distribution<qreal> size(0, 50);
+    return QRectF(pos(rng), pos(rng), size(rng), size(rng));
+  }
+
+  static bool intersects(const QRectF& a, const QRectF& b) noexcept {
+    return (a.left() <= b.right()) && (b.left() <= a.right()) &&
+           (a.top() <= b.bottom()) && (b.top() <= a.bottom());
+  }
+
+  static QSet<Item*> findBruteForce(std::vector<Item>& items,
+                                    const QSet<Item*>& indexed,
+                                    const QRectF&      rect) noexcept {
+    QSet<Item*> result;
+    for (Item& item : items) {
+      if (indexed.contains(&item) && intersects(item.rect, rect)) {
+        result.insert(&item);
+      }
+    }
+    return result;
+  }
+
+  static QSet<Item*> toSet(const QVector<Item*>& items) noexcept {
+    QSet<Item*> set;
+    foreach (Item* item, items) { set.insert(item); }
+    return set;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(SpatialIndexTest, testEmpty) {
+  SpatialIndex<Item> index;
+  EXPECT_EQ(0, index.getCount());
+  EXPECT_TRUE(index.find(QPointF(0, 0)).isEmpty());
+  EXPECT_TRUE(index.find(QRectF(-10, -10, 20, 20)).isEmpty());
+}
+
+TEST_F(SpatialIndexTest, testPointsAndLines) {
+  // items with zero width or height must be found too
+  Item point{QRectF(10, 10, 0, 0)};
+  Item line{QRectF(0, 20, 100, 0)};
+
+  SpatialIndex<Item> index;
+  index.insert(point);
+  index.insert(line);
+  EXPECT_EQ(2, index.getCount());
+  EXPECT_EQ(QVector<Item*>{&point}, index.find(QPointF(10, 10)));
+  EXPECT_EQ(QVector<Item*>{&line}, index.find(QPointF(50, 20)));
+  EXPECT_TRUE(index.find(QPointF(50, 21)).isEmpty());
+}
+
+TEST_F(SpatialIndexTest, testLazyUpdate) {
+  Item               item{QRectF(0, 0, 10, 10)};
+  SpatialIndex<Item> index;
+  index.insert(item);
+  EXPECT_EQ(1, index.find(QPointF(5, 5)).count());
+
+  // moving the item without updating the index keeps the old rect
+  item.rect.translate(100, 0);
+  EXPECT_EQ(1, index.find(QPointF(5, 5)).count());
+  EXPECT_EQ(0, index.find(QPointF(105, 5)).count());
+
+  // after marking the item as modified, the new rect is used
+  index.update(item);
+  EXPECT_EQ(0, index.find(QPointF(5, 5)).count());
+  EXPECT_EQ(1, index.find(QPointF(105, 5)).count());
+
+  index.remove(item);
+  EXPECT_FALSE(index.contains(item));
+  EXPECT_EQ(0, index.find(QPointF(105, 5)).count());
+}
+
+TEST_F(SpatialIndexTest, testRandomOperationsMatchBruteForce) {
+  std::mt19937      rng(42);
+  std::vector<Item> items(2000);
+  for (Item& item : items) {
+    item.rect = randomRect(rng);
+  }
+
+  SpatialIndex<Item> index;
+  QSet<Item*>        indexed;
+  std::uniform_int_distribution<std::size_t> itemIndex(0, items.size() - 1);
+  std::uniform_int_distribution<int>         operation(0, 2);
+  for (int i = 0; i < 20000; ++i) {
+    Item& item = items[itemIndex(rng)];
+    switch (operation(rng)) {
+      case 0:
+        index.insert(item);
+        indexed.insert(&item);
+        break;
+      case 1:
+        item.rect = randomRect(rng);
+        index.update(item);
+        break;
+      default:
+        index.remove(item);
+        indexed.remove(&item);
+        break;
+    }
+    if (i % 500 == 0) {
+      ASSERT_EQ(indexed.count(), index.getCount());
+      for (int k = 0; k < 20; ++k) {
+        QRectF rect = randomRect(rng);
+        EXPECT_EQ(findBruteForce(items, indexed, rect),
+                  toSet(index.find(rect)));
+      }
+    }
+  }
+
+  index.clear();
+  EXPECT_EQ(0, index.getCount());
+  EXPECT_TRUE(index.find(QRectF(-1000, -1000, 2000, 2000)).isEmpty());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -89,6 +89,19 @@ TEST_F(LibraryBaseElementTest, testSaveToNonEmptyDirectory) {
   EXPECT_THROW(mNewElement->saveTo(dest), RuntimeError);
 }
 
+TEST_F(LibraryBaseElementTest, testOpenMetadataOnly) {
+  FilePath dest = mTempDir.getPathTo(mNewElement->getUuid().toStr());
+  mNewElement->saveTo(dest);
+  LibraryBaseElement element(dest, true, "sym", "symbol", false, true);
+  EXPECT_TRUE(element.isMetadataOnly());
+  EXPECT_TRUE(element.isOpenedReadOnly());
+  EXPECT_EQ(mNewElement->getUuid(), element.getUuid());
+  EXPECT_EQ(mNewElement->getVersion(), element.getVersion());
+  EXPECT_EQ(mNewElement->getNames(), element.getNames());
+  EXPECT_THROW(element.save(), Exception);
+  EXPECT_THROW(element.saveTo(mTempDir.getPathTo("copy")), Exception);
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -0,0 +1,198 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/project/boards/boardairwiresgraph.h>
+
+#include <QtCore>
+
+#include <random>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class BoardAirWiresGraphTest : public ::testing::Test {
+protected:
+  static const void* key(int i) noexcept {
+    return reinterpret_cast<const void*>(static_cast<quintptr>(i + 1));
+  }
+
+  static BoardAirWiresGraph::Snapshot createRandomSnapshot(
+      int anchors, int connections, std::mt19937& rng) noexcept {
+    std::uniform_int_distribution<LengthBase_t> coord(0, 100000000);
+    std::uniform_int_distribution<int>          index(0, anchors - 1);
+    BoardAirWiresGraph::Snapshot                snapshot;
+    for (int i = 0; i < anchors; ++i) {
+      snapshot.anchors.append({key(i), Point(coord(rng), coord(rng))});
+    }
+    for (int i = 0; i < connections; ++i) {
+      snapshot.connections.append(qMakePair(index(rng), index(rng)));
+    }
+    return snapshot;
+  }
+
+  static void moveRandomAnchors(BoardAirWiresGraph::Snapshot& snapshot,
+                                int count, std::mt19937& rng) noexcept {
+    std::uniform_int_distribution<LengthBase_t> offset(-1000000, 1000000);
+    std::uniform_int_distribution<int> index(0, snapshot.anchors.count() - 1);
+    for (int i = 0; i < count; ++i) {
+      snapshot.anchors[index(rng)].position += Point(offset(rng), offset(rng));
+    }
+  }
+
+  static qreal totalLength(const BoardAirWiresGraph::AirWires& airwires) {
+    qreal length = 0;
+    foreach (const auto& airwire, airwires) {
+      length += (airwire.second - airwire.first).getLength().toMm();
+    }
+    return length;
+  }
+
+  static int countIslands(const BoardAirWiresGraph::Snapshot& snapshot,
+                          const BoardAirWiresGraph::AirWires& airwires) {
+    QHash<Point, int> indices;
+    QVector<int>      parents(snapshot.anchors.count());
+    for (int i = 0; i < snapshot.anchors.count(); ++i) {
+      indices.insert(snapshot.anchors.at(i).position, i);
+      parents[i] = i;
+    }
+    auto find = [&parents](int i) {
+      while (parents[i] != i) i = parents[i];
+      return i;
+    };
+    QVector<QPair<int, int>> connections = snapshot.connections;
+    foreach (const auto& airwire, airwires) {
+      connections.append(qMakePair(indices.value(airwire.first),
+                                   indices.value(airwire.second)));
+    }
+    int islands = snapshot.anchors.count();
+    foreach (const auto& connection, connections) {
+      int a = find(connection.first);
+      int b = find(connection.second);
+      if (a != b) {
+        parents[b] = a;
+        --islands;
+      }
+    }
+    return islands;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(BoardAirWiresGraphTest, testEmpty) {
+  BoardAirWiresGraph::Snapshot snapshot;
+  EXPECT_EQ(0, BoardAirWiresGraph::build(snapshot).count());
+}
+
+TEST_F(BoardAirWiresGraphTest, testTwoAnchors) {
+  BoardAirWiresGraph::Snapshot snapshot;
+  snapshot.anchors.append({key(0), Point(0, 0)});
+  snapshot.anchors.append({key(1), Point(1000, 0)});
+  EXPECT_EQ(1, BoardAirWiresGraph::build(snapshot).count());
+  snapshot.connections.append(qMakePair(0, 1));
+  EXPECT_EQ(0, BoardAirWiresGraph::build(snapshot).count());
+}
+
+TEST_F(BoardAirWiresGraphTest, testIncrementalUpdateMatchesFullBuild) {
+  std::mt19937                 rng(42);
+  BoardAirWiresGraph::Snapshot snapshot = createRandomSnapshot(500, 200, rng);
+  BoardAirWiresGraph           graph;
+  graph.update(snapshot);
+  EXPECT_EQ(1, graph.getFullRebuildCount());
+
+  for (int i = 0; i < 20; ++i) {
+    moveRandomAnchors(snapshot, 3, rng);
+    BoardAirWiresGraph::AirWires incremental = graph.update(snapshot);
+    BoardAirWiresGraph::AirWires full = BoardAirWiresGraph::build(snapshot);
+    EXPECT_EQ(full.count(), incremental.count());
+    EXPECT_EQ(1, countIslands(snapshot, incremental));
+    EXPECT_LE(totalLength(incremental), totalLength(full) + 1e-6);
+  }
+  EXPECT_GT(graph.getIncrementalUpdateCount(), 0);
+}
+
+TEST_F(BoardAirWiresGraphTest, testAddAndRemoveAnchors) {
+  std::mt19937                 rng(1337);
+  BoardAirWiresGraph::Snapshot snapshot = createRandomSnapshot(300, 50, rng);
+  BoardAirWiresGraph           graph;
+  graph.update(snapshot);
+
+  // add an anchor
+  snapshot.anchors.append({key(1000), Point(123456, 654321)});
+  BoardAirWiresGraph::AirWires airwires = graph.update(snapshot);
+  EXPECT_EQ(BoardAirWiresGraph::build(snapshot).count(), airwires.count());
+  EXPECT_EQ(1, countIslands(snapshot, airwires));
+
+  // remove the anchor again
+  snapshot.anchors.removeLast();
+  airwires = graph.update(snapshot);
+  EXPECT_EQ(BoardAirWiresGraph::build(snapshot).count(), airwires.count());
+  EXPECT_EQ(1, countIslands(snapshot, airwires));
+  EXPECT_EQ(1, graph.getFullRebuildCount());
+}
+
+TEST_F(BoardAirWiresGraphTest, testConcurrentUpdateIsDeterministic) {
+  std::mt19937                          rng(4711);
+  QVector<BoardAirWiresGraph::Snapshot> snapshots;
+  for (int i = 0; i < 50; ++i) {
+    snapshots.append(createRandomSnapshot(10 + i * 5, i, rng));
+  }
+  QVector<BoardAirWiresGraph>  serialGraphs(snapshots.count());
+  QVector<BoardAirWiresGraph>  concurrentGraphs(snapshots.count());
+  QVector<BoardAirWiresGraph*> concurrentGraphPtrs;
+  for (int i = 0; i < concurrentGraphs.count(); ++i) {
+    concurrentGraphPtrs.append(&concurrentGraphs[i]);
+  }
+
+  // initial build and an incremental update afterwards
+  for (int round = 0; round < 2; ++round) {
+    QVector<BoardAirWiresGraph::AirWires> serial;
+    for (int i = 0; i < snapshots.count(); ++i) {
+      serial.append(serialGraphs[i].update(snapshots.at(i)));
+    }
+    QVector<BoardAirWiresGraph::AirWires> concurrent =
+        BoardAirWiresGraph::updateConcurrently(concurrentGraphPtrs, snapshots);
+    EXPECT_EQ(serial, concurrent);
+    for (int i = 0; i < snapshots.count(); ++i) {
+      moveRandomAnchors(snapshots[i], 1, rng);
+    }
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace project
+}  // namespace librepcb
@@ -0,0 +1,209 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/cam/gerbergenerator.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardcamsnapshot.h>
+#include <librepcb/project/boards/boardgerberexport.h>
+#include <librepcb/project/boards/boardlayerstack.h>
+#include <librepcb/project/boards/items/bi_netline.h>
+#include <librepcb/project/boards/items/bi_netpoint.h>
+#include <librepcb/project/boards/items/bi_netsegment.h>
+#include <librepcb/project/boards/items/bi_via.h>
+#include <librepcb/project/circuit/circuit.h>
+#include <librepcb/project/circuit/netclass.h>
+#include <librepcb/project/circuit/netsignal.h>
+#include <librepcb/project/project.h>
+
+#include <QtCore>
+
+#include <random>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class BoardCamSnapshotTest : public ::testing::Test {
+protected:
+  FilePath                mProjectDir;
+  QScopedPointer<Project> mProject;
+  Board*                  mBoard;
+  BI_NetSegment*          mNetSegment;
+
+  BoardCamSnapshotTest() {
+    mProjectDir = FilePath::getRandomTempPath();
+    mProject.reset(Project::create(mProjectDir.getPathTo("project.lpp")));
+    mBoard = mProject->createBoard(ElementName("board"));
+    mProject->addBoard(*mBoard);
+    mBoard->getLayerStack().setInnerLayerCount(2);
+    Circuit&   circuit = mProject->getCircuit();
+    NetSignal* signal  = new NetSignal(
+        circuit, *circuit.getNetClasses().first(), CircuitIdentifier("GND"),
+        false);
+    circuit.addNetSignal(*signal);
+    mNetSegment = new BI_NetSegment(*mBoard, *signal);
+    mBoard->addNetSegment(*mNetSegment);
+  }
+
+  virtual ~BoardCamSnapshotTest() {
+    mProject.reset();
+    QDir(mProjectDir.toStr()).removeRecursively();
+  }
+
+  void addTraces(const QVector<QPair<Point, Point>>& traces,
+                 const QString&                      layerName) {
+    GraphicsLayer* layer = mBoard->getLayerStack().getLayer(layerName);
+    ASSERT_TRUE(layer);
+    QList<BI_NetPoint*> netpoints;
+    QList<BI_NetLine*>  netlines;
+    foreach (const auto& trace, traces) {
+      BI_NetPoint* start = new BI_NetPoint(*mNetSegment, trace.first);
+      BI_NetPoint* end   = new BI_NetPoint(*mNetSegment, trace.second);
+      netpoints << start << end;
+      netlines << new BI_NetLine(*mNetSegment, *start, *end, *layer,
+                                 PositiveLength(200000));
+    }
+    mNetSegment->addElements({}, netpoints, netlines);
+  }
+
+  void addVia(const Point& pos) {
+    BI_Via* via = new BI_Via(*mNetSegment, pos, BI_Via::Shape::Round,
+                             PositiveLength(800000), PositiveLength(300000));
+    mNetSegment->addElements({via}, {}, {});
+  }
+
+  QStringList getCopperLayerNames() const noexcept {
+    QStringList names = {GraphicsLayer::sTopCopper};
+    for (int i = 1; i <= mBoard->getLayerStack().getInnerLayerCount(); ++i) {
+      names.append(GraphicsLayer::getInnerLayerName(i));
+    }
+    names.append(GraphicsLayer::sBotCopper);
+    return names;
+  }
+
+  static QByteArray readFileWithoutDate(const FilePath& fp) {
+    QByteArray content;
+    foreach (const QByteArray& line, FileUtils::readFile(fp).split('\n')) {
+      if (!line.contains("Creation")) {  // creation date is not reproducible
+        content += line + '\n';
+      }
+    }
+    return content;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(BoardCamSnapshotTest, testTracesAreBucketedByLayer) {
+  addTraces({{Point(0, 0), Point(1000000, 0)},
+             {Point(0, 1000000), Point(1000000, 1000000)},
+             {Point(0, 2000000), Point(1000000, 2000000)}},
+            GraphicsLayer::sTopCopper);
+  addTraces({{Point(0, 0), Point(0, 1000000)},
+             {Point(1000000, 0), Point(1000000, 1000000)}},
+            GraphicsLayer::getInnerLayerName(1));
+  addTraces({{Point(0, 0), Point(2000000, 2000000)}},
+            GraphicsLayer::sBotCopper);
+
+  QStringList layers = getCopperLayerNames();
+  layers.append(GraphicsLayer::sTopStopMask);
+  BoardCamSnapshot snapshot(*mBoard, layers);
+  EXPECT_EQ(3, snapshot.getPrimitiveCount(GraphicsLayer::sTopCopper));
+  EXPECT_EQ(2, snapshot.getPrimitiveCount(GraphicsLayer::getInnerLayerName(1)));
+  EXPECT_EQ(0, snapshot.getPrimitiveCount(GraphicsLayer::getInnerLayerName(2)));
+  EXPECT_EQ(1, snapshot.getPrimitiveCount(GraphicsLayer::sBotCopper));
+  EXPECT_EQ(0, snapshot.getPrimitiveCount(GraphicsLayer::sTopStopMask));
+}
+
+TEST_F(BoardCamSnapshotTest, testViasAreOnAllCopperLayers) {
+  addVia(Point(0, 0));
+  addVia(Point(1000000, 0));
+
+  BoardCamSnapshot snapshot(*mBoard, getCopperLayerNames());
+  foreach (const QString& layerName, getCopperLayerNames()) {
+    EXPECT_EQ(2, snapshot.getPrimitiveCount(layerName))
+        << qPrintable(layerName);
+  }
+  EXPECT_EQ(2, snapshot.getPthDrills().count());
+  EXPECT_EQ(0, snapshot.getNpthDrills().count());
+}
+
+TEST_F(BoardCamSnapshotTest, testDrawUnknownLayerThrows) {
+  BoardCamSnapshot snapshot(*mBoard, {GraphicsLayer::sTopCopper});
+  GerberGenerator  gen("test", Uuid::createRandom(), "1");
+  EXPECT_NO_THROW(snapshot.drawLayer(gen, GraphicsLayer::sTopCopper));
+  EXPECT_THROW(snapshot.drawLayer(gen, GraphicsLayer::sBotCopper),
+               LogicError);
+}
+
+TEST_F(BoardCamSnapshotTest, testConcurrentExportMatchesSerialExport) {
+  std::mt19937                                rng(42);
+  std::uniform_int_distribution<LengthBase_t> coord(0, 100000000);
+  foreach (const QString& layerName, getCopperLayerNames()) {
+    QVector<QPair<Point, Point>> traces;
+    for (int i = 0; i < 100; ++i) {
+      traces.append(qMakePair(Point(coord(rng), coord(rng)),
+                              Point(coord(rng), coord(rng))));
+    }
+    addTraces(traces, layerName);
+  }
+  for (int i = 0; i < 20; ++i) {
+    addVia(Point(coord(rng), coord(rng)));
+  }
+
+  BoardGerberExport serialExport(*mBoard);
+  serialExport.exportAllLayers();
+  QVector<QByteArray> serialContents;
+  foreach (const FilePath& fp, serialExport.getWrittenFiles()) {
+    serialContents.append(readFileWithoutDate(fp));
+  }
+
+  BoardGerberExport concurrentExport(*mBoard);
+  concurrentExport.exportAllLayersConcurrently();
+  ASSERT_EQ(serialExport.getWrittenFiles(),
+            concurrentExport.getWrittenFiles());
+  for (int i = 0; i < serialContents.count(); ++i) {
+    EXPECT_EQ(serialContents.at(i),
+              readFileWithoutDate(concurrentExport.getWrittenFiles().at(i)));
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace project
+}  // namespace librepcb
@@ -0,0 +1,152 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/items/bi_netsegment.h>
+#include <librepcb/project/boards/items/bi_via.h>
+#include <librepcb/project/circuit/circuit.h>
+#include <librepcb/project/circuit/netclass.h>
+#include <librepcb/project/circuit/netsignal.h>
+#include <librepcb/project/project.h>
+
+#include <QtCore>
+
+#include <algorithm>
+#include <random>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+/**
+ * Hit testing of board items, which are looked up in the spatial index of the
+ * board but must be returned in the same order as they appear in the board.
+ */
+class BoardItemIndexTest : public ::testing::Test {
+protected:
+  FilePath                mProjectDir;
+  QScopedPointer<Project> mProject;
+  Board*                  mBoard;
+  NetSignal*              mNetSignal;
+
+  BoardItemIndexTest() {
+    mProjectDir = FilePath::getRandomTempPath();
+    mProject.reset(Project::create(mProjectDir.getPathTo("project.lpp")));
+    mBoard = mProject->createBoard(ElementName("board"));
+    mProject->addBoard(*mBoard);
+    Circuit& circuit = mProject->getCircuit();
+    mNetSignal       = new NetSignal(circuit, *circuit.getNetClasses().first(),
+                               CircuitIdentifier("GND"), false);
+    circuit.addNetSignal(*mNetSignal);
+  }
+
+  virtual ~BoardItemIndexTest() {
+    mProject.reset();
+    QDir(mProjectDir.toStr()).removeRecursively();
+  }
+
+  BI_NetSegment* addNetSegment() {
+    BI_NetSegment* segment = new BI_NetSegment(*mBoard, *mNetSignal);
+    mBoard->addNetSegment(*segment);
+    return segment;
+  }
+
+  BI_Via* addVia(BI_NetSegment& segment, const Point& pos) {
+    BI_Via* via = new BI_Via(segment, pos, BI_Via::Shape::Round,
+                             PositiveLength(800000), PositiveLength(300000));
+    segment.addElements({via}, {}, {});
+    return via;
+  }
+
+  QList<BI_Via*> getViasInModelOrder(const Point& pos) const noexcept {
+    QList<BI_Via*> vias;
+    foreach (const BI_NetSegment* segment, mBoard->getNetSegments()) {
+      foreach (BI_Via* via, segment->getVias()) {
+        if (via->getPosition() == pos) vias.append(via);
+      }
+    }
+    return vias;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(BoardItemIndexTest, testOverlappingItemsAreReturnedInModelOrder) {
+  // Add overlapping vias in shuffled order to several net segments, with lots
+  // of other vias in between so the index is split and rebalanced many times.
+  std::mt19937            rng(42);
+  QVector<BI_NetSegment*> segments = {addNetSegment(), addNetSegment(),
+                                      addNetSegment()};
+  QVector<int>            targets;
+  for (int i = 0; i < 60; ++i) {
+    targets.append(i % segments.count());
+  }
+  std::shuffle(targets.begin(), targets.end(), rng);
+  QList<BI_Via*> overlapping;
+  for (int i = 0; i < targets.count(); ++i) {
+    overlapping.append(addVia(*segments.at(targets.at(i)), Point(0, 0)));
+    for (int k = 0; k < 5; ++k) {
+      addVia(*segments.at(k % segments.count()), Point::fromMm(i + 10, k + 1));
+    }
+  }
+
+  // removing items causes the entries of underfull nodes to be re-inserted
+  for (int i = 0; i < 10; ++i) {
+    std::uniform_int_distribution<int> dist(0, overlapping.count() - 1);
+    BI_Via*                            via = overlapping.takeAt(dist(rng));
+    via->getNetSegment().removeElements({via}, {}, {});
+    delete via;
+  }
+
+  QList<BI_Via*> expected = getViasInModelOrder(Point(0, 0));
+  ASSERT_EQ(50, expected.count());
+  EXPECT_EQ(expected, mBoard->getViasAtScenePos(Point(0, 0), nullptr));
+  QList<BI_Base*> items = mBoard->getItemsAtScenePos(Point(0, 0));
+  ASSERT_EQ(expected.count(), items.count());
+  for (int i = 0; i < expected.count(); ++i) {
+    EXPECT_EQ(expected.at(i), items.at(i)) << "Index: " << i;
+  }
+
+  // moving an item around must not change the order
+  expected.first()->setPosition(Point::fromMm(-50, -50));
+  expected.first()->setPosition(Point(0, 0));
+  EXPECT_EQ(expected, mBoard->getViasAtScenePos(Point(0, 0), nullptr));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace project
+}  // namespace librepcb
@@ -0,0 +1,125 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/utils/clipperhelpers.h>
+#include <librepcb/library/pkg/footprintpad.h>
+#include <librepcb/project/boards/boardplanecutoutcache.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class BoardPlaneCutOutCacheTest : public ::testing::Test {
+protected:
+  static bool isNear(const ClipperLib::Path& p1,
+                     const ClipperLib::Path& p2) noexcept {
+    if (p1.size() != p2.size()) return false;
+    for (std::size_t i = 0; i < p1.size(); ++i) {
+      if ((std::abs(p1[i].X - p2[i].X) > 1) ||
+          (std::abs(p1[i].Y - p2[i].Y) > 1)) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(BoardPlaneCutOutCacheTest, testViaOutlines) {
+  BoardPlaneCutOutCache cache;
+  PositiveLength        size(800000);
+  PositiveLength        tolerance(5000);
+  Point                 pos1(1000000, 2000000);
+  Point                 pos2(-3000000, 500000);
+
+  ClipperLib::Path p1 = cache.getViaOutline(
+      BI_Via::Shape::Round, size, Length(300000), tolerance, pos1);
+  ClipperLib::Path p2 = cache.getViaOutline(
+      BI_Via::Shape::Round, size, Length(300000), tolerance, pos2);
+  EXPECT_EQ(1, cache.getCount());
+  EXPECT_EQ(1, cache.getMissCount());
+  EXPECT_EQ(1, cache.getHitCount());
+
+  Path outline = BI_Via::getOutline(BI_Via::Shape::Round, size, Length(300000));
+  EXPECT_TRUE(
+      isNear(ClipperHelpers::convert(outline.translated(pos1), tolerance), p1));
+  EXPECT_TRUE(
+      isNear(ClipperHelpers::convert(outline.translated(pos2), tolerance), p2));
+
+  // different clearance or shape must not share the cached outline
+  cache.getViaOutline(BI_Via::Shape::Round, size, Length(200000), tolerance,
+                      pos1);
+  cache.getViaOutline(BI_Via::Shape::Square, size, Length(300000), tolerance,
+                      pos1);
+  EXPECT_EQ(3, cache.getCount());
+}
+
+TEST_F(BoardPlaneCutOutCacheTest, testPadOutlines) {
+  library::FootprintPad pad(Uuid::createRandom(), Point(0, 0), Angle(0),
+                            library::FootprintPad::Shape::RECT,
+                            PositiveLength(1500000), PositiveLength(600000),
+                            UnsignedLength(0),
+                            library::FootprintPad::BoardSide::TOP);
+  library::FootprintPad copy(pad);  // e.g. another footprint of same package
+  BoardPlaneCutOutCache cache;
+  PositiveLength        tolerance(5000);
+  Angle                 rotation = Angle::deg90();
+  Point                 pos(4000000, -1000000);
+
+  ClipperLib::Path p1 = cache.getPadOutline(pad, rotation, false,
+                                            Length(250000), tolerance, pos);
+  ClipperLib::Path p2 = cache.getPadOutline(copy, rotation, false,
+                                            Length(250000), tolerance, pos);
+  EXPECT_EQ(p1, p2);
+  EXPECT_EQ(1, cache.getCount());
+
+  Path outline = pad.getOutline(Length(250000)).rotated(rotation);
+  EXPECT_TRUE(
+      isNear(ClipperHelpers::convert(outline.translated(pos), tolerance), p1));
+
+  cache.getPadOutline(pad, Angle::deg0(), false, Length(250000), tolerance,
+                      pos);
+  EXPECT_EQ(2, cache.getCount());
+  cache.clear();
+  EXPECT_EQ(0, cache.getCount());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace project
+}  // namespace librepcb
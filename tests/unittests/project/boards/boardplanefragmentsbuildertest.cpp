@@ -22,12 +22,17 @@
  ******************************************************************************/
 #include <gtest/gtest.h>
 #include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/utils/clipperhelpers.h>
 #include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardplanefragmentsbuilder.h>
 #include <librepcb/project/boards/items/bi_plane.h>
 #include <librepcb/project/project.h>
 
 #include <QtCore>
 
+#include <random>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -47,13 +52,80 @@ namespace tests {
  * with the expected paths of all plane fragments. This test then re-calculates
  * all plane fragments and compares them with the expected fragments.
  */
-class BoardPlaneFragmentsBuilderTest : public ::testing::Test {};
+class BoardPlaneFragmentsBuilderTest : public ::testing::Test {
+protected:
+  static const NetSignal* net(int i) noexcept {
+    return reinterpret_cast<const NetSignal*>(static_cast<quintptr>(i + 1));
+  }
+
+  static BoardPlaneFragmentsBuilder::Snapshot createSnapshot(int vias) {
+    BoardPlaneFragmentsBuilder::Snapshot snapshot;
+    snapshot.planes.push_back(BoardPlaneFragmentsBuilder::Snapshot::Plane{
+        Uuid::createRandom(), net(0), GraphicsLayer::sTopCopper,
+        Path::centeredRect(PositiveLength(100000000),
+                           PositiveLength(100000000)),
+        UnsignedLength(200000), UnsignedLength(300000), true,
+        BI_Plane::ConnectStyle::Solid, QVector<Path>()});
+    snapshot.boardOutlines.append(Path::centeredRect(
+        PositiveLength(110000000), PositiveLength(110000000)));
+    for (int i = 0; i < vias; ++i) {
+      Point pos(Length(-45000000 + (i % 30) * 3000000),
+                Length(-45000000 + (i / 30) * 3000000));
+      snapshot.vias.push_back(BoardPlaneFragmentsBuilder::Snapshot::Via{
+          net(1 + (i % 3)), pos, BI_Via::Shape::Round,
+          PositiveLength(600000)});
+    }
+    return snapshot;
+  }
+
+  static BoardPlaneFragmentsBuilder::Snapshot createFourLayerSnapshot(
+      int vias) {
+    PositiveLength size(200000000);
+    QStringList    layers;
+    layers << GraphicsLayer::sTopCopper << GraphicsLayer::getInnerLayerName(1)
+           << GraphicsLayer::getInnerLayerName(2) << GraphicsLayer::sBotCopper;
+    BoardPlaneFragmentsBuilder::Snapshot snapshot;
+    for (int i = 0; i < layers.count(); ++i) {
+      snapshot.planes.push_back(BoardPlaneFragmentsBuilder::Snapshot::Plane{
+          Uuid::createRandom(), net(i % 2), layers.at(i),
+          Path::centeredRect(size, size), UnsignedLength(200000),
+          UnsignedLength(300000), false, BI_Plane::ConnectStyle::Solid,
+          QVector<Path>()});
+    }
+    snapshot.boardOutlines.append(Path::centeredRect(size, size));
+    std::mt19937                       rng(vias);
+    std::uniform_int_distribution<int> coord(-95000, 95000);  // [um]
+    std::uniform_int_distribution<int> netIndex(0, 20);
+    for (int i = 0; i < vias; ++i) {
+      const NetSignal* netsignal = net(netIndex(rng));
+      Point pos(Length(coord(rng) * 1000), Length(coord(rng) * 1000));
+      snapshot.vias.push_back(BoardPlaneFragmentsBuilder::Snapshot::Via{
+          netsignal, pos, BI_Via::Shape::Round, PositiveLength(600000)});
+      if (i % 2) {  // add a short trace on top or bottom to every second via
+        snapshot.netLines.push_back(
+            BoardPlaneFragmentsBuilder::Snapshot::NetLine{
+                netsignal, layers.at((i % 4 == 1) ? 0 : 3), pos,
+                pos + Point(2000000, 1000000), PositiveLength(250000)});
+      }
+    }
+    return snapshot;
+  }
+
+  static qreal area(const QVector<Path>& fragments) noexcept {
+    qreal area = 0;
+    foreach (const Path& fragment, fragments) {
+      area += ClipperLib::Area(ClipperHelpers::convert(
+          fragment, BoardPlaneFragmentsBuilder::maxArcTolerance()));
+    }
+    return std::abs(area);
+  }
+};
 
 /*******************************************************************************
  *  Test Methods
  ******************************************************************************/
 
-TEST(BoardPlaneFragmentsBuilderTest, testFragments) {
+TEST_F(BoardPlaneFragmentsBuilderTest, testFragments) {
   FilePath testDataDir(
       TEST_DATA_DIR
       "/unittests/librepcbproject/BoardPlaneFragmentsBuilderTest");
@@ -103,6 +175,81 @@ TEST(BoardPlaneFragmentsBuilderTest, testFragments) {
   EXPECT_EQ(expectedPlaneFragments, actualPlaneFragments);
 }
 
+TEST_F(BoardPlaneFragmentsBuilderTest, testSnapshotMatchesBoard) {
+  FilePath testDataDir(
+      TEST_DATA_DIR
+      "/unittests/librepcbproject/BoardPlaneFragmentsBuilderTest");
+
+  // open project from test data directory
+  FilePath projectFp = testDataDir.getPathTo("test_project/test_project.lpp");
+  QScopedPointer<Project> project(new Project(projectFp, true, false));
+  Board*                  board = project->getBoards().first();
+  board->rebuildAllPlanes();
+
+  // build fragments from a snapshot, as done in background rebuilds
+  BoardPlaneFragmentsBuilder::Snapshot snapshot =
+      BoardPlaneFragmentsBuilder::takeSnapshot(*board);
+  EXPECT_TRUE(BoardPlaneFragmentsBuilder::buildAllFragments(snapshot));
+  ASSERT_EQ(static_cast<std::size_t>(board->getPlanes().count()),
+            snapshot.planes.size());
+  foreach (const BI_Plane* plane, board->getPlanes()) {
+    for (const auto& snapshotPlane : snapshot.planes) {
+      if (snapshotPlane.uuid == plane->getUuid()) {
+        EXPECT_EQ(plane->getFragments(), snapshotPlane.fragments);
+      }
+    }
+  }
+
+  // an aborted build must not report success
+  std::atomic_bool abort(true);
+  EXPECT_FALSE(
+      BoardPlaneFragmentsBuilder::buildAllFragments(snapshot, nullptr, &abort));
+}
+
+TEST_F(BoardPlaneFragmentsBuilderTest, testIncrementalRebuild) {
+  BoardPlaneFragmentsBuilder::Snapshot snapshot = createSnapshot(900);
+  BoardPlaneFragmentsBuilder::Cache    cache;
+  ASSERT_TRUE(BoardPlaneFragmentsBuilder::buildAllFragments(snapshot, &cache));
+  EXPECT_EQ(1, cache.count());
+
+  // nothing modified
+  {
+    BoardPlaneFragmentsBuilder builder(
+        snapshot, 0, cache.value(snapshot.planes[0].uuid).get());
+    EXPECT_EQ(snapshot.planes[0].fragments, builder.buildFragments());
+    EXPECT_EQ(0, builder.getDirtyTileCount());
+  }
+
+  // move a via, only tiles around it are rebuilt
+  snapshot.vias[100].position += Point(1000000, 500000);
+  BoardPlaneFragmentsBuilder builder(
+      snapshot, 0, cache.value(snapshot.planes[0].uuid).get());
+  QVector<Path> incremental = builder.buildFragments();
+  EXPECT_GT(builder.getDirtyTileCount(), 0);
+  EXPECT_LE(builder.getDirtyTileCount(), 4);
+
+  // compare with a full rebuild
+  BoardPlaneFragmentsBuilder fullBuilder(snapshot, 0);
+  QVector<Path>              full = fullBuilder.buildFragments();
+  EXPECT_EQ(-1, fullBuilder.getDirtyTileCount());
+  EXPECT_EQ(full.count(), incremental.count());
+  EXPECT_NEAR(area(full), area(incremental), area(full) * 1e-9);
+}
+
+TEST_F(BoardPlaneFragmentsBuilderTest, testTiledBuild) {
+  BoardPlaneFragmentsBuilder::Snapshot tiled = createFourLayerSnapshot(2000);
+  BoardPlaneFragmentsBuilder::Snapshot full  = tiled;
+  ASSERT_TRUE(BoardPlaneFragmentsBuilder::buildAllFragments(tiled, nullptr,
+                                                            nullptr, true));
+  ASSERT_TRUE(BoardPlaneFragmentsBuilder::buildAllFragments(full));
+  for (std::size_t i = 0; i < full.planes.size(); ++i) {
+    const QVector<Path>& expected = full.planes[i].fragments;
+    const QVector<Path>& actual   = tiled.planes[i].fragments;
+    EXPECT_EQ(expected.count(), actual.count());
+    EXPECT_NEAR(area(expected), area(actual), area(expected) * 1e-9);
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
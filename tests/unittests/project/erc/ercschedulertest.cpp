@@ -0,0 +1,117 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/project/erc/ercscheduler.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class ErcSchedulerTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(ErcSchedulerTest, testScheduleIsDeferred) {
+  ErcScheduler scheduler;
+  QObject      object;
+  int          evaluations = 0;
+  scheduler.schedule(object, [&]() { ++evaluations; });
+  EXPECT_TRUE(scheduler.isPending());
+  EXPECT_EQ(0, evaluations);
+  scheduler.flush();
+  EXPECT_FALSE(scheduler.isPending());
+  EXPECT_EQ(1, evaluations);
+  scheduler.flush();
+  EXPECT_EQ(1, evaluations);
+}
+
+TEST_F(ErcSchedulerTest, testScheduleCoalescesRequests) {
+  ErcScheduler scheduler;
+  QObject      object1;
+  QObject      object2;
+  QStringList  evaluations;
+  for (int i = 0; i < 10; ++i) {
+    scheduler.schedule(object1, [&]() { evaluations.append("1"); });
+    scheduler.schedule(object2, [&]() { evaluations.append("2"); });
+  }
+  scheduler.flush();
+  EXPECT_EQ(QStringList({"1", "2"}), evaluations);
+  EXPECT_EQ(20, scheduler.getScheduledCount());
+  EXPECT_EQ(2, scheduler.getEvaluatedCount());
+  EXPECT_EQ(18, scheduler.getCoalescedCount());
+}
+
+TEST_F(ErcSchedulerTest, testScheduleDuringFlush) {
+  ErcScheduler scheduler;
+  QObject      object1;
+  QObject      object2;
+  QStringList  evaluations;
+  scheduler.schedule(object1, [&]() {
+    evaluations.append("1");
+    scheduler.schedule(object2, [&]() { evaluations.append("2"); });
+  });
+  scheduler.flush();
+  EXPECT_EQ(QStringList({"1", "2"}), evaluations);
+  EXPECT_FALSE(scheduler.isPending());
+}
+
+TEST_F(ErcSchedulerTest, testDestroyedObjectIsNotEvaluated) {
+  ErcScheduler scheduler;
+  int          evaluations = 0;
+  {
+    QObject object;
+    scheduler.schedule(object, [&]() { ++evaluations; });
+  }
+  EXPECT_FALSE(scheduler.isPending());
+  scheduler.flush();
+  EXPECT_EQ(0, evaluations);
+}
+
+TEST_F(ErcSchedulerTest, testFlushInNextEventLoopIteration) {
+  ErcScheduler scheduler;
+  QObject      object;
+  int          evaluations = 0;
+  scheduler.schedule(object, [&]() { ++evaluations; });
+  QCoreApplication::processEvents();
+  EXPECT_EQ(1, evaluations);
+  EXPECT_FALSE(scheduler.isPending());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace project
+}  // namespace librepcb
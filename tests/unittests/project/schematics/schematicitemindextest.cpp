@@ -0,0 +1,243 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/project/circuit/circuit.h>
+#include <librepcb/project/circuit/netclass.h>
+#include <librepcb/project/circuit/netsignal.h>
+#include <librepcb/project/project.h>
+#include <librepcb/project/schematics/items/si_netlabel.h>
+#include <librepcb/project/schematics/items/si_netline.h>
+#include <librepcb/project/schematics/items/si_netpoint.h>
+#include <librepcb/project/schematics/items/si_netsegment.h>
+#include <librepcb/project/schematics/schematic.h>
+
+#include <QtCore>
+
+#include <algorithm>
+#include <random>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+/**
+ * Hit testing and rubber band selection of schematic items, which are looked
+ * up in the spatial index of the schematic (same as in boards).
+ *
+ * The schematic contains the net points A(0,0), B(10,0) and C(10,10) [mm],
+ * the net lines A-B and B-C and a net label at (5,20).
+ */
+class SchematicItemIndexTest : public ::testing::Test {
+protected:
+  FilePath                mProjectDir;
+  QScopedPointer<Project> mProject;
+  Schematic*              mSchematic;
+  SI_NetSegment*          mNetSegment;
+  SI_NetPoint*            mNetPointA;
+  SI_NetPoint*            mNetPointB;
+  SI_NetPoint*            mNetPointC;
+  SI_NetLine*             mNetLineAB;
+  SI_NetLine*             mNetLineBC;
+  SI_NetLabel*            mNetLabel;
+  NetSignal*              mNetSignal;
+
+  SchematicItemIndexTest() {
+    mProjectDir = FilePath::getRandomTempPath();
+    mProject.reset(Project::create(mProjectDir.getPathTo("project.lpp")));
+    mSchematic = mProject->createSchematic(ElementName("schematic"));
+    mProject->addSchematic(*mSchematic);
+    Circuit&   circuit = mProject->getCircuit();
+    mNetSignal = new NetSignal(circuit, *circuit.getNetClasses().first(),
+                               CircuitIdentifier("GND"), false);
+    circuit.addNetSignal(*mNetSignal);
+    mNetSegment = new SI_NetSegment(*mSchematic, *mNetSignal);
+    mSchematic->addNetSegment(*mNetSegment);
+    mNetPointA = new SI_NetPoint(*mNetSegment, Point::fromMm(0, 0));
+    mNetPointB = new SI_NetPoint(*mNetSegment, Point::fromMm(10, 0));
+    mNetPointC = new SI_NetPoint(*mNetSegment, Point::fromMm(10, 10));
+    mNetLineAB = new SI_NetLine(*mNetSegment, *mNetPointA, *mNetPointB,
+                                UnsignedLength(158750));
+    mNetLineBC = new SI_NetLine(*mNetSegment, *mNetPointB, *mNetPointC,
+                                UnsignedLength(158750));
+    mNetSegment->addNetPointsAndNetLines({mNetPointA, mNetPointB, mNetPointC},
+                                         {mNetLineAB, mNetLineBC});
+    mNetLabel =
+        new SI_NetLabel(*mNetSegment, Point::fromMm(5, 20), Angle::deg0());
+    mNetSegment->addNetLabel(*mNetLabel);
+  }
+
+  virtual ~SchematicItemIndexTest() {
+    mProject.reset();
+    QDir(mProjectDir.toStr()).removeRecursively();
+  }
+
+  Point getNetLabelCenter() const noexcept {
+    return Point::fromPx(
+        mNetLabel->getGrabAreaScenePx().boundingRect().center());
+  }
+
+  SI_NetSegment* addNetSegment() {
+    SI_NetSegment* segment = new SI_NetSegment(*mSchematic, *mNetSignal);
+    mSchematic->addNetSegment(*segment);
+    return segment;
+  }
+
+  SI_NetPoint* addNetPoint(SI_NetSegment& segment, const Point& pos) {
+    SI_NetPoint* netpoint = new SI_NetPoint(segment, pos);
+    segment.addNetPointsAndNetLines({netpoint}, {});
+    return netpoint;
+  }
+
+  QSet<SI_Base*> getSelectedItems() const noexcept {
+    QSet<SI_Base*> items;
+    foreach (SI_Base* item,
+             QList<SI_Base*>({mNetPointA, mNetPointB, mNetPointC, mNetLineAB,
+                              mNetLineBC, mNetLabel})) {
+      if (item->isSelected()) items.insert(item);
+    }
+    return items;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(SchematicItemIndexTest, testItemsAtScenePos) {
+  EXPECT_EQ(QList<SI_NetPoint*>({mNetPointA}),
+            mSchematic->getNetPointsAtScenePos(Point::fromMm(0, 0)));
+  EXPECT_EQ(QList<SI_NetPoint*>({mNetPointC}),
+            mSchematic->getNetPointsAtScenePos(Point::fromMm(10, 10)));
+  EXPECT_EQ(QList<SI_NetLine*>({mNetLineAB}),
+            mSchematic->getNetLinesAtScenePos(Point::fromMm(5, 0)));
+  EXPECT_EQ(QList<SI_NetLine*>({mNetLineBC}),
+            mSchematic->getNetLinesAtScenePos(Point::fromMm(10, 5)));
+  EXPECT_EQ(QList<SI_NetLabel*>({mNetLabel}),
+            mSchematic->getNetLabelsAtScenePos(getNetLabelCenter()));
+  EXPECT_TRUE(
+      mSchematic->getNetPointsAtScenePos(Point::fromMm(5, 0)).isEmpty());
+  EXPECT_TRUE(mSchematic->getItemsAtScenePos(Point::fromMm(5, 5)).isEmpty());
+}
+
+TEST_F(SchematicItemIndexTest, testMovedItemsAreFoundAtNewPosition) {
+  mNetPointC->setPosition(Point::fromMm(20, 10));
+  EXPECT_TRUE(
+      mSchematic->getNetPointsAtScenePos(Point::fromMm(10, 10)).isEmpty());
+  EXPECT_EQ(QList<SI_NetPoint*>({mNetPointC}),
+            mSchematic->getNetPointsAtScenePos(Point::fromMm(20, 10)));
+  // the attached net line must be updated as well
+  EXPECT_TRUE(
+      mSchematic->getNetLinesAtScenePos(Point::fromMm(10, 5)).isEmpty());
+  EXPECT_EQ(QList<SI_NetLine*>({mNetLineBC}),
+            mSchematic->getNetLinesAtScenePos(Point::fromMm(15, 5)));
+}
+
+TEST_F(SchematicItemIndexTest, testRemovedItemsAreNotFound) {
+  mSchematic->removeNetSegment(*mNetSegment);
+  EXPECT_TRUE(mSchematic->getItemsAtScenePos(Point::fromMm(0, 0)).isEmpty());
+  EXPECT_TRUE(mSchematic->getItemsAtScenePos(Point::fromMm(5, 0)).isEmpty());
+  EXPECT_TRUE(mSchematic->getItemsAtScenePos(getNetLabelCenter()).isEmpty());
+  delete mNetSegment;
+}
+
+TEST_F(SchematicItemIndexTest, testOverlappingItemsAreReturnedInModelOrder) {
+  // Add overlapping net points in shuffled order to several net segments,
+  // with lots of other net points in between so the index is split and
+  // rebalanced many times.
+  std::mt19937            rng(42);
+  QVector<SI_NetSegment*> segments = {addNetSegment(), addNetSegment(),
+                                      addNetSegment()};
+  QVector<int>            targets;
+  for (int i = 0; i < 60; ++i) {
+    targets.append(i % segments.count());
+  }
+  std::shuffle(targets.begin(), targets.end(), rng);
+  QList<SI_NetPoint*> overlapping;
+  Point               pos = Point::fromMm(50, 50);
+  for (int i = 0; i < targets.count(); ++i) {
+    overlapping.append(addNetPoint(*segments.at(targets.at(i)), pos));
+    for (int k = 0; k < 5; ++k) {
+      addNetPoint(*segments.at(k % segments.count()),
+                  Point::fromMm(i + 100, k + 100));
+    }
+  }
+
+  // removing items causes the entries of underfull nodes to be re-inserted
+  for (int i = 0; i < 10; ++i) {
+    std::uniform_int_distribution<int> dist(0, overlapping.count() - 1);
+    SI_NetPoint* netpoint = overlapping.takeAt(dist(rng));
+    netpoint->getNetSegment().removeNetPointsAndNetLines({netpoint}, {});
+    delete netpoint;
+  }
+
+  QList<SI_NetPoint*> expected;
+  foreach (const SI_NetSegment* segment, segments) {  // added in this order
+    foreach (SI_NetPoint* netpoint, segment->getNetPoints()) {
+      if (netpoint->getPosition() == pos) expected.append(netpoint);
+    }
+  }
+  ASSERT_EQ(50, expected.count());
+  EXPECT_EQ(expected, mSchematic->getNetPointsAtScenePos(pos));
+}
+
+TEST_F(SchematicItemIndexTest, testSelectionRect) {
+  // select A and A-B
+  mSchematic->setSelectionRect(Point::fromMm(-1, -1), Point::fromMm(5, 1),
+                               true);
+  EXPECT_EQ(QSet<SI_Base*>({mNetPointA, mNetLineAB}), getSelectedItems());
+
+  // shrinking the rect deselects A
+  mSchematic->setSelectionRect(Point::fromMm(4, -1), Point::fromMm(6, 1), true);
+  EXPECT_EQ(QSet<SI_Base*>({mNetLineAB}), getSelectedItems());
+
+  // without updating the items, the selection is kept
+  mSchematic->setSelectionRect(Point::fromMm(-1, -1), Point::fromMm(11, 21),
+                               false);
+  EXPECT_EQ(QSet<SI_Base*>({mNetLineAB}), getSelectedItems());
+
+  // select everything
+  mSchematic->setSelectionRect(Point::fromMm(-1, -1), Point::fromMm(30, 30),
+                               true);
+  EXPECT_EQ(QSet<SI_Base*>({mNetPointA, mNetPointB, mNetPointC, mNetLineAB,
+                            mNetLineBC, mNetLabel}),
+            getSelectedItems());
+
+  mSchematic->clearSelection();
+  EXPECT_TRUE(getSelectedItems().isEmpty());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace project
+}  // namespace librepcb
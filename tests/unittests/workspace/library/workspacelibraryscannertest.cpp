@@ -0,0 +1,133 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/application.h>
+#include <librepcb/library/library.h>
+#include <librepcb/library/sym/symbol.h>
+#include <librepcb/workspace/library/workspacelibrarydb.h>
+#include <librepcb/workspace/workspace.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace workspace {
+namespace tests {
+
+using namespace library;
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class WorkspaceLibraryScannerTest : public ::testing::Test {
+protected:
+  FilePath mWsDir;
+  FilePath mLibDir;
+
+  WorkspaceLibraryScannerTest() {
+    mWsDir = FilePath::getRandomTempPath().getPathTo("test workspace dir");
+    mLibDir =
+        mWsDir.getPathTo("v" % qApp->getFileFormatVersion().toStr())
+            .getPathTo("libraries/local/Test.lplib");
+    Workspace::createNewWorkspace(mWsDir);
+    Library lib(Uuid::createRandom(), Version::fromString("0.1"), "test",
+                ElementName("Test"), "", "");
+    lib.saveTo(mLibDir);
+  }
+
+  virtual ~WorkspaceLibraryScannerTest() {
+    QDir(mWsDir.getParentDir().toStr()).removeRecursively();
+  }
+
+  QList<FilePath> createSymbols(int count) {
+    QList<FilePath> dirs;
+    for (int i = 0; i < count; ++i) {
+      Symbol symbol(Uuid::createRandom(), Version::fromString("0.1"), "test",
+                    ElementName(QString("Symbol %1").arg(i)), "", "");
+      symbol.saveIntoParentDirectory(mLibDir.getPathTo("sym"));
+      dirs.append(symbol.getFilePath());
+    }
+    return dirs;
+  }
+
+  static int scan(Workspace& ws) {
+    WorkspaceLibraryDb& db    = ws.getLibraryDb();
+    int                 count = -1;
+    QEventLoop          loop;
+    QObject::connect(&db, &WorkspaceLibraryDb::scanSucceeded, &loop,
+                     [&](int elementCount) {
+                       count = elementCount;
+                       loop.quit();
+                     });
+    QObject::connect(&db, &WorkspaceLibraryDb::scanFailed, &loop,
+                     &QEventLoop::quit);
+    db.startLibraryRescan();
+    loop.exec();
+    return count;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(WorkspaceLibraryScannerTest, testIncrementalRescan) {
+  QList<FilePath> symbols = createSymbols(10);
+  Workspace       ws(mWsDir);
+  EXPECT_EQ(10, scan(ws));
+  EXPECT_EQ(10, ws.getLibraryDb().getLibraryElements<Symbol>(mLibDir).count());
+
+  // unchanged library
+  EXPECT_EQ(10, scan(ws));
+
+  // add, remove and modify some symbols
+  symbols.append(createSymbols(5));
+  QDir(symbols.takeFirst().toStr()).removeRecursively();
+  QDir(symbols.takeFirst().toStr()).removeRecursively();
+  {
+    Symbol           symbol(symbols.first(), false);
+    LocalizedNameMap names = symbol.getNames();
+    names.setDefaultValue(ElementName("Modified Symbol"));
+    symbol.setNames(names);
+    symbol.save();
+  }
+  EXPECT_EQ(13, scan(ws));
+  QList<FilePath> elements =
+      ws.getLibraryDb().getLibraryElements<Symbol>(mLibDir);
+  EXPECT_EQ(symbols.toSet(), elements.toSet());
+  QString name;
+  ws.getLibraryDb().getElementTranslations<Symbol>(
+      symbols.first(), QStringList(), &name);
+  EXPECT_EQ("Modified Symbol", name.toStdString());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace workspace
+}  // namespace librepcb